@@ -1,6 +1,6 @@
-#pragma once
-
-namespace Cheat {
-    void Start();
-    void Stop();
+#pragma once
+
+namespace Cheat {
+    void Start();
+    void Stop();
 }
\ No newline at end of file
@@ -0,0 +1,85 @@
+#include "Config.h"
+#include "Platform.h"
+#include <filesystem>
+
+#ifndef _WIN32
+#include <fstream>
+#include <optional>
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#endif
+
+namespace Config {
+    const std::string& GetPath() {
+        static const std::string path = (Platform::ExecutableDirectory() / "Begeerte" / "Begeerte.ini").string();
+        return path;
+    }
+
+#ifdef _WIN32
+    int GetInt(const std::string& section, const std::string& key, int defaultValue) {
+        return static_cast<int>(GetPrivateProfileIntA(section.c_str(), key.c_str(), defaultValue, GetPath().c_str()));
+    }
+
+    std::string GetString(const std::string& section, const std::string& key, const std::string& defaultValue) {
+        char buffer[512];
+        GetPrivateProfileStringA(section.c_str(), key.c_str(), defaultValue.c_str(), buffer, sizeof(buffer), GetPath().c_str());
+        return std::string(buffer);
+    }
+#else
+    // 其他平台没有 GetPrivateProfile*，按相同的规则读取：节名和键名不区分大小写，忽略 ; 和 # 开头的注释行，
+    // 值两端的空白和一对引号被去掉。与 Windows 一样每次都重新读取文件
+    static std::string Trim(const std::string& text) {
+        size_t begin = text.find_first_not_of(" \t\r\n");
+        if (begin == std::string::npos) {
+            return std::string();
+        }
+        size_t end = text.find_last_not_of(" \t\r\n");
+        return text.substr(begin, end - begin + 1);
+    }
+
+    static bool SameName(const std::string& a, const std::string& b) {
+        return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+            return std::tolower(static_cast<unsigned char>(x)) == std::tolower(static_cast<unsigned char>(y));
+            });
+    }
+
+    static std::optional<std::string> Find(const std::string& section, const std::string& key) {
+        std::ifstream file(GetPath());
+        std::string line;
+        bool inSection = false;
+        while (std::getline(file, line)) {
+            line = Trim(line);
+            if (line.empty() || line[0] == ';' || line[0] == '#') {
+                continue;
+            }
+            if (line[0] == '[') {
+                size_t end = line.find(']');
+                inSection = end != std::string::npos && SameName(Trim(line.substr(1, end - 1)), section);
+                continue;
+            }
+            size_t equals = line.find('=');
+            if (!inSection || equals == std::string::npos || !SameName(Trim(line.substr(0, equals)), key)) {
+                continue;
+            }
+            std::string value = Trim(line.substr(equals + 1));
+            if (value.size() >= 2 && (value.front() == '"' || value.front() == '\'') && value.back() == value.front()) {
+                value = value.substr(1, value.size() - 2);
+            }
+            return value;
+        }
+        return std::nullopt;
+    }
+
+    int GetInt(const std::string& section, const std::string& key, int defaultValue) {
+        std::optional<std::string> value = Find(section, key);
+        // 与 GetPrivateProfileInt 相同，只取值开头的数字
+        return value ? static_cast<int>(std::strtol(value->c_str(), nullptr, 10)) : defaultValue;
+    }
+
+    std::string GetString(const std::string& section, const std::string& key, const std::string& defaultValue) {
+        std::optional<std::string> value = Find(section, key);
+        return value ? *value : defaultValue;
+    }
+#endif
+}
\ No newline at end of file
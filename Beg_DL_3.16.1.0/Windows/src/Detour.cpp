@@ -0,0 +1,665 @@
+#include "Detour.h"
+#include <cstring>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <mutex>
+
+#ifdef _WIN32
+#include <Windows.h>
+#include <intrin.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace Detour {
+    // ---------------------------------------------------------------------
+    // 指令长度解码
+    // ---------------------------------------------------------------------
+
+    // 0F xx 中没有 ModRM 的操作码
+    static bool TwoByteHasModRM(uint8_t op) {
+        if (op >= 0x30 && op <= 0x37) return false;
+        if (op >= 0x80 && op <= 0x8F) return false;
+        if (op >= 0xC8 && op <= 0xCF) return false;
+        switch (op) {
+        case 0x05: case 0x06: case 0x07: case 0x08: case 0x09: case 0x0B: case 0x0E:
+        case 0x77: case 0xA0: case 0xA1: case 0xA2: case 0xA8: case 0xA9: case 0xAA:
+            return false;
+        default:
+            return true;
+        }
+    }
+
+    // 0F xx 中带 imm8 的操作码
+    static bool TwoByteHasImm8(uint8_t op) {
+        switch (op) {
+        case 0x0F: case 0x70: case 0x71: case 0x72: case 0x73: case 0xA4: case 0xAC:
+        case 0xBA: case 0xC2: case 0xC4: case 0xC5: case 0xC6:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    bool Decode(const uint8_t* code, Instruction& out) {
+        out = Instruction{};
+        const uint8_t* p = code;
+        bool operand16 = false;
+        bool address32 = false;
+        bool rexW = false;
+
+        // 传统前缀
+        for (int i = 0; i < 14; ++i) {
+            uint8_t b = *p;
+            if (b == 0x66) operand16 = true;
+            else if (b == 0x67) address32 = true;
+            else if (b != 0xF0 && b != 0xF2 && b != 0xF3 && b != 0x2E && b != 0x36 && b != 0x3E && b != 0x26 && b != 0x64 && b != 0x65) break;
+            p++;
+        }
+        // REX 前缀必须紧挨操作码
+        if ((*p & 0xF0) == 0x40) {
+            rexW = (*p & 0x08) != 0;
+            p++;
+        }
+
+        uint8_t op = *p++;
+        bool modrm = false;
+        size_t imm = 0;
+        size_t immZ = operand16 ? 2 : 4;
+        int map = 0;
+
+        if (op == 0xC5 || op == 0xC4 || op == 0x62) {
+            // VEX / EVEX，在 64 位模式下总是向量指令
+            if (op == 0xC5) {
+                map = 1;
+                p += 1;
+            }
+            else if (op == 0xC4) {
+                map = p[0] & 0x1F;
+                p += 2;
+            }
+            else {
+                map = p[0] & 0x07;
+                p += 3;
+            }
+            if (map < 1 || map > 3) return false;
+            op = *p++;
+            modrm = !(map == 1 && op == 0x77); // vzeroupper / vzeroall
+            if (map == 3 || (map == 1 && TwoByteHasImm8(op))) imm = 1;
+        }
+        else if (op == 0x0F) {
+            op = *p++;
+            if (op == 0x38) {
+                map = 2;
+                op = *p++;
+                modrm = true;
+            }
+            else if (op == 0x3A) {
+                map = 3;
+                op = *p++;
+                modrm = true;
+                imm = 1;
+            }
+            else {
+                map = 1;
+                modrm = TwoByteHasModRM(op);
+                if (TwoByteHasImm8(op)) imm = 1;
+                if (op >= 0x80 && op <= 0x8F) {
+                    out.branch = Instruction::Branch::Jcc;
+                    out.relSize = 4;
+                }
+            }
+        }
+        else {
+            if (op < 0x40) {
+                switch (op & 0x07) {
+                case 0: case 1: case 2: case 3: modrm = true; break;
+                case 4: imm = 1; break;
+                case 5: imm = immZ; break;
+                default:
+                    // 06/07/0E/16/17/1E/1F/27/2F/37/3F 在 64 位模式下无效，26/2E/36/3E 是前缀已处理
+                    return false;
+                }
+            }
+            else if (op >= 0x40 && op <= 0x4F) {
+                return false; // 多余的 REX
+            }
+            else if (op >= 0x50 && op <= 0x5F) {
+            }
+            else if (op >= 0x70 && op <= 0x7F) {
+                out.branch = Instruction::Branch::Jcc;
+                out.relSize = 1;
+            }
+            else if (op >= 0x91 && op <= 0x9F) {
+                if (op == 0x9A) return false;
+            }
+            else if (op >= 0xB0 && op <= 0xB7) {
+                imm = 1;
+            }
+            else if (op >= 0xB8 && op <= 0xBF) {
+                imm = rexW ? 8 : immZ;
+            }
+            else if (op >= 0xD8 && op <= 0xDF) {
+                modrm = true; // x87
+            }
+            else if (op >= 0xE0 && op <= 0xE3) {
+                out.branch = Instruction::Branch::Loop;
+                out.relSize = 1;
+            }
+            else {
+                switch (op) {
+                case 0x63: case 0x84: case 0x85: case 0x86: case 0x87: case 0x88: case 0x89: case 0x8A: case 0x8B:
+                case 0x8C: case 0x8D: case 0x8E: case 0x8F: case 0xD0: case 0xD1: case 0xD2: case 0xD3:
+                case 0xFE: case 0xFF:
+                    modrm = true; break;
+                case 0x69: case 0x81: case 0xC7:
+                    modrm = true; imm = immZ; break;
+                case 0x6B: case 0x80: case 0x83: case 0xC0: case 0xC1: case 0xC6:
+                    modrm = true; imm = 1; break;
+                case 0x68: case 0xA9:
+                    imm = immZ; break;
+                case 0x6A: case 0xA8: case 0xCD: case 0xE4: case 0xE5: case 0xE6: case 0xE7:
+                    imm = 1; break;
+                case 0xC2: case 0xCA:
+                    imm = 2; out.endsFlow = true; break;
+                case 0xC8:
+                    imm = 3; break;
+                case 0xA0: case 0xA1: case 0xA2: case 0xA3:
+                    imm = address32 ? 4 : 8; break; // moffs
+                case 0xC3: case 0xCB: case 0xCC: case 0xCF:
+                    out.endsFlow = true; break;
+                case 0xE8:
+                    out.branch = Instruction::Branch::Call; out.relSize = 4; break;
+                case 0xE9:
+                    out.branch = Instruction::Branch::Jmp; out.relSize = 4; out.endsFlow = true; break;
+                case 0xEB:
+                    out.branch = Instruction::Branch::Jmp; out.relSize = 1; out.endsFlow = true; break;
+                case 0xF6: case 0xF7:
+                    modrm = true;
+                    if (((p[0] >> 3) & 0x07) < 2) imm = op == 0xF6 ? 1 : immZ; // test r/m, imm
+                    break;
+                case 0x60: case 0x61: case 0x82: case 0xCE: case 0xD4: case 0xD5: case 0xD6: case 0xEA:
+                    return false;
+                default:
+                    break; // 其余单字节指令没有操作数（6C-6F, 90, A4-AF, C9, D7, EC-EF, F1, F4-FD 等）
+                }
+            }
+        }
+
+        if (modrm) {
+            uint8_t m = *p++;
+            uint8_t mod = m >> 6;
+            uint8_t rm = m & 0x07;
+            if (map == 0 && op == 0xFF) {
+                uint8_t reg = (m >> 3) & 0x07;
+                if (reg == 4 || reg == 5) out.endsFlow = true; // jmp r/m
+            }
+            if (mod != 3) {
+                if (rm == 4) {
+                    uint8_t sib = *p++;
+                    if (mod == 0 && (sib & 0x07) == 5) p += 4;
+                }
+                if (mod == 0 && rm == 5) {
+                    out.ripRelative = true;
+                    out.dispOffset = static_cast<size_t>(p - code);
+                    p += 4;
+                }
+                else if (mod == 1) {
+                    p += 1;
+                }
+                else if (mod == 2) {
+                    p += 4;
+                }
+            }
+        }
+
+        if (out.relSize) {
+            out.relOffset = static_cast<size_t>(p - code);
+            p += out.relSize;
+        }
+        p += imm;
+
+        out.length = static_cast<size_t>(p - code);
+        out.opcode = op;
+        out.map = map;
+        return out.length <= 15;
+    }
+
+    // ---------------------------------------------------------------------
+    // 跳板
+    // ---------------------------------------------------------------------
+
+    static constexpr size_t JmpRel32Size = 5;
+    static constexpr size_t JmpAbsSize = 14;
+
+    static bool FitsRel32(const void* from, const void* to) {
+        int64_t distance = reinterpret_cast<intptr_t>(to) - reinterpret_cast<intptr_t>(from);
+        return distance >= INT32_MIN && distance <= INT32_MAX;
+    }
+
+    // jmp [rip+0] 后紧跟 8 字节绝对地址
+    static void WriteJmpAbs(uint8_t* at, const void* destination) {
+        at[0] = 0xFF;
+        at[1] = 0x25;
+        std::memset(at + 2, 0, 4);
+        uint64_t address = reinterpret_cast<uint64_t>(destination);
+        std::memcpy(at + 6, &address, 8);
+    }
+
+    static void WriteJmpRel32(uint8_t* at, const uint8_t* atAddress, const void* destination) {
+        int32_t rel = static_cast<int32_t>(reinterpret_cast<intptr_t>(destination) - reinterpret_cast<intptr_t>(atAddress + JmpRel32Size));
+        at[0] = 0xE9;
+        std::memcpy(at + 1, &rel, 4);
+    }
+
+    bool BuildTrampoline(const uint8_t* target, size_t minBytes, uint8_t* trampoline, size_t capacity, size_t& stolen, size_t& written) {
+        stolen = 0;
+        written = 0;
+
+        // 先确定要搬走多少字节，跳转目标不能落在这段字节中间
+        size_t total = 0;
+        while (total < minBytes) {
+            Instruction ins;
+            if (!Decode(target + total, ins) || ins.length == 0) {
+                printf("[Begeerte] Detour: Cannot decode instruction at %p.\n", target + total);
+                return false;
+            }
+            total += ins.length;
+            if (ins.endsFlow && total < minBytes) {
+                printf("[Begeerte] Detour: Function at %p is too short to hook.\n", target);
+                return false;
+            }
+        }
+
+        while (stolen < minBytes) {
+            const uint8_t* source = target + stolen;
+            Instruction ins;
+            Decode(source, ins);
+            if (written + ins.length + JmpAbsSize + 2 > capacity) {
+                return false;
+            }
+            uint8_t* out = trampoline + written;
+            const uint8_t* outAddress = out; // 跳板在本进程中，写入地址即执行地址
+            const uint8_t* next = source + ins.length;
+
+            if (ins.branch != Instruction::Branch::None) {
+                int64_t rel = 0;
+                if (ins.relSize == 1) {
+                    rel = static_cast<int8_t>(source[ins.relOffset]);
+                }
+                else {
+                    int32_t rel32;
+                    std::memcpy(&rel32, source + ins.relOffset, 4);
+                    rel = rel32;
+                }
+                const uint8_t* destination = next + rel;
+                if (destination > target && destination < target + total) {
+                    printf("[Begeerte] Detour: Branch at %p jumps into the patched bytes.\n", source);
+                    return false;
+                }
+
+                switch (ins.branch) {
+                case Instruction::Branch::Jmp:
+                    WriteJmpAbs(out, destination);
+                    written += JmpAbsSize;
+                    break;
+                case Instruction::Branch::Call: {
+                    // call [rip+2]; jmp +8; dq destination
+                    static const uint8_t call[] = { 0xFF, 0x15, 0x02, 0x00, 0x00, 0x00, 0xEB, 0x08 };
+                    std::memcpy(out, call, sizeof(call));
+                    uint64_t address = reinterpret_cast<uint64_t>(destination);
+                    std::memcpy(out + sizeof(call), &address, 8);
+                    written += sizeof(call) + 8;
+                    break;
+                }
+                case Instruction::Branch::Jcc: {
+                    // 反转条件跳过绝对跳转：j!cc +14; jmp [rip+0]; dq destination
+                    uint8_t condition = ins.map == 1 ? static_cast<uint8_t>(ins.opcode - 0x80) : static_cast<uint8_t>(ins.opcode - 0x70);
+                    out[0] = static_cast<uint8_t>(0x70 | (condition ^ 1));
+                    out[1] = static_cast<uint8_t>(JmpAbsSize);
+                    WriteJmpAbs(out + 2, destination);
+                    written += 2 + JmpAbsSize;
+                    break;
+                }
+                case Instruction::Branch::Loop: {
+                    // loop/jrcxz +2; jmp +14; jmp [rip+0]; dq destination
+                    size_t prefix = ins.relOffset - 1; // 保留 67 等前缀
+                    std::memcpy(out, source, prefix + 1);
+                    out[prefix + 1] = 0x02;
+                    out[prefix + 2] = 0xEB;
+                    out[prefix + 3] = static_cast<uint8_t>(JmpAbsSize);
+                    WriteJmpAbs(out + prefix + 4, destination);
+                    written += prefix + 4 + JmpAbsSize;
+                    break;
+                }
+                default:
+                    break;
+                }
+            }
+            else {
+                std::memcpy(out, source, ins.length);
+                if (ins.ripRelative) {
+                    int32_t disp;
+                    std::memcpy(&disp, source + ins.dispOffset, 4);
+                    const uint8_t* absolute = next + disp;
+                    const uint8_t* newNext = outAddress + ins.length;
+                    if (!FitsRel32(newNext, absolute)) {
+                        printf("[Begeerte] Detour: RIP-relative operand at %p is out of range of the trampoline.\n", source);
+                        return false;
+                    }
+                    int32_t newDisp = static_cast<int32_t>(absolute - newNext);
+                    std::memcpy(out + ins.dispOffset, &newDisp, 4);
+                }
+                written += ins.length;
+            }
+
+            stolen += ins.length;
+            if (ins.endsFlow) {
+                return true; // 不会顺序执行到后面，不需要跳回
+            }
+        }
+
+        // 跳回原函数剩余部分
+        if (written + JmpAbsSize > capacity) {
+            return false;
+        }
+        WriteJmpAbs(trampoline + written, target + stolen);
+        written += JmpAbsSize;
+        return true;
+    }
+
+    // ---------------------------------------------------------------------
+    // 内存
+    // ---------------------------------------------------------------------
+
+    // 跳板需要在目标 ±2GB 以内，RIP 相对寻址和 rel32 跳转才能重定位
+    static constexpr size_t RegionSize = 0x10000;
+    static constexpr size_t SlotSize = 128;
+
+    static uint8_t* AllocateNear(const uint8_t* target) {
+        uintptr_t origin = reinterpret_cast<uintptr_t>(target) & ~static_cast<uintptr_t>(RegionSize - 1);
+        const uintptr_t range = 0x7FF00000;
+        uintptr_t low = origin > range ? origin - range : RegionSize;
+        uintptr_t high = origin + range;
+
+#ifdef _WIN32
+        // 先向下再向上找空闲区域，按 VirtualQuery 返回的区域跳过已占用的部分
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        uintptr_t granularity = info.dwAllocationGranularity;
+        for (int direction = 0; direction < 2; ++direction) {
+            uintptr_t address = direction == 0 ? origin - RegionSize : origin + RegionSize;
+            while (address > low && address < high) {
+                MEMORY_BASIC_INFORMATION mbi;
+                if (!VirtualQuery(reinterpret_cast<LPCVOID>(address), &mbi, sizeof(mbi))) {
+                    break;
+                }
+                if (mbi.State == MEM_FREE && mbi.RegionSize >= RegionSize) {
+                    void* region = VirtualAlloc(reinterpret_cast<LPVOID>(address), RegionSize, MEM_RESERVE | MEM_COMMIT, PAGE_EXECUTE_READWRITE);
+                    if (region) {
+                        return static_cast<uint8_t*>(region);
+                    }
+                }
+                if (direction == 0) {
+                    uintptr_t below = reinterpret_cast<uintptr_t>(mbi.AllocationBase ? mbi.AllocationBase : mbi.BaseAddress);
+                    address = below > RegionSize ? ((below - RegionSize) & ~(granularity - 1)) : 0;
+                }
+                else {
+                    uintptr_t above = reinterpret_cast<uintptr_t>(mbi.BaseAddress) + mbi.RegionSize;
+                    address = (above + granularity - 1) & ~(granularity - 1);
+                }
+            }
+        }
+#else
+        for (uintptr_t step = RegionSize; step < range; step += RegionSize) {
+            for (uintptr_t candidate : { origin - step, origin + step }) {
+                if (candidate < low || candidate > high) {
+                    continue;
+                }
+                void* region = mmap(reinterpret_cast<void*>(candidate), RegionSize, PROT_READ | PROT_WRITE | PROT_EXEC,
+                    MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if (region == MAP_FAILED) {
+                    continue;
+                }
+                if (FitsRel32(target, static_cast<uint8_t*>(region)) && FitsRel32(static_cast<uint8_t*>(region) + RegionSize, target)) {
+                    return static_cast<uint8_t*>(region);
+                }
+                munmap(region, RegionSize); // 内核没有采纳提示地址
+            }
+        }
+#endif
+        return nullptr;
+    }
+
+    // 临时让目标可写，析构时恢复
+    class WritableScope {
+    public:
+        WritableScope(void* address, size_t size) {
+#ifdef _WIN32
+            base = address;
+            length = size;
+            ok = VirtualProtect(address, size, PAGE_EXECUTE_READWRITE, &oldProtect) != 0;
+#else
+            uintptr_t page = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+            uintptr_t start = reinterpret_cast<uintptr_t>(address) & ~(page - 1);
+            uintptr_t end = (reinterpret_cast<uintptr_t>(address) + size + page - 1) & ~(page - 1);
+            base = reinterpret_cast<void*>(start);
+            length = end - start;
+            ok = mprotect(base, length, PROT_READ | PROT_WRITE | PROT_EXEC) == 0;
+#endif
+        }
+        ~WritableScope() {
+            if (!ok) return;
+#ifdef _WIN32
+            DWORD ignored;
+            VirtualProtect(base, length, oldProtect, &ignored);
+            FlushInstructionCache(GetCurrentProcess(), base, length);
+#else
+            mprotect(base, length, PROT_READ | PROT_EXEC);
+            __builtin___clear_cache(static_cast<char*>(base), static_cast<char*>(base) + length);
+#endif
+        }
+        bool ok = false;
+
+    private:
+        void* base = nullptr;
+        size_t length = 0;
+#ifdef _WIN32
+        DWORD oldProtect = 0;
+#endif
+    };
+
+    // 16 字节对齐块的原子比较交换，其他线程永远看不到写了一半的指令
+    static bool CompareExchange16(uint64_t* block, uint64_t* expected, const uint64_t* desired) {
+#ifdef _MSC_VER
+        return _InterlockedCompareExchange128(reinterpret_cast<volatile long long*>(block), static_cast<long long>(desired[1]),
+            static_cast<long long>(desired[0]), reinterpret_cast<long long*>(expected)) != 0;
+#else
+        bool ok;
+        __asm__ __volatile__("lock cmpxchg16b %1\n\tsete %0"
+            : "=q"(ok), "+m"(*reinterpret_cast<volatile __int128*>(block)), "+a"(expected[0]), "+d"(expected[1])
+            : "b"(desired[0]), "c"(desired[1])
+            : "cc", "memory");
+        return ok;
+#endif
+    }
+
+    static bool WriteInBlock(uint8_t* address, const uint8_t* bytes, size_t size) {
+        uintptr_t start = reinterpret_cast<uintptr_t>(address);
+        uintptr_t blockStart = start & ~static_cast<uintptr_t>(15);
+        if (start + size > blockStart + 16) {
+            return false;
+        }
+        uint64_t* block = reinterpret_cast<uint64_t*>(blockStart);
+        while (true) {
+            alignas(16) uint64_t expected[2];
+            std::memcpy(expected, block, 16);
+            alignas(16) uint64_t desired[2];
+            std::memcpy(desired, expected, 16);
+            std::memcpy(reinterpret_cast<uint8_t*>(desired) + (start - blockStart), bytes, size);
+            if (CompareExchange16(block, expected, desired)) {
+                return true;
+            }
+        }
+    }
+
+    // 写入跳转。跨 16 字节边界时先把开头换成原地循环的 jmp $，写完其余字节后再原子地换上真正的开头
+    static void AtomicPatch(uint8_t* address, const uint8_t* bytes, size_t size) {
+        if (WriteInBlock(address, bytes, size)) {
+            return;
+        }
+        static const uint8_t spin[] = { 0xEB, 0xFE };
+        if (!WriteInBlock(address, spin, 2)) {
+            std::memcpy(address, spin, 2);
+        }
+        std::memcpy(address + 2, bytes + 2, size - 2);
+        if (!WriteInBlock(address, bytes, 2)) {
+            std::memcpy(address, bytes, 2);
+        }
+    }
+
+    // ---------------------------------------------------------------------
+    // 注册表
+    // ---------------------------------------------------------------------
+
+    struct Entry {
+        std::string name;
+        uint8_t* target = nullptr;
+        void* detour = nullptr;
+        uint8_t* slot = nullptr;       // [中继 jmp][跳板]
+        uint8_t* trampoline = nullptr;
+        size_t stolen = 0;
+        uint8_t original[JmpRel32Size] = {};
+        uint8_t patch[JmpRel32Size] = {};
+        bool enabled = false;
+    };
+
+    struct Region {
+        uint8_t* base;
+        size_t used;
+    };
+
+    static std::mutex RegistryMutex;
+    static std::map<uint8_t*, Entry> Hooks;
+    static std::vector<Region> Regions;
+
+    static uint8_t* AllocateSlot(const uint8_t* target) {
+        for (auto& region : Regions) {
+            if (region.used + SlotSize <= RegionSize && FitsRel32(target, region.base) && FitsRel32(region.base + RegionSize, target)) {
+                uint8_t* slot = region.base + region.used;
+                region.used += SlotSize;
+                return slot;
+            }
+        }
+        uint8_t* base = AllocateNear(target);
+        if (!base) {
+            return nullptr;
+        }
+        Regions.push_back(Region{ base, SlotSize });
+        return base;
+    }
+
+    bool Create(void* target, void* detour, void** original, const std::string& name) {
+        std::lock_guard<std::mutex> lock(RegistryMutex);
+        uint8_t* code = static_cast<uint8_t*>(target);
+        if (!code || !detour) {
+            return false;
+        }
+        if (Hooks.count(code)) {
+            printf("[Begeerte] Detour::Create failed: %p is already hooked.\n", target);
+            return false;
+        }
+        uint8_t* slot = AllocateSlot(code);
+        if (!slot) {
+            printf("[Begeerte] Detour::Create failed: No free memory within 2GB of %p.\n", target);
+            return false;
+        }
+
+        Entry entry;
+        entry.name = name;
+        entry.target = code;
+        entry.detour = detour;
+        entry.slot = slot;
+        entry.trampoline = slot + JmpAbsSize;
+        size_t written = 0;
+        if (!BuildTrampoline(code, JmpRel32Size, entry.trampoline, SlotSize - JmpAbsSize, entry.stolen, written)) {
+            printf("[Begeerte] Detour::Create failed for %s at %p.\n", name.c_str(), target);
+            return false; // 槽位不回收，失败很少见
+        }
+
+        // detour 在 2GB 以内时直接跳过去，否则经过槽位开头的中继
+        const void* jumpTo = detour;
+        if (!FitsRel32(code + JmpRel32Size, detour)) {
+            WriteJmpAbs(slot, detour);
+            jumpTo = slot;
+        }
+        std::memcpy(entry.original, code, JmpRel32Size);
+        WriteJmpRel32(entry.patch, code, jumpTo);
+
+        if (original) {
+            *original = entry.trampoline;
+        }
+        Hooks[code] = entry;
+        return true;
+    }
+
+    static bool SetEnabled(Entry& entry, bool enabled) {
+        if (entry.enabled == enabled) {
+            return true;
+        }
+        const uint8_t* expected = enabled ? entry.original : entry.patch;
+        if (std::memcmp(entry.target, expected, JmpRel32Size) != 0) {
+            printf("[Begeerte] Detour: %s at %p was modified by someone else, leaving it alone.\n", entry.name.c_str(), entry.target);
+            return false;
+        }
+        WritableScope writable(entry.target, JmpRel32Size);
+        if (!writable.ok) {
+            return false;
+        }
+        AtomicPatch(entry.target, enabled ? entry.patch : entry.original, JmpRel32Size);
+        entry.enabled = enabled;
+        return true;
+    }
+
+    bool Enable(void* target) {
+        std::lock_guard<std::mutex> lock(RegistryMutex);
+        auto it = Hooks.find(static_cast<uint8_t*>(target));
+        return it != Hooks.end() && SetEnabled(it->second, true);
+    }
+
+    bool Disable(void* target) {
+        std::lock_guard<std::mutex> lock(RegistryMutex);
+        auto it = Hooks.find(static_cast<uint8_t*>(target));
+        return it != Hooks.end() && SetEnabled(it->second, false);
+    }
+
+    bool Remove(void* target) {
+        std::lock_guard<std::mutex> lock(RegistryMutex);
+        auto it = Hooks.find(static_cast<uint8_t*>(target));
+        if (it == Hooks.end() || !SetEnabled(it->second, false)) {
+            return false;
+        }
+        Hooks.erase(it);
+        return true;
+    }
+
+    void RemoveAll() {
+        std::lock_guard<std::mutex> lock(RegistryMutex);
+        for (auto& hook : Hooks) {
+            SetEnabled(hook.second, false);
+        }
+        Hooks.clear();
+    }
+
+    std::vector<HookInfo> List() {
+        std::lock_guard<std::mutex> lock(RegistryMutex);
+        std::vector<HookInfo> hooks;
+        for (const auto& hook : Hooks) {
+            const Entry& entry = hook.second;
+            hooks.push_back(HookInfo{ entry.name, entry.target, entry.detour, entry.trampoline, entry.stolen, entry.enabled });
+        }
+        return hooks;
+    }
+}
\ No newline at end of file
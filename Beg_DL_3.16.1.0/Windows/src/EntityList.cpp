@@ -1,83 +1,216 @@
-#include "EntityList.h"
-#include "Offset.h"
-#include "PointerScanner.h"
-#include "Memory.h"
-#include <stdio.h>
-#include <set>
-
-namespace EntityList {
-    static std::vector<DWORD64> entityPointers;  // 洢ʵյַ
-
-    // ڴַǷɶ
-    static bool IsValidAddress(DWORD64 address) {
-        MEMORY_BASIC_INFORMATION mbi;
-        if (VirtualQuery(reinterpret_cast<LPCVOID>(address), &mbi, sizeof(mbi)) == 0) {
-            return false;  // ѯʧ
-        }
-        return (mbi.State == MEM_COMMIT && (mbi.Protect & (PAGE_READONLY | PAGE_READWRITE)) != 0);
-    }
-
-    void Update() {
-        DWORD64 moduleBase = g_cheatdata->moduleBase;
-        if (moduleBase == 0) {
-            printf("[Begeerte] Failed to get module base address.\n");
-            return;  // ģַЧֱӷ
-        }
-
-        std::vector<std::pair<DWORD64, bool>> debugSteps;
-        entityPointers.clear();  // ÿθʱб
-        std::set<DWORD64> uniqueAddresses;  // ڸӵĵַ
-
-        DWORD64 baseAddress = moduleBase + Offset::EntityList::MODULE_OFFSET;
-        const auto& prefixOffsets = Offset::EntityList::FIXED_PREFIX_OFFSETS;
-        const auto& suffixOffsets = Offset::EntityList::FIXED_SUFFIX_OFFSETS;
-
-        for (DWORD64 entityOffset = Offset::EntityList::ENTITY_OFFSET_START;
-            entityOffset <= Offset::EntityList::ENTITY_OFFSET_END;
-            entityOffset += Offset::EntityList::ENTITY_OFFSET_STEP) {
-            std::vector<DWORD64> offsets = prefixOffsets;
-            offsets.push_back(entityOffset);
-            offsets.insert(offsets.end(), suffixOffsets.begin(), suffixOffsets.end());
-
-            /*
-                > Ǿȥɡ
-                > ֻҪⲻĳ嶯־ľ
-                > ߰ɣȥ¡
-                > ֮ǰȼƬҹɫ
-            */
-
-            auto [finalAddress, success] = PointerScanner::Scan(baseAddress, offsets, debugSteps);
-            if (success && finalAddress != 0 && IsValidAddress(finalAddress)) {
-                // ǷѴڸõַ
-                if (uniqueAddresses.find(finalAddress) == uniqueAddresses.end()) {
-                    uniqueAddresses.insert(finalAddress);
-                    entityPointers.push_back(finalAddress);
-                }
-            }
-        }
-    }
-
-    size_t GetMaxPlayers() {
-        return entityPointers.size();
-    }
-
-    DWORD64 GetEntity(int id) {
-        if (id <= 0 || static_cast<size_t>(id) > entityPointers.size()) {
-            return 0;  // Ч ID  0
-        }
-        return entityPointers[static_cast<size_t>(id) - 1];
-    }
-
-    Player* GetPlayer(int id) {
-        DWORD64 address = GetEntity(id);
-        if (address == 0 || !IsValidAddress(address)) {
-            return nullptr;  // Чַ nullptr
-        }
-        return reinterpret_cast<Player*>(address);
-    }
-
-    const std::vector<DWORD64>& GetAllEntities() {
-        return entityPointers;
-    }
-
+#include "EntityList.h"
+#include "Offset.h"
+#include "PointerScanner.h"
+#include "Memory.h"
+#include <stdio.h>
+#include <unordered_set>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+namespace EntityList {
+    static Entities entityPointers = std::make_shared<const std::vector<DWORD64>>();  // 最近一次发布的所有实体最终地址
+    static std::mutex publishMutex;  // 只保护 entityPointers 这个指针的读取和替换，读者不必等待正在进行的 Update
+    static std::atomic<unsigned long long> updateEpoch = 0;  // Update 完成的次数
+    static std::atomic<size_t> playerCount = 0;  // 上一次 Update 找到的有效玩家数量
+    static std::atomic<UpdateCallback> updateCallback = nullptr;
+
+    // 上一次 Update 每个槽位的结果，下一次只需确认它们仍然成立
+    struct SlotCache {
+        DWORD64 slot = 0;    // 槽位中的指针
+        DWORD64 entity = 0;  // 由它解析出的实体地址，0 表示槽位为空或解析失败
+    };
+    static constexpr size_t SlotCount = (Offset::EntityList::ENTITY_OFFSET_END - Offset::EntityList::ENTITY_OFFSET_START) / Offset::EntityList::ENTITY_OFFSET_STEP + 1;
+    static std::vector<SlotCache> slotCache(SlotCount);
+    static std::unordered_set<DWORD64> uniqueAddresses;  // 用于跟踪已添加的地址，每次更新清空但保留容量
+    static DWORD64 cachedContainer = 0;
+    static bool arrayCounted = true;  // 上次更新是否按 Num 遍历，只在变化时输出提示
+    static std::mutex updateMutex;  // Update 会同时从 on_tick、玩家事件轮询等多个线程调用
+
+    // 检查内存地址是否可读
+    static bool IsValidAddress(DWORD64 address) {
+        MEMORY_BASIC_INFORMATION mbi;
+        if (VirtualQuery(reinterpret_cast<LPCVOID>(address), &mbi, sizeof(mbi)) == 0) {
+            return false;  // 查询失败
+        }
+        return (mbi.State == MEM_COMMIT && (mbi.Protect & (PAGE_READONLY | PAGE_READWRITE)) != 0);
+    }
+
+    // 实体来源是 UE 的 TArray { 数据指针, Num, Max }，前置链的最后一级就是它本身
+    struct EntityArray {
+        DWORD64 data = 0;         // 元素所在的内存，0 表示解析失败
+        size_t count = SlotCount; // 要检查的元素数
+        bool counted = false;     // count 来自 Num；为 false 时退回扫描整个 ENTITY_OFFSET_START..END 范围
+    };
+
+    // 解析前置偏移得到实体数组。前置链只有几次解引用，每次更新重新验证的开销远小于逐个槽位重复解析
+    static EntityArray ResolveContainer(DWORD64 baseAddress, std::vector<std::pair<DWORD64, bool>>& debugSteps) {
+        EntityArray result;
+        auto [array, success] = PointerScanner::Scan(baseAddress, Offset::EntityList::FIXED_PREFIX_OFFSETS, debugSteps);
+        if (!success || array == 0 || !PointerScanner::ReadPointer(array, result.data) ||
+            result.data == 0 || !IsValidAddress(result.data)) {
+            result.data = 0;
+            return result;
+        }
+
+        // Num 和 Max 是紧随数据指针的两个 int32，一次读出；数值不合理时（偏移失效等）不信任它们
+        DWORD64 header = 0;
+        if (PointerScanner::ReadPointer(array + Offset::EntityList::ENTITY_ARRAY_NUM_OFFSET, header)) {
+            int32_t num = static_cast<int32_t>(header & 0xFFFFFFFF);
+            int32_t max = static_cast<int32_t>(header >> 32);
+            if (num >= 0 && num <= max && static_cast<size_t>(num) <= SlotCount) {
+                result.count = static_cast<size_t>(num);
+                result.counted = true;
+            }
+        }
+        return result;
+    }
+
+    // 已知实体只需确认槽位指针没变、实体仍带有效标记，不必再走后置偏移和 VirtualQuery
+    static bool StillValid(const SlotCache& cached, DWORD64 slot) {
+        BYTE flag;
+        return cached.entity != 0 && cached.slot == slot &&
+            PointerScanner::ReadByte(cached.entity, flag) && flag == g_cheatdata->EntityValidFlag;
+    }
+
+    void Update() {
+        DWORD64 moduleBase = g_cheatdata->moduleBase;
+        if (moduleBase == 0) {
+            printf("[Begeerte] Failed to get module base address.\n");
+            return;  // 模块基址无效，直接返回
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(updateMutex);
+            static std::vector<std::pair<DWORD64, bool>> debugSteps;
+            std::vector<DWORD64> pointers;  // 每次更新时重建列表，完成后整体发布
+            uniqueAddresses.clear();
+
+            DWORD64 baseAddress = moduleBase + Offset::EntityList::MODULE_OFFSET;
+            const auto& suffixOffsets = Offset::EntityList::FIXED_SUFFIX_OFFSETS;
+
+            // 前置偏移对所有槽位都相同，每次更新只解析一次，得到实体数组
+            EntityArray entities = ResolveContainer(baseAddress, debugSteps);
+            DWORD64 container = entities.data;
+            if (container != cachedContainer) {
+                // 容器换了（地图切换等），上次的槽位结果全部作废
+                printf("[Begeerte] Entity container %s: 0x%llX\n", cachedContainer == 0 ? "resolved" : container == 0 ? "lost" : "moved", container);
+                cachedContainer = container;
+                slotCache.assign(SlotCount, SlotCache());
+            }
+            if (container != 0 && entities.counted != arrayCounted) {
+                arrayCounted = entities.counted;
+                if (arrayCounted) {
+                    printf("[Begeerte] Entity array count readable again, walking only its elements.\n");
+                }
+                else {
+                    printf("[Begeerte] Entity array count unreadable or out of range, scanning all %zu slots.\n", SlotCount);
+                }
+            }
+
+            size_t validPlayers = 0;
+            if (container != 0) {
+                pointers.reserve(entities.count);
+                // 只检查数组中实际存在的 Num 个元素，服务器越空，更新越快
+                for (size_t index = 0; index < entities.count; ++index) {
+                    DWORD64 entityOffset = Offset::EntityList::ENTITY_OFFSET_START + index * Offset::EntityList::ENTITY_OFFSET_STEP;
+                    /*
+                        > 那就去做吧。
+                        > 只要你清楚，这不是情绪的冲动，而是意志的抉择。
+                        > 走吧，去做这件你决定的事。
+                        > 天亮之前，燃尽这片夜色。
+                    */
+
+                    SlotCache& cached = slotCache[index];
+                    DWORD64 slot = 0;
+                    if (!PointerScanner::ReadPointer(container + entityOffset, slot) || slot == 0) {
+                        cached = SlotCache();  // 空槽位
+                        continue;
+                    }
+
+                    DWORD64 finalAddress = cached.entity;
+                    bool valid = StillValid(cached, slot);
+                    if (!valid) {
+                        // 新的或有变化的槽位：从槽位开始只走后置偏移，与完整指针链 prefix + entity + suffix 的结果相同
+                        auto [address, success] = PointerScanner::Scan(container + entityOffset, suffixOffsets, debugSteps);
+                        finalAddress = success && address != 0 && IsValidAddress(address) ? address : 0;
+                        cached = { slot, finalAddress };
+                        BYTE flag;
+                        valid = finalAddress != 0 && PointerScanner::ReadByte(finalAddress, flag) && flag == g_cheatdata->EntityValidFlag;
+                    }
+
+                    // 检查是否已存在该地址
+                    if (finalAddress != 0 && uniqueAddresses.insert(finalAddress).second) {
+                        pointers.push_back(finalAddress);
+                        if (valid) {
+                            validPlayers++;
+                        }
+                    }
+                }
+            }
+
+            Entities published = std::make_shared<const std::vector<DWORD64>>(std::move(pointers));
+            {
+                std::lock_guard<std::mutex> publishLock(publishMutex);
+                entityPointers.swap(published);
+            }
+            playerCount.store(validPlayers, std::memory_order_relaxed);
+            updateEpoch.fetch_add(1, std::memory_order_release);
+        }
+
+        if (UpdateCallback callback = updateCallback.load(std::memory_order_acquire)) {
+            callback();
+        }
+    }
+
+    Entities GetAllEntities() {
+        std::lock_guard<std::mutex> lock(publishMutex);
+        return entityPointers;
+    }
+
+    size_t GetMaxPlayers() {
+        return GetAllEntities()->size();
+    }
+
+    DWORD64 GetEntity(int id) {
+        Entities entities = GetAllEntities();
+        if (id <= 0 || static_cast<size_t>(id) > entities->size()) {
+            return 0;  // 无效 ID 返回 0
+        }
+        return (*entities)[static_cast<size_t>(id) - 1];
+    }
+
+    Player* GetPlayer(int id) {
+        DWORD64 address = GetEntity(id);
+        if (address == 0 || !IsValidAddress(address)) {
+            return nullptr;  // 无效地址返回 nullptr
+        }
+        return reinterpret_cast<Player*>(address);
+    }
+
+    std::vector<Player*> GetValidPlayers() {
+        Entities entities = GetAllEntities();  // 整个遍历使用同一份列表，ID 顺序不会被中途的 Update 打乱
+        std::vector<Player*> players;
+        players.reserve(entities->size());
+        for (DWORD64 address : *entities) {
+            Player* player = reinterpret_cast<Player*>(address);
+            if (IsValidAddress(address) && player->IsValid()) {
+                players.push_back(player);
+            }
+        }
+        return players;
+    }
+
+    unsigned long long GetUpdateEpoch() {
+        return updateEpoch.load(std::memory_order_acquire);
+    }
+
+    size_t GetPlayerCount() {
+        return playerCount.load(std::memory_order_relaxed);
+    }
+
+    void SetUpdateCallback(UpdateCallback callback) {
+        updateCallback.store(callback, std::memory_order_release);
+    }
+
 }
\ No newline at end of file
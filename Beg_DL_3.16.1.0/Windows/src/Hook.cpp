@@ -1,44 +1,109 @@
-#include "Hook.h"
-#include "Console.h"
-#include "PointerScanner.h"
-#include "Offset.h"
-#include "CheatData.h"
-#include <thread>
-#include <stdio.h>
-
-namespace Hook {
-    static bool isRunning = false;
-    static HANDLE hookThread = nullptr;
-
-    static DWORD64 LocalPlayerAddress = 0;
-
-    static void UpdateThread() {
-        DWORD64 moduleBase = g_cheatdata->moduleBase;
-        std::vector<std::pair<DWORD64, bool>> debugSteps;
-
-        while (isRunning) {
-            // ڴַ
-
-        }
-    }
-
-    void Initialize() {
-        Console::Initialize();
-        isRunning = true;
-        hookThread = CreateThread(nullptr, 0, (LPTHREAD_START_ROUTINE)UpdateThread, nullptr, 0, nullptr);
-    }
-
-    void Cleanup() {
-        isRunning = false;
-        if (hookThread) {
-            WaitForSingleObject(hookThread, INFINITE);
-            CloseHandle(hookThread);
-            hookThread = nullptr;
-        }
-        Console::Cleanup();
-    }
-
-    DWORD64 GetLocalPlayerAddress() {
-        return LocalPlayerAddress;
-    }
+#include "Hook.h"
+#include "Console.h"
+#include "PointerScanner.h"
+#include "Offset.h"
+#include "CheatData.h"
+#include "Config.h"
+#include "Detour.h"
+#include "LoadGovernor.h"
+#include "ServiceLoop.h"
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <stdio.h>
+
+namespace Hook {
+    static DWORD64 LocalPlayerAddress = 0;
+
+    static std::atomic<TickCallback> tickCallback{ nullptr };
+    static std::atomic<bool> engineTickSeen{ false }; // 引擎 tick 已经接管，服务线程不再驱动
+    static std::mutex tickMutex;
+    static std::chrono::steady_clock::time_point lastTick;
+    static ServiceLoop::ServiceId fallbackTickService = 0;
+
+    static void RunTick() {
+        // 切换 tick 来源的瞬间两边可能同时到达，只执行其中一个
+        std::unique_lock<std::mutex> lock(tickMutex, std::try_to_lock);
+        if (!lock.owns_lock()) {
+            return;
+        }
+        auto now = std::chrono::steady_clock::now();
+        double dt_ms = lastTick.time_since_epoch().count() == 0 ? 0.0 : std::chrono::duration<double, std::milli>(now - lastTick).count();
+        lastTick = now;
+        if (TickCallback callback = tickCallback.load()) {
+            callback(dt_ms);
+        }
+    }
+
+    // 尚未 hook 引擎 tick 时由服务线程按固定间隔代替，引擎 tick 接管后注销自身
+    static void FallbackTick() {
+        if (engineTickSeen.load()) {
+            ServiceLoop::Unregister(fallbackTickService);
+            printf("[Begeerte] Tick source: engine tick, on_tick now runs on the game thread.\n");
+            return;
+        }
+        RunTick();
+    }
+
+    void SetTickCallback(TickCallback callback) {
+        tickCallback.store(callback);
+    }
+
+    void OnServerTick() {
+        engineTickSeen.store(true);
+        RunTick();
+    }
+
+    using GameEngineTickFn = void(*)(void* engine, float deltaSeconds, bool idleMode);
+    static GameEngineTickFn OriginalGameEngineTick = nullptr;
+
+    static void GameEngineTickDetour(void* engine, float deltaSeconds, bool idleMode) {
+        // 只计引擎自身的耗时，不包括之后的脚本
+        auto start = std::chrono::steady_clock::now();
+        OriginalGameEngineTick(engine, deltaSeconds, idleMode);
+        LoadGovernor::RecordFrame(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        OnServerTick();
+    }
+
+    // 在引擎 tick 之后调用脚本，偏移未设置时继续使用服务线程。返回 hook 是否安装成功
+    static bool InstallTickHook() {
+        if (!g_cheatdata || !Offset::Engine::GAME_ENGINE_TICK) {
+            printf("[Begeerte] Engine tick offset not set.\n");
+            return false;
+        }
+        auto target = reinterpret_cast<GameEngineTickFn>(g_cheatdata->moduleBase + Offset::Engine::GAME_ENGINE_TICK);
+        if (!Detour::Create(target, &GameEngineTickDetour, &OriginalGameEngineTick, "UGameEngine::Tick") || !Detour::Enable(reinterpret_cast<void*>(target))) {
+            printf("[Begeerte] Failed to hook the engine tick.\n");
+            return false;
+        }
+        printf("[Begeerte] Hooked UGameEngine::Tick at 0x%llX.\n", g_cheatdata->moduleBase + Offset::Engine::GAME_ENGINE_TICK);
+        return true;
+    }
+
+    void Initialize() {
+        Console::Initialize();
+        LoadGovernor::Initialize();
+        ServiceLoop::Start();
+        bool hooked = InstallTickHook();
+        int fallbackMs = Config::GetInt("Hook", "FallbackTickMs", 50);
+        fallbackTickService = ServiceLoop::Register("fallback tick", std::chrono::milliseconds(fallbackMs > 0 ? fallbackMs : 1), FallbackTick);
+        if (hooked) {
+            printf("[Begeerte] Tick source: fallback timer until the first engine tick.\n");
+        }
+        else {
+            printf("[Begeerte] Tick source: fallback timer every %d ms on the service thread. on_tick is not synchronized with the game thread.\n", fallbackMs > 0 ? fallbackMs : 1);
+            // 负载调节只测量引擎 tick，没有 hook 时它不会生效
+            printf("[Begeerte] Load governor inactive: no engine tick to measure, plugin refresh rates stay normal.\n");
+        }
+    }
+
+    void Cleanup() {
+        Detour::RemoveAll();
+        ServiceLoop::Stop();
+        Console::Cleanup();
+    }
+
+    DWORD64 GetLocalPlayerAddress() {
+        return LocalPlayerAddress;
+    }
 }
\ No newline at end of file
@@ -0,0 +1,96 @@
+#include "LoadGovernor.h"
+#include "Config.h"
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <stdio.h>
+
+namespace LoadGovernor {
+    using Clock = std::chrono::steady_clock;
+
+    static double targetMs = 0;       // 0 为关闭
+    static double recoverMs = 0;      // 低于此值才开始计时恢复，与 targetMs 之间为死区
+    static double smoothing = 0.1;
+    static int maxLevel = 3;
+    static Clock::duration raiseAfter = std::chrono::milliseconds(500);
+    static Clock::duration recoverAfter = std::chrono::milliseconds(3000);
+
+    // 只由游戏线程读写
+    static double average = 0;
+    static Clock::time_point overSince;
+    static Clock::time_point underSince;
+
+    // 其他线程只读取这两个值
+    static std::atomic<int> level{ 0 };
+    static std::atomic<double> published{ 0 };
+
+    void Initialize() {
+        targetMs = std::max(Config::GetInt("Governor", "TargetFrameMs", 30), 0);
+        recoverMs = targetMs * std::clamp(Config::GetInt("Governor", "RecoverPct", 80), 1, 100) / 100.0;
+        smoothing = std::clamp(Config::GetInt("Governor", "SmoothingPct", 10), 1, 100) / 100.0;
+        maxLevel = std::clamp(Config::GetInt("Governor", "MaxLevel", 3), 0, 6);
+        raiseAfter = std::chrono::milliseconds(std::max(Config::GetInt("Governor", "RaiseAfterMs", 500), 0));
+        recoverAfter = std::chrono::milliseconds(std::max(Config::GetInt("Governor", "RecoverAfterMs", 3000), 0));
+    }
+
+    static void SetLevel(int newLevel) {
+        int oldLevel = level.exchange(newLevel);
+        if (newLevel > oldLevel) {
+            printf("[Begeerte] Server frame time %.1f ms is over the %.0f ms target, plugin refresh rates lowered to 1/%d.\n", average, targetMs, 1 << newLevel);
+        }
+        else if (newLevel > 0) {
+            printf("[Begeerte] Server frame time back to %.1f ms, plugin refresh rates raised to 1/%d.\n", average, 1 << newLevel);
+        }
+        else {
+            printf("[Begeerte] Server frame time back to %.1f ms, plugin refresh rates restored.\n", average);
+        }
+    }
+
+    void RecordFrame(double frame_ms) {
+        average = average == 0 ? frame_ms : average + smoothing * (frame_ms - average);
+        published.store(average, std::memory_order_relaxed);
+        if (targetMs <= 0) {
+            return;
+        }
+
+        // 帧耗时需要在阈值之外持续一段时间才会调整一级，调整后重新计时，避免在阈值附近来回切换
+        auto now = Clock::now();
+        int current = level.load(std::memory_order_relaxed);
+        if (average > targetMs) {
+            underSince = {};
+            if (overSince == Clock::time_point{}) {
+                overSince = now;
+            }
+            else if (current < maxLevel && now - overSince >= raiseAfter) {
+                SetLevel(current + 1);
+                overSince = now;
+            }
+        }
+        else if (average < recoverMs) {
+            overSince = {};
+            if (underSince == Clock::time_point{}) {
+                underSince = now;
+            }
+            else if (current > 0 && now - underSince >= recoverAfter) {
+                SetLevel(current - 1);
+                underSince = now;
+            }
+        }
+        else {
+            overSince = {};
+            underSince = {};
+        }
+    }
+
+    int Level() {
+        return level.load(std::memory_order_relaxed);
+    }
+
+    int Scale() {
+        return 1 << level.load(std::memory_order_relaxed);
+    }
+
+    double FrameMs() {
+        return published.load(std::memory_order_relaxed);
+    }
+}
\ No newline at end of file
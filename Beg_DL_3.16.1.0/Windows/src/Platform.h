@@ -0,0 +1,25 @@
+#pragma once
+#include <filesystem>
+#include <string>
+
+// 插件和 Windows 版 BegHost 直接使用 Windows.h；脚本运行时、BegHost 和测试在其他平台上编译时，
+// 公共头文件只需要下面这几个基本类型
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <cstdint>
+
+typedef unsigned char BYTE;
+typedef BYTE byte;
+typedef uint32_t DWORD;
+typedef unsigned long long DWORD64;
+typedef int BOOL;
+#endif
+
+namespace Platform {
+    // 当前进程可执行文件所在的目录（服务端 exe 或 BegHost）
+    std::filesystem::path ExecutableDirectory();
+
+    // 宽字符串转为多字节字符串，超过 255 字节的部分被截断。实体的名称都是 ASCII
+    std::string Narrow(const wchar_t* text);
+}
\ No newline at end of file
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "MpscQueue.h"
+#include "EntityList.h"
+#include <memory>
+#include <string>
+#include <atomic>
+#include <cstdint>
+
+namespace BegeerteScript {
+
+    struct PlayerEvent {
+        enum class Kind : uint8_t { Join, Leave, FieldChanged };
+
+        Kind kind = Kind::Join;
+        uint8_t field = 0; // FieldChanged only, index into the watched field table
+        int old_value = 0;
+        int new_value = 0;
+        EntityList::Player* player = nullptr;
+    };
+
+    // Turns consecutive EntityList::Update results into join, leave and field change events.
+    // Each subscribed script gets its own queue, filled by whichever thread ran the update and drained by
+    // the script's coroutine, which the publisher wakes only when it queued something for it.
+    namespace PlayerEvents {
+        constexpr uint64_t AllFields = ~0ULL;
+
+        struct Subscription {
+            explicit Subscription(size_t capacity) : queue(capacity) {}
+
+            MpscQueue<PlayerEvent> queue;
+            uint64_t coroutine = 0;             // Woken when events are queued
+            std::atomic<bool> joins{ false };
+            std::atomic<bool> leaves{ false };
+            std::atomic<uint64_t> fields{ 0 };  // Bit per watched field index
+            uint64_t reported_drops = 0;        // Consumer only
+        };
+
+        // Installs the EntityList update callback. Players present at the time count as joined.
+        void Init();
+
+        // Queues a join event for every player already present, then delivers events as they happen
+        void Subscribe(const std::shared_ptr<Subscription>& subscription);
+        void Unsubscribe(const Subscription* subscription);
+
+        // Diffs the entity list against the previous update; called after every EntityList::Update
+        void Observe();
+
+        // Field names match the Player_Get* natives, e.g. "Health" or "GrowthStage"; -1 if unknown
+        int FieldIndex(const std::string& name);
+        const char* FieldName(int index);
+        int FieldCount();
+    }
+
+} // namespace BegeerteScript
\ No newline at end of file
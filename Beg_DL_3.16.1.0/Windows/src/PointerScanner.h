@@ -1,8 +1,12 @@
-#pragma once
-#include <Windows.h>
-#include <vector>
-#include <utility>
-
-namespace PointerScanner {
-    std::pair<DWORD64, bool> Scan(DWORD64 baseAddress, const std::vector<DWORD64>& offsets, std::vector<std::pair<DWORD64, bool>>& debugSteps);
+#pragma once
+#include "Platform.h"
+#include <vector>
+#include <utility>
+
+namespace PointerScanner {
+    std::pair<DWORD64, bool> Scan(DWORD64 baseAddress, const std::vector<DWORD64>& offsets, std::vector<std::pair<DWORD64, bool>>& debugSteps);
+
+    // 读取单个值，地址不可读时返回 false；不调用 VirtualQuery，适合每次更新都要重复的检查
+    bool ReadPointer(DWORD64 address, DWORD64& value);
+    bool ReadByte(DWORD64 address, BYTE& value);
 }
\ No newline at end of file
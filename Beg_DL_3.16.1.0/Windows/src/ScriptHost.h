@@ -0,0 +1,14 @@
+#pragma once
+
+namespace BegeerteScript {
+
+    // [Host] OutOfProcess=1 moves the scripts into BegHost.exe. The plugin then only publishes the entity
+    // list to a SnapshotChannel after every server tick and applies the writes the host sends back, so a
+    // crashing or runaway script costs the server nothing but the host process.
+    namespace ScriptHost {
+        // Starts publishing and, with [Host] AutoStart, launches BegHost and restarts it whenever it exits or
+        // hangs. Returns false when out-of-process mode is off or unavailable; the scripts then run in-process.
+        bool Start();
+    }
+
+} // namespace BegeerteScript
\ No newline at end of file
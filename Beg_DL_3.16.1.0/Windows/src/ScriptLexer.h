@@ -0,0 +1,22 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+// Tokenizer shared by the interpreter and the BegLint tool. Has no dependency on the game or Windows.
+namespace BegeerteScript {
+
+    struct Token {
+        enum class Type { IDENTIFIER, NUMBER, STRING, OPERATOR, KEYWORD, END_OF_LINE, UNKNOWN, END_OF_FILE };
+        Type type;
+        std::string text;
+        size_t line_number = 0; // For error reporting
+    };
+
+    namespace Lexer {
+        // Throws std::runtime_error (after printing the location) on malformed input
+        std::vector<Token> Tokenize(const std::string& script_content, const std::string& script_path);
+    }
+
+} // namespace BegeerteScript
\ No newline at end of file
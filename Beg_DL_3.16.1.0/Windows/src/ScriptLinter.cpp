@@ -0,0 +1,267 @@
+#include "ScriptLinter.h"
+#include <map>
+#include <set>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+
+namespace BegeerteScript::Linter {
+
+    // Rough per-call costs measured on a dedicated server, in microseconds
+    static double NativeCost(const std::string& name) {
+        static const std::map<std::string, double> costs = {
+            { "EntityList_Update", 20.0 },          // Prefix chain once, then a slot read + valid flag check per TArray element
+            { "EntityList_GetPlayer", 0.5 },        // VirtualQuery
+            { "EntityList_GetEntity", 0.05 },
+            { "EntityList_GetMaxPlayers", 0.05 },
+            { "EntityList_GetAllEntities", 0.05 },
+            { "Player_GetCharacter", 0.3 },         // wcstombs_s
+            { "Player_GetGrowthStage", 0.3 },       // wcstombs_s
+            { "print", 20.0 },                      // Console I/O
+            { "printf", 20.0 },
+            { "LogToFile", 1.0 },                   // Appends to the log buffer under a mutex; the disk write happens elsewhere
+        };
+        auto it = costs.find(name);
+        if (it != costs.end()) return it->second;
+        if (name.size() > 5 && name.compare(name.size() - 5, 5, "Grade") == 0) return 0.3; // wcstombs_s
+        if (name.rfind("Player_", 0) == 0) return 0.05;
+        return 1.0; // Script functions and anything unknown
+    }
+
+    // Natives that only read state, so repeating them with the same arguments is wasted work
+    static bool IsReadOnlyNative(const std::string& name) {
+        return name.find("_Get") != std::string::npos || name.find("_Is") != std::string::npos;
+    }
+
+    static constexpr double AssumedPlayers = 100.0;   // Trip count assumed for per-player loops
+    static constexpr double StringConcatCost = 0.2;   // One heap allocation + copy
+
+    struct Call {
+        size_t index;
+        size_t line_number;
+        std::string name;
+        std::string args; // Argument tokens joined, used to spot identical calls
+        std::vector<std::string> arguments; // The same, split into top-level arguments
+    };
+
+    // Calls that give the CPU back to the server. channel_recv only waits when it is given a timeout, await
+    // unless its timeout is 0.
+    static bool IsPauseCall(const Call& call) {
+        if (call.name == "channel_recv") {
+            return call.arguments.size() == 2 && call.arguments[1] != "0";
+        }
+        if (call.name == "await") {
+            return call.arguments.size() != 2 || call.arguments[1] != "0";
+        }
+        return call.name == "wait" || call.name == "yield" || call.name == "wait_ticks";
+    }
+
+    struct Loop {
+        size_t line_number;
+        size_t body_begin;  // First token of the body
+        size_t body_end;    // One past the last token of the body
+        bool constant_true; // while (true) / while (1)
+        int parent = -1;
+        std::vector<size_t> direct_calls; // Calls in this body but not in a nested loop
+        bool per_player = false;
+    };
+
+    static bool IsOperator(const Token& token, const char* text) {
+        return token.type == Token::Type::OPERATOR && token.text == text;
+    }
+
+    // Index of the token matching the opener at 'open' (one past the end if unterminated)
+    static size_t FindMatching(const std::vector<Token>& tokens, size_t open, const char* opener, const char* closer) {
+        int level = 0;
+        for (size_t i = open; i < tokens.size(); ++i) {
+            if (IsOperator(tokens[i], opener)) level++;
+            else if (IsOperator(tokens[i], closer) && --level == 0) return i;
+        }
+        return tokens.size();
+    }
+
+    static std::vector<Loop> FindLoops(const std::vector<Token>& tokens) {
+        std::vector<Loop> loops;
+        for (size_t i = 0; i < tokens.size(); ++i) {
+            if (tokens[i].type != Token::Type::KEYWORD || (tokens[i].text != "while" && tokens[i].text != "for")) continue;
+            if (i + 1 >= tokens.size() || !IsOperator(tokens[i + 1], "(")) continue;
+
+            size_t cond_end = FindMatching(tokens, i + 1, "(", ")");
+            if (cond_end >= tokens.size()) continue;
+
+            Loop loop;
+            loop.line_number = tokens[i].line_number;
+            loop.per_player = tokens[i].text == "for"; // 'for' only iterates Players()
+            loop.constant_true = cond_end == i + 3 &&
+                ((tokens[i + 2].type == Token::Type::KEYWORD && tokens[i + 2].text == "true") ||
+                    (tokens[i + 2].type == Token::Type::NUMBER && tokens[i + 2].text != "0"));
+
+            size_t body = cond_end + 1;
+            if (body < tokens.size() && IsOperator(tokens[body], "{")) {
+                loop.body_begin = body + 1;
+                loop.body_end = FindMatching(tokens, body, "{", "}");
+            }
+            else {
+                loop.body_begin = body;
+                loop.body_end = body;
+                while (loop.body_end < tokens.size() && tokens[loop.body_end].type != Token::Type::END_OF_LINE &&
+                    tokens[loop.body_end].type != Token::Type::END_OF_FILE) {
+                    loop.body_end++;
+                }
+            }
+            loops.push_back(loop);
+        }
+
+        // Innermost enclosing loop; loops are in source order so the last match is the innermost
+        for (size_t i = 0; i < loops.size(); ++i) {
+            for (size_t j = 0; j < i; ++j) {
+                if (loops[i].body_begin > loops[j].body_begin && loops[i].body_end <= loops[j].body_end) {
+                    loops[i].parent = static_cast<int>(j);
+                }
+            }
+        }
+        return loops;
+    }
+
+    static std::vector<Call> FindCalls(const std::vector<Token>& tokens) {
+        std::vector<Call> calls;
+        for (size_t i = 0; i + 1 < tokens.size(); ++i) {
+            if (tokens[i].type != Token::Type::IDENTIFIER || !IsOperator(tokens[i + 1], "(")) continue;
+            if (i > 0 && tokens[i - 1].type == Token::Type::KEYWORD && tokens[i - 1].text == "function") continue;
+
+            Call call{ i, tokens[i].line_number, tokens[i].text, "", {} };
+            size_t close = FindMatching(tokens, i + 1, "(", ")");
+            int level = 0;
+            for (size_t j = i + 2; j < close && j < tokens.size(); ++j) {
+                call.args += tokens[j].text;
+                call.args += ' ';
+                if (IsOperator(tokens[j], "(")) level++;
+                else if (IsOperator(tokens[j], ")")) level--;
+                if (level == 0 && IsOperator(tokens[j], ",")) {
+                    call.arguments.emplace_back();
+                    continue;
+                }
+                if (call.arguments.empty()) call.arguments.emplace_back();
+                call.arguments.back() += call.arguments.back().empty() ? tokens[j].text : " " + tokens[j].text;
+            }
+            calls.push_back(call);
+        }
+        return calls;
+    }
+
+    // Innermost loop whose body holds token 'index', or -1
+    static int InnermostLoop(const std::vector<Loop>& loops, size_t index) {
+        int innermost = -1;
+        for (size_t i = 0; i < loops.size(); ++i) {
+            if (index >= loops[i].body_begin && index < loops[i].body_end) {
+                innermost = static_cast<int>(i); // Later loops are nested deeper
+            }
+        }
+        return innermost;
+    }
+
+    static bool HasEnclosing(const std::vector<Loop>& loops, int loop, bool (*predicate)(const Loop&)) {
+        for (int i = loop; i >= 0; i = loops[i].parent) {
+            if (predicate(loops[i])) return true;
+        }
+        return false;
+    }
+
+    // Estimated cost of one iteration, including nested loops
+    static double LoopCost(const std::vector<Loop>& loops, const std::vector<Call>& calls, size_t loop) {
+        double cost = 0;
+        for (size_t call : loops[loop].direct_calls) {
+            cost += NativeCost(calls[call].name);
+        }
+        for (size_t i = 0; i < loops.size(); ++i) {
+            if (loops[i].parent == static_cast<int>(loop)) {
+                cost += LoopCost(loops, calls, i) * (loops[i].per_player ? AssumedPlayers : 1.0);
+            }
+        }
+        return cost;
+    }
+
+    std::vector<Finding> Lint(const std::vector<Token>& tokens) {
+        std::vector<Finding> findings;
+        std::vector<Loop> loops = FindLoops(tokens);
+        std::vector<Call> calls = FindCalls(tokens);
+
+        for (size_t i = 0; i < calls.size(); ++i) {
+            int loop = InnermostLoop(loops, calls[i].index);
+            if (loop >= 0) loops[loop].direct_calls.push_back(i);
+        }
+        for (auto& loop : loops) {
+            for (size_t call : loop.direct_calls) {
+                if (calls[call].name == "EntityList_GetEntity" || calls[call].name == "EntityList_GetPlayer") {
+                    loop.per_player = true;
+                }
+            }
+        }
+
+        // busy-loop: unbounded loop that never pauses
+        for (size_t i = 0; i < loops.size(); ++i) {
+            if (!loops[i].constant_true) continue;
+            bool pauses = std::any_of(calls.begin(), calls.end(), [&](const Call& call) {
+                return call.index >= loops[i].body_begin && call.index < loops[i].body_end && IsPauseCall(call);
+                });
+            if (pauses) continue;
+            findings.push_back({ loops[i].line_number, "busy-loop",
+                "Unbounded loop has no pause call; it re-runs as fast as the CPU allows. Add wait(ms) or wait_ticks(n).",
+                LoopCost(loops, calls, i) });
+        }
+
+        // update-in-player-loop: full entity rescan once per player
+        for (size_t i = 0; i < calls.size(); ++i) {
+            if (calls[i].name != "EntityList_Update") continue;
+            int loop = InnermostLoop(loops, calls[i].index);
+            if (loop < 0 || !HasEnclosing(loops, loop, [](const Loop& l) { return l.per_player; })) continue;
+            findings.push_back({ calls[i].line_number, "update-in-player-loop",
+                "EntityList_Update() inside a per-player loop re-checks every entity once per player; call it once before the loop.",
+                NativeCost("EntityList_Update") * AssumedPlayers });
+        }
+
+        // repeated-call: same read-only native with the same arguments twice in one loop body
+        for (const auto& loop : loops) {
+            std::map<std::string, std::vector<size_t>> groups;
+            for (size_t call : loop.direct_calls) {
+                if (IsReadOnlyNative(calls[call].name)) {
+                    groups[calls[call].name + "(" + calls[call].args + ")"].push_back(call);
+                }
+            }
+            for (const auto& group : groups) {
+                if (group.second.size() < 2) continue;
+                const Call& first = calls[group.second.front()];
+                findings.push_back({ first.line_number, "repeated-call",
+                    first.name + "() is called " + std::to_string(group.second.size()) +
+                    " times with the same arguments in one loop body; store the result in a variable.",
+                    NativeCost(first.name) * static_cast<double>(group.second.size() - 1) });
+            }
+        }
+
+        // string-concat: building strings in a hot loop (unbounded or per-player)
+        std::set<size_t> concat_lines;
+        for (size_t i = 1; i + 1 < tokens.size(); ++i) {
+            if (!IsOperator(tokens[i], "+")) continue;
+            if (tokens[i - 1].type != Token::Type::STRING && tokens[i + 1].type != Token::Type::STRING) continue;
+            int loop = InnermostLoop(loops, i);
+            if (loop < 0 || !HasEnclosing(loops, loop, [](const Loop& l) { return l.constant_true || l.per_player; })) continue;
+            if (!concat_lines.insert(tokens[i].line_number).second) continue;
+            findings.push_back({ tokens[i].line_number, "string-concat",
+                "String concatenation in a hot loop allocates on every iteration; build the string only when it is used.",
+                StringConcatCost });
+        }
+
+        std::sort(findings.begin(), findings.end(), [](const Finding& a, const Finding& b) {
+            return a.line_number < b.line_number;
+            });
+        return findings;
+    }
+
+    std::string Format(const std::string& script_path, const Finding& finding) {
+        std::ostringstream oss;
+        oss << script_path << "(" << finding.line_number << "): [" << finding.rule << "] " << finding.message
+            << " (est. ~" << std::fixed << std::setprecision(finding.cost_us < 10 ? 2 : 0) << finding.cost_us << " us per iteration)";
+        return oss.str();
+    }
+
+} // namespace BegeerteScript::Linter
\ No newline at end of file
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "ScriptLexer.h"
+#include <string>
+#include <vector>
+
+// Static performance checks for .beg scripts. Runs on the token stream only, so it is used both
+// when scripts are loaded and by the standalone BegLint tool.
+namespace BegeerteScript::Linter {
+
+    struct Finding {
+        size_t line_number = 0;
+        std::string rule;    // Short rule id, e.g. "busy-loop"
+        std::string message;
+        double cost_us = 0;  // Rough cost estimate in microseconds per iteration of the enclosing loop
+    };
+
+    std::vector<Finding> Lint(const std::vector<Token>& tokens);
+
+    // "path(line): [rule] message (est. ~N us per iteration)"
+    std::string Format(const std::string& script_path, const Finding& finding);
+
+} // namespace BegeerteScript::Linter
\ No newline at end of file
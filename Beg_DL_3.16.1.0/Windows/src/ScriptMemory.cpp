@@ -0,0 +1,94 @@
+#include "ScriptMemory.h"
+#include <string>
+
+namespace BegeerteScript {
+
+    ScriptMemory::ScriptMemory(size_t limit_bytes)
+        : capped(limit_bytes), long_lived(&capped), scratch(&capped) {
+    }
+
+    // --- CappedResource ---
+    void ScriptMemory::CappedResource::Charge(long long bytes) {
+        if (bytes < 0) {
+            size_t release = static_cast<size_t>(-bytes);
+            used = release > used ? 0 : used - release;
+            return;
+        }
+        if (used + static_cast<size_t>(bytes) > limit) {
+            throw ScriptMemoryError("Script memory limit exceeded (" + std::to_string(limit / 1024) + " KB).");
+        }
+        used += static_cast<size_t>(bytes);
+        if (used > peak) peak = used;
+    }
+
+    void* ScriptMemory::CappedResource::do_allocate(size_t bytes, size_t alignment) {
+        Charge(static_cast<long long>(bytes)); // Throws before touching the heap if over the cap
+        try {
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+        catch (...) {
+            Charge(-static_cast<long long>(bytes));
+            throw;
+        }
+    }
+
+    void ScriptMemory::CappedResource::do_deallocate(void* p, size_t bytes, size_t alignment) {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+        Charge(-static_cast<long long>(bytes));
+    }
+
+    // --- ScratchResource ---
+    ScriptMemory::ScratchResource::~ScratchResource() {
+        for (const auto& chunk : chunks) {
+            upstream->deallocate(chunk.data, chunk.size, alignof(std::max_align_t));
+        }
+    }
+
+    void* ScriptMemory::ScratchResource::do_allocate(size_t bytes, size_t alignment) {
+        while (current < chunks.size()) {
+            Chunk& chunk = chunks[current];
+            size_t aligned = (cursor + alignment - 1) & ~(alignment - 1);
+            if (aligned + bytes <= chunk.size) {
+                cursor = aligned + bytes;
+                live++;
+                return chunk.data + aligned;
+            }
+            // Move on to the next retained chunk, if any
+            current++;
+            cursor = 0;
+        }
+
+        // Oversized requests get a chunk of their own
+        size_t size = bytes + alignment > ChunkSize ? bytes + alignment : ChunkSize;
+        Chunk chunk{ static_cast<std::byte*>(upstream->allocate(size, alignof(std::max_align_t))), size };
+        chunks.push_back(chunk);
+        current = chunks.size() - 1;
+        size_t aligned = (reinterpret_cast<uintptr_t>(chunk.data) % alignment) == 0 ? 0 :
+            alignment - (reinterpret_cast<uintptr_t>(chunk.data) % alignment);
+        cursor = aligned + bytes;
+        live++;
+        return chunk.data + aligned;
+    }
+
+    void ScriptMemory::ScratchResource::do_deallocate(void* p, size_t bytes, size_t alignment) {
+        if (live > 0) live--;
+        // Most argument lists die in reverse order of creation, so LIFO frees reclaim space immediately
+        if (current < chunks.size() && static_cast<std::byte*>(p) + bytes == chunks[current].data + cursor) {
+            cursor = static_cast<size_t>(static_cast<std::byte*>(p) - chunks[current].data);
+        }
+    }
+
+    void ScriptMemory::ScratchResource::ResetIfIdle() {
+        if (live != 0 || chunks.empty()) {
+            return;
+        }
+        // Keep the first chunk for reuse, hand the rest back to the cap
+        for (size_t i = 1; i < chunks.size(); ++i) {
+            upstream->deallocate(chunks[i].data, chunks[i].size, alignof(std::max_align_t));
+        }
+        chunks.resize(1);
+        current = 0;
+        cursor = 0;
+    }
+
+} // namespace BegeerteScript
\ No newline at end of file
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <memory_resource>
+#include <stdexcept>
+#include <vector>
+#include <cstddef>
+
+namespace BegeerteScript {
+
+    // Thrown when a script goes over its memory cap. Not swallowed by native calls; the script is unloaded.
+    class ScriptMemoryError : public std::runtime_error {
+    public:
+        using std::runtime_error::runtime_error;
+    };
+
+    // Per-script memory owned by a ScriptContext, kept off the game server's heap as far as possible.
+    // - LongLived(): pooled region for globals and local frames, lives as long as the script
+    // - Scratch():   bump region for argument lists, rewound at loop back-edges and ticks
+    // Both regions and any charged string payloads count against a single cap.
+    class ScriptMemory {
+    public:
+        static constexpr size_t DefaultLimit = 16 * 1024 * 1024;
+
+        explicit ScriptMemory(size_t limit_bytes = DefaultLimit);
+        ScriptMemory(const ScriptMemory&) = delete;
+        ScriptMemory& operator=(const ScriptMemory&) = delete;
+
+        std::pmr::memory_resource* LongLived() { return &long_lived; }
+        std::pmr::memory_resource* Scratch() { return &scratch; }
+
+        // Rewinds the scratch region, but only while nothing allocated from it is still alive
+        void ResetScratch() { scratch.ResetIfIdle(); }
+
+        // Accounts memory held outside the arenas (e.g. std::string payloads of globals). Negative releases.
+        void Charge(long long bytes) { capped.Charge(bytes); }
+
+        size_t Used() const { return capped.Used(); }
+        size_t Peak() const { return capped.Peak(); }
+        size_t Limit() const { return capped.Limit(); }
+
+    private:
+        // Upstream for both regions: counts every byte and enforces the cap
+        class CappedResource : public std::pmr::memory_resource {
+        public:
+            explicit CappedResource(size_t limit_bytes) : limit(limit_bytes) {}
+            void Charge(long long bytes);
+            size_t Used() const { return used; }
+            size_t Peak() const { return peak; }
+            size_t Limit() const { return limit; }
+
+        private:
+            void* do_allocate(size_t bytes, size_t alignment) override;
+            void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+            bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+            size_t limit;
+            size_t used = 0;
+            size_t peak = 0;
+        };
+
+        // Bump allocator. Frees are only counted (LIFO frees also rewind the cursor);
+        // the whole region is rewound once the live count drops to zero.
+        class ScratchResource : public std::pmr::memory_resource {
+        public:
+            explicit ScratchResource(std::pmr::memory_resource* upstream_resource) : upstream(upstream_resource) {}
+            ~ScratchResource();
+            void ResetIfIdle();
+
+        private:
+            struct Chunk {
+                std::byte* data;
+                size_t size;
+            };
+            static constexpr size_t ChunkSize = 16 * 1024;
+
+            void* do_allocate(size_t bytes, size_t alignment) override;
+            void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+            bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+            std::pmr::memory_resource* upstream;
+            std::vector<Chunk> chunks;
+            size_t current = 0;  // Chunk the cursor is in
+            size_t cursor = 0;   // Offset inside chunks[current]
+            size_t live = 0;     // Allocations not yet freed
+        };
+
+        CappedResource capped;
+        std::pmr::unsynchronized_pool_resource long_lived;
+        ScratchResource scratch;
+    };
+
+} // namespace BegeerteScript
\ No newline at end of file
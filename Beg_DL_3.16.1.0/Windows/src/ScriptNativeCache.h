@@ -0,0 +1,35 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+
+namespace BegeerteScript {
+
+    // How far the result of a native can be reused. Set when the native is registered.
+    enum class NativeKind {
+        Volatile,   // Always called (default)
+        Pure,       // Depends only on its arguments; cached for the life of the script
+        TickStable, // Same answer until EntityList::Update runs or a setter of its group is called
+        Mutating,   // Writes game memory; drops cached results of its group in every script
+    };
+
+    struct NativeTraits {
+        NativeKind kind = NativeKind::Volatile;
+        int group = -1; // Field shared by getters and their setter (e.g. "Health"), -1 for none
+
+        static NativeTraits Volatile() { return {}; }
+        static NativeTraits Pure() { return { NativeKind::Pure, -1 }; }
+        static NativeTraits TickStable(const std::string& group = "");
+        static NativeTraits Mutating(const std::string& group);
+
+        bool Cacheable() const { return kind == NativeKind::Pure || kind == NativeKind::TickStable; }
+    };
+
+    // Process-wide version counter per group, so a setter in one script invalidates every script's cache
+    namespace NativeGroups {
+        int Id(const std::string& group); // -1 for an empty name
+        uint32_t Version(int group);
+        void Invalidate(int group);
+    }
+
+} // namespace BegeerteScript
\ No newline at end of file
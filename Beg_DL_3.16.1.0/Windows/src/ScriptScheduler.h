@@ -0,0 +1,173 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <ostream>
+#include <cstdint>
+
+namespace BegeerteScript {
+
+    // Runs scripts as stackful coroutines on a small fixed set of threads instead of one OS thread each.
+    // Coroutines are Windows fibers (ucontext elsewhere, so the scheduler can be tested without the game).
+    // A coroutine stays on the worker it was spawned on, which keeps thread-local state valid across switches.
+    // Switching is cooperative: wait()/yield()/wait_ticks() suspend, and long-running loops give up the
+    // worker at their back-edges once their time slice is used up. A sleeping script costs no CPU.
+    class ScriptScheduler {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        enum class State { Ready, Running, Sleeping, Finished };
+
+        // Latency classes. Critical coroutines run before normal ones and normal ones before batch; within a
+        // class, earliest deadline first, where the deadline counts from when the coroutine became ready.
+        // Critical and normal may each use a share of every tick; a class past its share only runs when
+        // nothing within budget is ready. Batch has no share and soaks up whatever time is left.
+        enum class Priority { Critical, Normal, Batch };
+        // Why the scheduler is parked. Each owner sets and clears only its own reason, so one of them resuming
+        // does not end another's park.
+        enum class ParkReason : uint32_t { Idle = 1, Startup = 2, VirtualTimeLimit = 4 };
+        static constexpr size_t PriorityCount = 3;
+        static constexpr size_t LatenessBuckets = 8; // Late by <1, <2, <5, <10, <20, <50, <100, >=100 ms
+
+        struct ClassStats {
+            uint64_t runs = 0;   // Times a coroutine of the class was resumed
+            uint64_t missed = 0; // ... after its deadline had passed
+            uint64_t lateness[LatenessBuckets] = {};
+            double cpu_ms = 0;
+        };
+
+        struct CoroutineInfo {
+            uint64_t id;
+            std::string name;
+            State state;
+            Priority priority;
+            long long deadline_ms;
+            size_t worker;
+            long long wakes_in_ms; // Sleeping only, may be negative if overdue
+            uint64_t switches;     // Times the coroutine was resumed
+            uint64_t preempted;    // Times it was made to yield by its slice or instruction budget
+            double cpu_ms;         // Time spent running
+        };
+
+        struct Stats {
+            uint64_t tick;
+            std::vector<size_t> ready_per_worker;
+            std::vector<size_t> sleeping_per_worker;
+            std::vector<CoroutineInfo> coroutines;
+            ClassStats classes[PriorityCount];
+        };
+
+        // Starts 'worker_count' threads. 'tick' is the length of one wait_ticks() step.
+        ScriptScheduler(size_t worker_count, std::chrono::milliseconds tick, size_t stack_bytes);
+        ~ScriptScheduler();
+        ScriptScheduler(const ScriptScheduler&) = delete;
+        ScriptScheduler& operator=(const ScriptScheduler&) = delete;
+
+        // Scheduler shared by all scripts, configured from [Scripts] SchedulerThreads/TickMs/SliceMs/FiberStackKB
+        static ScriptScheduler& Shared();
+
+        // Queues 'body' as a new coroutine on the least loaded worker
+        uint64_t Spawn(const std::string& name, std::function<void()> body);
+
+        // Any thread. Ends the SleepUntilWoken of coroutine 'id'; false if it no longer exists.
+        bool Wake(uint64_t id);
+
+        // Any thread. Parks for 'reason' or clears it. While any reason is set no coroutine is resumed; wakeups
+        // that fall due in the meantime run once the last one is cleared. A coroutine that is running when
+        // parking starts finishes its slice first.
+        void Park(ParkReason reason, bool parked);
+        bool Parked() const { return parked.load(std::memory_order_relaxed) != 0; }
+
+        // --- Called from inside a coroutine. Outside one they block the calling thread for the script time left. ---
+        static void Sleep(std::chrono::milliseconds duration);
+        static void SleepUntil(Clock::time_point wake_time);
+        static void Yield();
+        static void SleepTicks(uint64_t ticks);
+        // Like SleepUntil, but Wake() ends it early. A Wake that arrives while the coroutine is still running
+        // makes its next SleepUntilWoken return at once, so no wakeup is lost.
+        static void SleepUntilWoken(Clock::time_point wake_time);
+
+        // Called at loop back-edges; yields when the running coroutine has used up its time slice.
+        // Returns true if it yielded.
+        static bool YieldIfSliceExpired();
+
+        // Makes the running coroutine yield although it did not ask to (e.g. its instruction budget ran out).
+        // Returns false outside a coroutine or while preemption is held.
+        static bool ForceYield();
+
+        // While held, the running coroutine is not forced to yield, as if it ran outside the scheduler.
+        // For code that holds a mutex other coroutines may wait on. Preemptible() is false outside coroutines too.
+        static void HoldPreemption(bool hold);
+        static bool Preemptible();
+
+        // Moves the running coroutine to 'priority'. 'deadline' of 0 uses the class default. False outside a coroutine.
+        static bool SetPriority(Priority priority, std::chrono::milliseconds deadline);
+        // "critical", "normal" or "batch"
+        static bool ParsePriority(const std::string& name, Priority& priority);
+        static const char* PriorityName(Priority priority);
+
+        // Number of times the running coroutine suspended itself through Sleep/Yield/SleepTicks, 0 outside one.
+        // Forced yields are not counted, so a change means the script paused voluntarily.
+        static uint64_t PauseCount();
+
+        // Script time: the real clock, or with [Scripts] VirtualTime=1 a simulated one that jumps straight to
+        // the next wakeup whenever nothing is ready to run. Wakeups, ticks and timers all use this clock;
+        // time slices and CPU accounting keep using the real one.
+        static Clock::time_point Now();
+        static bool VirtualTime() { return virtual_time.load(std::memory_order_relaxed); }
+
+        // True when the calling code runs inside a scheduler coroutine
+        static bool InCoroutine();
+
+        // Id of the running coroutine, 0 outside one
+        static uint64_t CurrentId();
+
+        uint64_t CurrentTick() const;
+        // Start of tick 'CurrentTick() + ticks', where SleepTicks(ticks) wakes up
+        Clock::time_point TickDeadline(uint64_t ticks) const;
+        // Script time since the scheduler was created
+        Clock::duration Elapsed() const { return Now() - start_time; }
+        size_t WorkerCount() const { return workers.size(); }
+
+        Stats Snapshot();
+        void Dump(std::ostream& out);
+
+        std::chrono::milliseconds slice{ 10 };
+        std::chrono::milliseconds default_deadline[PriorityCount]{ std::chrono::milliseconds(5), std::chrono::milliseconds(50), std::chrono::milliseconds(1000) };
+        int budget_percent[PriorityCount]{ 60, 30, 0 }; // Share of each tick, 0 = no cap
+
+    private:
+        struct Coroutine;
+        struct Worker;
+        static thread_local Worker* current_worker; // Worker owning the calling thread, if any
+        static std::atomic<bool> virtual_time;
+        static std::atomic<Clock::rep> virtual_now; // Since Clock's epoch, only advanced by the single worker
+
+        void WorkerMain(Worker& worker);
+        void MakeReady(Worker& worker, Coroutine* coroutine, Clock::time_point since);
+        Coroutine* PickReady(Worker& worker, Clock::time_point now);
+        Clock::duration DeadlineOf(const Coroutine& coroutine) const;
+        void Suspend(State state, Clock::time_point wake_time, bool forced = false, bool wakeable = false);
+        static void CoroutineEntry(Coroutine* coroutine);
+        static const char* StateName(State state);
+
+        std::vector<std::unique_ptr<Worker>> workers;
+        std::chrono::milliseconds tick_length;
+        Clock::time_point start_time;
+        size_t stack_size;
+        std::atomic<uint64_t> next_id{ 1 };
+        std::atomic<bool> stopping{ false };
+        std::atomic<uint32_t> parked{ 0 }; // ParkReason bits
+        Clock::duration virtual_limit{}; // Simulated time after which the scheduler parks itself, 0 for none
+        Clock::time_point virtual_started; // Real time the simulation started at
+    };
+
+} // namespace BegeerteScript
\ No newline at end of file
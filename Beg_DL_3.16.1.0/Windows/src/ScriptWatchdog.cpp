@@ -0,0 +1,77 @@
+#include "ScriptWatchdog.h"
+#include "plugins.h"
+#include "Config.h"
+#include <filesystem>
+#include <algorithm>
+
+namespace BegeerteScript {
+
+    WatchdogLimits WatchdogLimits::FromConfig(const std::string& script_name) {
+        WatchdogLimits defaults;
+        auto get = [&](const char* key, long long fallback) {
+            int global = Config::GetInt("Scripts", key, static_cast<int>(fallback));
+            return static_cast<long long>(Config::GetInt("Script:" + script_name, key, global));
+        };
+        WatchdogLimits limits;
+        limits.instruction_budget = static_cast<uint64_t>(std::max(get("InstructionBudget", static_cast<long long>(defaults.instruction_budget)), 1LL));
+        limits.strikes = static_cast<uint32_t>(std::max(get("WatchdogStrikes", defaults.strikes), 0LL));
+        limits.suspend_for = std::chrono::milliseconds(std::max(get("WatchdogSuspendMs", defaults.suspend_for.count()), 0LL));
+        limits.max_suspensions = static_cast<uint32_t>(std::max(get("WatchdogMaxSuspensions", defaults.max_suspensions), 0LL));
+        return limits;
+    }
+
+    void ScriptBudget::Overrun(const std::string& script_path, bool preempted) {
+        used = 0;
+        if (!ScriptScheduler::Preemptible()) {
+            return;
+        }
+
+        // Any wait()/yield() since the last check means the script does pause on its own
+        uint64_t pauses = ScriptScheduler::PauseCount();
+        if (pauses != seen_pauses) {
+            seen_pauses = pauses;
+            overruns = 0;
+            if (!preempted) {
+                return; // The budget was spread over several slices, nothing to do
+            }
+        }
+
+        if (!preempted) {
+            ScriptScheduler::ForceYield();
+        }
+        overruns++;
+        total_overruns++;
+        if (limits.strikes == 0 || overruns < limits.strikes) {
+            return;
+        }
+
+        std::string name = std::filesystem::path(script_path).filename().string();
+        std::string counts = std::to_string(overruns) + " overruns in a row, " + std::to_string(total_overruns) + " in total, " +
+            std::to_string(suspensions) + " suspension(s)";
+        if (suspensions >= limits.max_suspensions) {
+            std::string decision = "[BegeerteWatchdog] Unloading " + name + ": " + counts + ". Call wait() or yield() inside long loops.";
+            std::cerr << decision << std::endl;
+            Plugins::WriteScriptLog(decision);
+            throw ScriptWatchdogError("Unloaded by the watchdog after exceeding its budget " + std::to_string(total_overruns) + " times.");
+        }
+
+        suspensions++;
+        std::string decision = "[BegeerteWatchdog] Suspending " + name + " for " + std::to_string(limits.suspend_for.count()) +
+            " ms (" + std::to_string(suspensions) + "/" + std::to_string(limits.max_suspensions) + "): " + counts + ".";
+        std::cerr << decision << std::endl;
+        Plugins::WriteScriptLog(decision);
+        ScriptScheduler::Sleep(limits.suspend_for);
+        seen_pauses = ScriptScheduler::PauseCount(); // The suspension is not the script pausing on its own
+        overruns = 0;
+    }
+
+    void ScriptBudget::DeadlineMissed(const std::string& script_path) {
+        deadline = {};
+        std::string decision = "[BegeerteWatchdog] Stopping " + std::filesystem::path(script_path).filename().string() +
+            ": still running past its hard time limit where it cannot be preempted.";
+        std::cerr << decision << std::endl;
+        Plugins::WriteScriptLog(decision);
+        throw ScriptWatchdogError("Stopped by the watchdog after running past its hard time limit.");
+    }
+
+} // namespace BegeerteScript
\ No newline at end of file
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <string>
+#include <chrono>
+#include <stdexcept>
+#include <cstdint>
+#include "ScriptScheduler.h"
+
+namespace BegeerteScript {
+
+    // Thrown at a preemption point when the watchdog unloads a script. Not swallowed by native calls.
+    class ScriptWatchdogError : public std::runtime_error {
+    public:
+        using std::runtime_error::runtime_error;
+    };
+
+    struct WatchdogLimits {
+        uint64_t instruction_budget = 100000;             // Preemption points between two yields
+        uint32_t strikes = 200;                           // Overruns in a row before a suspension, 0 disables the watchdog
+        std::chrono::milliseconds suspend_for{ 5000 };
+        uint32_t max_suspensions = 3;                     // Suspensions before the next one unloads the script instead
+
+        // [Scripts] InstructionBudget/WatchdogStrikes/WatchdogSuspendMs/WatchdogMaxSuspensions,
+        // each overridable in [Script:<file>.beg]
+        static WatchdogLimits FromConfig(const std::string& script_name);
+    };
+
+    // Per-script budget, checked at the preemption points: loop back-edges and script function calls.
+    // A script that runs through its instruction budget or its scheduler time slice without pausing on its
+    // own is made to yield; that is an overrun. A script that keeps overrunning without ever calling
+    // wait()/yield() is suspended for a while and, if it still does not behave, unloaded.
+    // Only acts inside scheduler coroutines; 'parallel for' workers are bounded by their caller.
+    // Code that cannot be preempted at all, such as on_tick, sets a real-time deadline instead: past it the
+    // next preemption point throws ScriptWatchdogError.
+    class ScriptBudget {
+    public:
+        explicit ScriptBudget(WatchdogLimits limits = {}) : limits(limits) {}
+
+        void Checkpoint(const std::string& script_path) {
+            if (deadline != std::chrono::steady_clock::time_point() && std::chrono::steady_clock::now() >= deadline) {
+                DeadlineMissed(script_path);
+            }
+            bool preempted = ScriptScheduler::YieldIfSliceExpired();
+            if (preempted || ++used >= limits.instruction_budget) {
+                Overrun(script_path, preempted);
+            }
+        }
+
+        // A default time point clears the deadline
+        void SetDeadline(std::chrono::steady_clock::time_point deadline) { this->deadline = deadline; }
+        std::chrono::steady_clock::time_point Deadline() const { return deadline; }
+
+        const WatchdogLimits& Limits() const { return limits; }
+        uint64_t TotalOverruns() const { return total_overruns; }
+        uint32_t Suspensions() const { return suspensions; }
+
+    private:
+        void Overrun(const std::string& script_path, bool preempted);
+        void DeadlineMissed(const std::string& script_path);
+
+        WatchdogLimits limits;
+        uint64_t used = 0;           // Preemption points since the budget was last reset
+        uint64_t seen_pauses = 0;    // ScriptScheduler::PauseCount() when last checked
+        uint32_t overruns = 0;       // In a row, without a voluntary pause in between
+        uint64_t total_overruns = 0;
+        uint32_t suspensions = 0;
+        std::chrono::steady_clock::time_point deadline;
+    };
+
+} // namespace BegeerteScript
\ No newline at end of file
@@ -0,0 +1,132 @@
+#include "ServiceLoop.h"
+#include "ThreadPlacement.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+#include <algorithm>
+#include <stdio.h>
+
+namespace ServiceLoop {
+    using Clock = std::chrono::steady_clock;
+
+    struct Service {
+        ServiceId id = 0;
+        std::string name;
+        Clock::duration interval;
+        Callback callback;
+        Clock::time_point nextRun;
+        uint64_t runs = 0;
+        Clock::duration total{};
+        Clock::duration longest{};
+        Clock::duration last{};
+    };
+
+    static std::mutex mutex;
+    static std::condition_variable changed; // 服务增减、停止或某项服务运行结束
+    static std::vector<Service> services;
+    static ServiceId nextId = 1;
+    static ServiceId runningId = 0;
+    static std::thread::id serviceThreadId;
+    static bool running = false;
+    static std::thread serviceThread;
+
+    static Service* Find(ServiceId id) {
+        auto service = std::find_if(services.begin(), services.end(), [id](const Service& entry) { return entry.id == id; });
+        return service != services.end() ? &*service : nullptr;
+    }
+
+    static void ServiceThread() {
+        ThreadPlacement::Apply("Service");
+        std::unique_lock<std::mutex> lock(mutex);
+        serviceThreadId = std::this_thread::get_id();
+        while (running) {
+            auto next = std::min_element(services.begin(), services.end(),
+                [](const Service& a, const Service& b) { return a.nextRun < b.nextRun; });
+            if (next == services.end()) {
+                changed.wait(lock);
+                continue;
+            }
+            auto now = Clock::now();
+            if (next->nextRun > now) {
+                changed.wait_until(lock, next->nextRun);
+                continue; // 可能有新的服务或被注销，重新查找
+            }
+
+            ServiceId id = next->id;
+            Callback callback = next->callback;
+            runningId = id;
+            lock.unlock();
+            auto start = Clock::now();
+            callback();
+            auto elapsed = Clock::now() - start;
+            lock.lock();
+            runningId = 0;
+
+            if (Service* service = Find(id)) {
+                service->runs++;
+                service->total += elapsed;
+                service->last = elapsed;
+                service->longest = std::max(service->longest, elapsed);
+                // 落后超过一个间隔时不补跑，从现在重新计时
+                service->nextRun += service->interval;
+                if (service->nextRun < Clock::now()) {
+                    service->nextRun = Clock::now() + service->interval;
+                }
+            }
+            changed.notify_all();
+        }
+    }
+
+    void Start() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (running) {
+            return;
+        }
+        running = true;
+        serviceThread = std::thread(ServiceThread);
+    }
+
+    void Stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            running = false;
+        }
+        changed.notify_all();
+        if (serviceThread.joinable()) {
+            serviceThread.join();
+        }
+    }
+
+    ServiceId Register(const std::string& name, std::chrono::milliseconds interval, Callback callback) {
+        std::lock_guard<std::mutex> lock(mutex);
+        Service service;
+        service.id = nextId++;
+        service.name = name;
+        service.interval = std::max(Clock::duration(interval), Clock::duration(std::chrono::milliseconds(1)));
+        service.callback = std::move(callback);
+        service.nextRun = Clock::now() + service.interval;
+        services.push_back(std::move(service));
+        changed.notify_all();
+        return services.back().id;
+    }
+
+    void Unregister(ServiceId id) {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (std::this_thread::get_id() != serviceThreadId) {
+            changed.wait(lock, [id] { return runningId != id; });
+        }
+        std::erase_if(services, [id](const Service& service) { return service.id == id; });
+        changed.notify_all();
+    }
+
+    void Dump() {
+        std::lock_guard<std::mutex> lock(mutex);
+        printf("[Begeerte] %zu service(s) on the service thread\n", services.size());
+        for (const Service& service : services) {
+            auto ms = [](Clock::duration duration) { return std::chrono::duration<double, std::milli>(duration).count(); };
+            printf("  %-20s every %6.0f ms  ran %llux, avg %.3f ms, last %.3f ms, max %.3f ms\n", service.name.c_str(), ms(service.interval),
+                static_cast<unsigned long long>(service.runs), service.runs ? ms(service.total) / service.runs : 0.0, ms(service.last), ms(service.longest));
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,24 @@
+#pragma once
+#include <functional>
+#include <string>
+#include <chrono>
+#include <cstdint>
+
+// 插件的周期性后台工作共用一个线程：各项服务按自己的间隔注册，线程在两次到期之间休眠，
+// 没有到期的服务时不占用 CPU。每项服务的运行次数和耗时可以用 Dump 查看。
+namespace ServiceLoop {
+    using Callback = std::function<void()>;
+    using ServiceId = uint64_t;
+
+    void Start();
+    // 等待正在运行的服务结束后退出线程，已注册的服务保留
+    void Stop();
+
+    // 第一次在 interval 之后运行。回调在服务线程上执行，不应长时间阻塞
+    ServiceId Register(const std::string& name, std::chrono::milliseconds interval, Callback callback);
+    // 服务正在其他线程上运行时等待它结束；在回调内注销自身也可以
+    void Unregister(ServiceId id);
+
+    // 在控制台输出每项服务的间隔、运行次数和耗时
+    void Dump();
+}
\ No newline at end of file
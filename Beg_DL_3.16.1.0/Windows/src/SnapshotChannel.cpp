@@ -0,0 +1,200 @@
+#include "SnapshotChannel.h"
+#include <algorithm>
+#include <thread>
+#include <new>
+#include <cstring>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace BegeerteScript {
+
+    static constexpr uint32_t ChannelMagic = 0x53474542; // "BEGS"
+    static constexpr uint32_t ChannelVersion = 1;
+
+    struct SnapshotChannel::Layout {
+        std::atomic<uint32_t> magic; // Set last, so Open never maps a half-initialized region
+        uint32_t version;
+        uint32_t entity_bytes;
+        uint32_t max_entities;
+
+        alignas(64) std::atomic<uint64_t> sequence; // Odd while the server is writing a snapshot
+        std::atomic<uint32_t> count;
+        alignas(64) std::atomic<uint64_t> heartbeat;
+        alignas(64) std::atomic<uint32_t> write_head; // Only the host advances it
+        alignas(64) std::atomic<uint32_t> write_tail; // Only the server advances it
+
+        Write writes[WriteCapacity];
+        Entity entities[MaxEntities];
+    };
+
+    static_assert((SnapshotChannel::WriteCapacity & (SnapshotChannel::WriteCapacity - 1)) == 0, "WriteCapacity must be a power of two");
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "The channel needs address-free atomics");
+
+    std::unique_ptr<SnapshotChannel> SnapshotChannel::Map(const std::string& name, bool create) {
+        const size_t size = sizeof(Layout);
+        void* view = nullptr;
+        std::unique_ptr<SnapshotChannel> channel(new SnapshotChannel());
+        channel->name = name;
+        channel->owner = create;
+#ifdef _WIN32
+        std::string object = "Local\\" + name;
+        HANDLE mapping = create ?
+            CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, static_cast<DWORD>(static_cast<uint64_t>(size) >> 32), static_cast<DWORD>(size), object.c_str()) :
+            OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, object.c_str());
+        if (!mapping) {
+            return nullptr;
+        }
+        view = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+        if (!view) {
+            CloseHandle(mapping);
+            return nullptr;
+        }
+        channel->mapping = mapping;
+#else
+        std::string object = "/" + name;
+        int fd = shm_open(object.c_str(), create ? O_CREAT | O_RDWR : O_RDWR, 0600);
+        if (fd < 0) {
+            return nullptr;
+        }
+        struct stat info = {};
+        if ((create && ftruncate(fd, static_cast<off_t>(size)) != 0) || fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < size) {
+            close(fd);
+            return nullptr;
+        }
+        view = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (view == MAP_FAILED) {
+            return nullptr;
+        }
+#endif
+        channel->layout = static_cast<Layout*>(view);
+        return channel;
+    }
+
+    std::unique_ptr<SnapshotChannel> SnapshotChannel::Create(const std::string& name) {
+        std::unique_ptr<SnapshotChannel> channel = Map(name, true);
+        if (!channel) {
+            return nullptr;
+        }
+        Layout* layout = channel->layout;
+        if (layout->magic.load(std::memory_order_acquire) != ChannelMagic || layout->version != ChannelVersion) {
+            new (layout) Layout(); // Fresh or left by an incompatible build
+        }
+        else {
+            // Left by an earlier server run. A host that is still attached keeps working: the sequence keeps
+            // counting, and writes it queued for the old server are skipped.
+            layout->magic.store(0, std::memory_order_relaxed);
+            uint64_t sequence = layout->sequence.load(std::memory_order_relaxed);
+            layout->sequence.store((sequence + 1) & ~1ull, std::memory_order_relaxed);
+            layout->write_tail.store(layout->write_head.load(std::memory_order_acquire), std::memory_order_relaxed);
+        }
+        layout->version = ChannelVersion;
+        layout->entity_bytes = EntityBytes;
+        layout->max_entities = MaxEntities;
+        layout->count.store(0, std::memory_order_relaxed);
+        layout->magic.store(ChannelMagic, std::memory_order_release);
+        return channel;
+    }
+
+    std::unique_ptr<SnapshotChannel> SnapshotChannel::Open(const std::string& name) {
+        std::unique_ptr<SnapshotChannel> channel = Map(name, false);
+        if (!channel) {
+            return nullptr;
+        }
+        const Layout* layout = channel->layout;
+        if (layout->magic.load(std::memory_order_acquire) != ChannelMagic || layout->version != ChannelVersion ||
+            layout->entity_bytes != EntityBytes || layout->max_entities != MaxEntities) {
+            return nullptr; // Not created yet, or by a server built from different sources
+        }
+        return channel;
+    }
+
+    SnapshotChannel::~SnapshotChannel() {
+        if (!layout) {
+            return;
+        }
+#ifdef _WIN32
+        UnmapViewOfFile(layout);
+        CloseHandle(static_cast<HANDLE>(mapping));
+#else
+        munmap(layout, sizeof(Layout));
+        if (owner) {
+            shm_unlink(("/" + name).c_str()); // POSIX objects outlive their processes, Windows ones do not
+        }
+#endif
+    }
+
+    SnapshotChannel::Entity* SnapshotChannel::BeginPublish() {
+        uint64_t sequence = layout->sequence.load(std::memory_order_relaxed);
+        layout->sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        return layout->entities;
+    }
+
+    void SnapshotChannel::EndPublish(uint32_t count) {
+        layout->count.store(std::min(count, MaxEntities), std::memory_order_relaxed);
+        layout->sequence.store(layout->sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    bool SnapshotChannel::Read(std::vector<Entity>& entities, uint64_t& seen) const {
+        for (int attempt = 0; attempt < 16; ++attempt) {
+            uint64_t before = layout->sequence.load(std::memory_order_acquire);
+            if (before == seen) {
+                return false;
+            }
+            if (before & 1) {
+                std::this_thread::yield(); // The server is in the middle of a publish
+                continue;
+            }
+            uint32_t count = std::min(layout->count.load(std::memory_order_relaxed), MaxEntities);
+            entities.resize(count);
+            std::memcpy(entities.data(), layout->entities, count * sizeof(Entity));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (layout->sequence.load(std::memory_order_relaxed) == before) {
+                seen = before;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    uint64_t SnapshotChannel::Sequence() const {
+        return layout->sequence.load(std::memory_order_acquire);
+    }
+
+    bool SnapshotChannel::PushWrite(const Write& write) {
+        uint32_t head = layout->write_head.load(std::memory_order_relaxed);
+        if (head - layout->write_tail.load(std::memory_order_acquire) >= WriteCapacity) {
+            return false;
+        }
+        layout->writes[head & (WriteCapacity - 1)] = write;
+        layout->write_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool SnapshotChannel::PopWrite(Write& write) {
+        uint32_t tail = layout->write_tail.load(std::memory_order_relaxed);
+        if (tail == layout->write_head.load(std::memory_order_acquire)) {
+            return false;
+        }
+        write = layout->writes[tail & (WriteCapacity - 1)];
+        layout->write_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    void SnapshotChannel::Heartbeat() {
+        layout->heartbeat.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    uint64_t SnapshotChannel::HostHeartbeat() const {
+        return layout->heartbeat.load(std::memory_order_relaxed);
+    }
+
+} // namespace BegeerteScript
\ No newline at end of file
@@ -0,0 +1,73 @@
+#pragma once
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace BegeerteScript {
+
+    // Shared-memory link between the plugin inside the server and an out-of-process script host (BegHost).
+    // The server publishes the entity list under a seqlock, so it never waits for the host; the host copies
+    // snapshots out and queues the bytes its scripts wrote in a ring the server drains on the game thread.
+    // Only plain data crosses the boundary, so the host can be restarted at any time.
+    class SnapshotChannel {
+    public:
+        static constexpr uint32_t MaxEntities = 512;      // Every slot EntityList::Update can find
+        static constexpr uint32_t EntityBytes = 0x800;    // Room for EntityList::Player, checked where both are known
+        static constexpr uint32_t WriteCapacity = 4096;   // Power of two
+
+        struct Entity {
+            uint64_t address; // Address in the server process, identifies the entity in writes
+            uint8_t bytes[EntityBytes];
+        };
+
+        struct Write {
+            uint64_t address; // Entity the script wrote to; dropped if the slot holds another one by now
+            uint32_t slot;    // Index in the snapshot the write was made against
+            uint16_t offset;
+            uint8_t value;
+        };
+
+        // Server side: creates the region, or takes over the one a previous server run left behind
+        static std::unique_ptr<SnapshotChannel> Create(const std::string& name);
+        // Host side: nullptr while no server has created it
+        static std::unique_ptr<SnapshotChannel> Open(const std::string& name);
+        ~SnapshotChannel();
+
+        // Server side, one thread. Between the two calls entities can be filled in place.
+        Entity* BeginPublish();
+        void EndPublish(uint32_t count);
+
+        // Host side: copies the latest snapshot if it differs from 'seen' and updates 'seen'. Returns false
+        // when nothing new was published, or the server kept rewriting it during every attempt.
+        bool Read(std::vector<Entity>& entities, uint64_t& seen) const;
+        // Changes with every publish; cheap enough to poll
+        uint64_t Sequence() const;
+
+        // Host side; false when the ring is full and the write was dropped
+        bool PushWrite(const Write& write);
+        // Server side
+        bool PopWrite(Write& write);
+
+        // The host bumps this while it runs; the server watches it to tell whether a host is attached
+        void Heartbeat();
+        uint64_t HostHeartbeat() const;
+
+        SnapshotChannel(const SnapshotChannel&) = delete;
+        SnapshotChannel& operator=(const SnapshotChannel&) = delete;
+
+    private:
+        struct Layout;
+        SnapshotChannel() = default;
+        static std::unique_ptr<SnapshotChannel> Map(const std::string& name, bool create);
+
+        Layout* layout = nullptr;
+        std::string name;
+        bool owner = false;
+#ifdef _WIN32
+        void* mapping = nullptr;
+#endif
+    };
+
+} // namespace BegeerteScript
\ No newline at end of file
@@ -0,0 +1,210 @@
+#include "TimerWheel.h"
+#include <bit>
+
+namespace BegeerteScript {
+
+    TimerWheel::TimerWheel(uint64_t now) : current(now) {}
+
+    TimerWheel::TimerId TimerWheel::MakeId(uint32_t index, uint32_t generation) {
+        return (static_cast<uint64_t>(generation) << 32) | index;
+    }
+
+    uint32_t TimerWheel::Resolve(TimerId id) const {
+        uint32_t index = static_cast<uint32_t>(id & 0xFFFFFFFF);
+        uint32_t generation = static_cast<uint32_t>(id >> 32);
+        if (index >= nodes.size() || nodes[index].generation != generation || nodes[index].state == NodeState::Free) {
+            return None;
+        }
+        return index;
+    }
+
+    uint32_t TimerWheel::AllocateNode() {
+        if (!free_nodes.empty()) {
+            uint32_t index = free_nodes.back();
+            free_nodes.pop_back();
+            return index;
+        }
+        nodes.emplace_back();
+        return static_cast<uint32_t>(nodes.size() - 1);
+    }
+
+    void TimerWheel::FreeNode(uint32_t index) {
+        Node& node = nodes[index];
+        node.state = NodeState::Free;
+        node.generation = node.generation == UINT32_MAX ? 1 : node.generation + 1; // Stale ids stop resolving
+        free_nodes.push_back(index);
+    }
+
+    TimerWheel::List& TimerWheel::ListOf(int level, int slot) {
+        return level == OverflowLevel ? overflow : wheel[level][slot];
+    }
+
+    void TimerWheel::PushBack(List& list, uint32_t index) {
+        Node& node = nodes[index];
+        node.prev = list.tail;
+        node.next = None;
+        if (list.tail != None) {
+            nodes[list.tail].next = index;
+        }
+        else {
+            list.head = index;
+        }
+        list.tail = index;
+    }
+
+    void TimerWheel::Insert(uint32_t index) {
+        Node& node = nodes[index];
+        uint64_t difference = node.deadline ^ current;
+        int level = 0;
+        if (difference >= Slots) {
+            level = (63 - std::countl_zero(difference)) / SlotBits;
+        }
+        if (level >= Levels) {
+            node.level = OverflowLevel;
+            node.slot = 0;
+            PushBack(overflow, index);
+            return;
+        }
+        int slot = static_cast<int>((node.deadline >> (level * SlotBits)) & (Slots - 1));
+        node.level = static_cast<uint8_t>(level);
+        node.slot = static_cast<uint8_t>(slot);
+        PushBack(wheel[level][slot], index);
+        occupied[level] |= 1ULL << slot;
+    }
+
+    void TimerWheel::Unlink(uint32_t index) {
+        Node& node = nodes[index];
+        List& list = ListOf(node.level, node.slot);
+        if (node.prev != None) nodes[node.prev].next = node.next;
+        else list.head = node.next;
+        if (node.next != None) nodes[node.next].prev = node.prev;
+        else list.tail = node.prev;
+        node.prev = node.next = None;
+        if (list.head == None && node.level != OverflowLevel) {
+            occupied[node.level] &= ~(1ULL << node.slot);
+        }
+    }
+
+    TimerWheel::TimerId TimerWheel::Schedule(uint64_t deadline, uint64_t period, uint64_t payload) {
+        uint32_t index = AllocateNode();
+        Node& node = nodes[index];
+        node.deadline = deadline < current ? current : deadline;
+        if (firing && node.deadline == current) {
+            node.deadline = current + 1;
+        }
+        node.period = period;
+        node.payload = payload;
+        node.state = NodeState::Queued;
+        Insert(index);
+        active++;
+        return MakeId(index, node.generation);
+    }
+
+    bool TimerWheel::Cancel(TimerId id) {
+        uint32_t index = Resolve(id);
+        if (index == None) {
+            return false;
+        }
+        Node& node = nodes[index];
+        if (node.state == NodeState::Queued) {
+            Unlink(index);
+            FreeNode(index);
+            active--;
+            return true;
+        }
+        if (node.state == NodeState::Firing) {
+            node.state = NodeState::Cancelled; // Freed by Advance once 'fire' returns
+            return true;
+        }
+        return false;
+    }
+
+    // Moves every timer of the slot that starts at 'current' one or more levels down
+    void TimerWheel::Cascade(int level) {
+        List moved;
+        if (level == OverflowLevel) {
+            moved = overflow;
+            overflow = List{};
+        }
+        else {
+            int slot = static_cast<int>((current >> (level * SlotBits)) & (Slots - 1));
+            moved = wheel[level][slot];
+            wheel[level][slot] = List{};
+            occupied[level] &= ~(1ULL << slot);
+        }
+        for (uint32_t index = moved.head; index != None; ) {
+            uint32_t next = nodes[index].next;
+            Insert(index);
+            index = next;
+        }
+    }
+
+    uint64_t TimerWheel::NextDeadline() const {
+        if (occupied[0] & (1ULL << (current & (Slots - 1)))) {
+            return current;
+        }
+        for (int level = 0; level < Levels; ++level) {
+            int shift = level * SlotBits;
+            uint64_t index = (current >> shift) & (Slots - 1);
+            uint64_t later = index == Slots - 1 ? 0 : occupied[level] & (~0ULL << (index + 1));
+            if (later) {
+                uint64_t block = (current >> (shift + SlotBits)) << (shift + SlotBits);
+                return block | (static_cast<uint64_t>(std::countr_zero(later)) << shift);
+            }
+        }
+        if (overflow.head != None) {
+            return ((current >> (Levels * SlotBits)) + 1) << (Levels * SlotBits);
+        }
+        return Never;
+    }
+
+    size_t TimerWheel::Advance(uint64_t now, const FireFunction& fire) {
+        size_t fired = 0;
+        while (true) {
+            // Everything due at 'current' sits in its level 0 slot
+            List& due = wheel[0][current & (Slots - 1)];
+            while (due.head != None) {
+                uint32_t index = due.head;
+                Unlink(index);
+                nodes[index].state = NodeState::Firing;
+                TimerId id = MakeId(index, nodes[index].generation);
+                firing = true;
+                fire(id, nodes[index].payload); // May grow 'nodes'
+                firing = false;
+                fired++;
+
+                Node& node = nodes[index];
+                if (node.state == NodeState::Cancelled || node.period == 0) {
+                    FreeNode(index);
+                    active--;
+                    continue;
+                }
+                node.state = NodeState::Queued;
+                node.deadline += node.period;
+                if (node.deadline <= now) {
+                    // Fell behind: skip the missed periods instead of firing them all in this call
+                    node.deadline += ((now - node.deadline) / node.period + 1) * node.period;
+                }
+                Insert(index);
+            }
+            if (current >= now) {
+                return fired;
+            }
+
+            uint64_t next = NextDeadline();
+            if (next > now) {
+                // No slot comes up before 'now', so no timer changes level on the way
+                current = now;
+                return fired;
+            }
+            current = next;
+            for (int level = OverflowLevel; level >= 1; --level) {
+                uint64_t mask = (1ULL << (level * SlotBits)) - 1;
+                if ((current & mask) == 0) {
+                    Cascade(level);
+                }
+            }
+        }
+    }
+
+} // namespace BegeerteScript
\ No newline at end of file
@@ -0,0 +1,162 @@
+#include "WorkerPool.h"
+#include "Config.h"
+#include "ThreadPlacement.h"
+#include <iostream>
+
+namespace BegeerteScript {
+
+    WorkerPool::WorkerPool(size_t thread_count) {
+        for (size_t i = 0; i <= thread_count; ++i) {
+            queues.push_back(std::make_unique<Queue>());
+        }
+        for (size_t i = 0; i < thread_count; ++i) {
+            threads.emplace_back(&WorkerPool::WorkerMain, this, i);
+        }
+    }
+
+    WorkerPool::~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    // Own deque first (newest task, still warm in cache), then the oldest task of every other deque
+    bool WorkerPool::TryRunOne(size_t home) {
+        for (size_t n = 0; n < queues.size(); ++n) {
+            Queue& queue = *queues[(home + n) % queues.size()];
+            Task task;
+            {
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                if (queue.tasks.empty()) {
+                    continue;
+                }
+                if (n == 0) {
+                    task = std::move(queue.tasks.back());
+                    queue.tasks.pop_back();
+                }
+                else {
+                    task = std::move(queue.tasks.front());
+                    queue.tasks.pop_front();
+                }
+            }
+            queued.fetch_sub(1, std::memory_order_relaxed);
+            task();
+            return true;
+        }
+        return false;
+    }
+
+    void WorkerPool::WorkerMain(size_t index) {
+        ThreadPlacement::Apply("Worker", index);
+        while (true) {
+            if (TryRunOne(index)) {
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(wake_mutex);
+            wake.wait(lock, [this] { return stopping || queued.load(std::memory_order_relaxed) > 0; });
+            if (stopping) {
+                return;
+            }
+        }
+    }
+
+    void WorkerPool::RunAll(std::vector<Task>& tasks) {
+        if (tasks.empty()) {
+            return;
+        }
+
+        struct Batch {
+            std::atomic<size_t> remaining;
+            std::mutex mutex;
+            std::condition_variable done;
+            std::exception_ptr error;
+        } batch;
+        batch.remaining = tasks.size();
+
+        // Deal the tasks round-robin so every worker starts with local work
+        size_t start = next_queue.fetch_add(1, std::memory_order_relaxed);
+        for (size_t i = 0; i < tasks.size(); ++i) {
+            Queue& queue = *queues[(start + i) % queues.size()];
+            Task wrapped = [&batch, task = std::move(tasks[i])]() {
+                try {
+                    task();
+                }
+                catch (...) {
+                    std::lock_guard<std::mutex> lock(batch.mutex);
+                    if (!batch.error) batch.error = std::current_exception();
+                }
+                // Under the lock: RunAll may return (destroying the batch) as soon as it sees zero
+                std::lock_guard<std::mutex> lock(batch.mutex);
+                if (batch.remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    batch.done.notify_all();
+                }
+            };
+            queued.fetch_add(1, std::memory_order_relaxed); // Before the push, so a stealer never sees it go negative
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.tasks.push_back(std::move(wrapped));
+        }
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex);
+        }
+        wake.notify_all();
+
+        // Help until our tasks are all taken, then wait for the ones still running elsewhere
+        while (batch.remaining.load(std::memory_order_acquire) > 0 && TryRunOne(queues.size() - 1)) {
+        }
+        {
+            std::unique_lock<std::mutex> lock(batch.mutex);
+            batch.done.wait(lock, [&batch] { return batch.remaining.load(std::memory_order_acquire) == 0; });
+        }
+        tasks.clear();
+        if (batch.error) {
+            std::rethrow_exception(batch.error);
+        }
+    }
+
+    void WorkerPool::Submit(Task task) {
+        Task guarded = [task = std::move(task)]() {
+            try {
+                task();
+            }
+            catch (const std::exception& e) {
+                std::cerr << "[BegeerteScript] Worker pool task failed: " << e.what() << std::endl;
+            }
+            catch (...) {
+                std::cerr << "[BegeerteScript] Worker pool task failed with an unknown error." << std::endl;
+            }
+        };
+        if (threads.empty()) {
+            guarded();
+            return;
+        }
+        // Spread over the worker deques; idle workers steal from the busy ones
+        Queue& queue = *queues[next_queue.fetch_add(1, std::memory_order_relaxed) % threads.size()];
+        queued.fetch_add(1, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.tasks.push_back(std::move(guarded));
+        }
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex);
+        }
+        wake.notify_one();
+    }
+
+    WorkerPool& WorkerPool::Shared() {
+        // Never destroyed: at process exit the workers may already be gone and could not be joined
+        static WorkerPool* pool = new WorkerPool([] {
+            unsigned int cores = std::thread::hardware_concurrency();
+            int configured = Config::GetInt("Scripts", "WorkerThreads", static_cast<int>(cores / 2));
+            size_t count = configured > 0 ? static_cast<size_t>(configured) : 0;
+            std::cout << "[BegeerteScript] Worker pool: " << count << " thread(s)" << std::endl;
+            return count;
+            }());
+        return *pool;
+    }
+
+} // namespace BegeerteScript
\ No newline at end of file
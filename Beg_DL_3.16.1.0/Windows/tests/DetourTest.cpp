@@ -0,0 +1,467 @@
+// Detour on x86-64 Linux: instruction lengths against known encodings, how BuildTrampoline relocates
+// branches and RIP-relative operands, and a real Create/Enable/Disable cycle on functions of this test.
+#include "Check.h"
+#include "Detour.h"
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <vector>
+#include <sys/mman.h>
+
+using Detour::Instruction;
+
+// Hook targets with known prologues, written in assembly so the compiler cannot change them:
+//   DetourTestCompare(x): x < 0 ? bias - x : bias + 2x, with a Jcc and a RIP-relative load in its first bytes
+//   DetourTestCall(x):    starts with a call, returns 7 + x
+//   DetourTestLoop(n):    starts with jrcxz, counts n down with loop and returns n
+//   DetourTestJump(x):    a jmp rel32 to DetourTestCompare
+extern "C" {
+    int DetourTestBias = 100;
+    int DetourTestCompare(int x);
+    int DetourTestCall(int x);
+    int DetourTestLoop(int n);
+    int DetourTestJump(int x);
+}
+
+asm(R"(
+    .text
+    .p2align 4
+    .globl DetourTestCompare
+DetourTestCompare:
+    testl %edi, %edi
+    js 1f
+    movl DetourTestBias(%rip), %eax
+    leal (%rax,%rdi,2), %eax
+    ret
+1:
+    movl DetourTestBias(%rip), %eax
+    subl %edi, %eax
+    ret
+
+    .p2align 4
+DetourTestSeven:
+    movl $7, %eax
+    ret
+
+    .p2align 4
+    .globl DetourTestCall
+DetourTestCall:
+    call DetourTestSeven
+    addl %edi, %eax
+    ret
+
+    .p2align 4
+    .globl DetourTestLoop
+DetourTestLoop:
+    movl %edi, %ecx
+    xorl %eax, %eax
+    jrcxz 2f
+1:
+    incl %eax
+    loop 1b
+2:
+    ret
+
+    .p2align 4
+    .globl DetourTestJump
+DetourTestJump:
+    .byte 0xE9
+    .long DetourTestCompare - . - 4
+    int3
+    int3
+    int3
+)");
+
+namespace {
+    struct Encoding {
+        const char* text;
+        std::vector<uint8_t> bytes;
+        size_t length;
+        Instruction::Branch branch = Instruction::Branch::None;
+        bool ripRelative = false;
+        size_t offset = 0; // relOffset for branches, dispOffset for RIP-relative
+        bool endsFlow = false;
+    };
+
+    using Branch = Instruction::Branch;
+
+    // Lengths as objdump decodes them
+    const std::vector<Encoding>& Encodings() {
+        static const std::vector<Encoding> encodings = {
+            { "push rbp", { 0x55 }, 1 },
+            { "mov rbp, rsp", { 0x48, 0x89, 0xE5 }, 3 },
+            { "sub rsp, 0x28", { 0x48, 0x83, 0xEC, 0x28 }, 4 },
+            { "sub rsp, 0x1000", { 0x48, 0x81, 0xEC, 0x00, 0x10, 0x00, 0x00 }, 7 },
+            { "mov rax, [rsp+8]", { 0x48, 0x8B, 0x44, 0x24, 0x08 }, 5 },
+            { "mov eax, [rbx*4+0x1000]", { 0x8B, 0x04, 0x9D, 0x00, 0x10, 0x00, 0x00 }, 7 },
+            { "mov rax, fs:[0x28]", { 0x64, 0x48, 0x8B, 0x04, 0x25, 0x28, 0x00, 0x00, 0x00 }, 9 },
+            { "mov qword [rsp+0x10], imm32", { 0x48, 0xC7, 0x44, 0x24, 0x10, 0x01, 0x02, 0x03, 0x04 }, 9 },
+            { "mov byte [rax], 1", { 0xC6, 0x00, 0x01 }, 3 },
+            { "imul eax, ecx, imm32", { 0x69, 0xC1, 0x78, 0x56, 0x34, 0x12 }, 6 },
+            { "imul eax, ecx, 5", { 0x6B, 0xC1, 0x05 }, 3 },
+            { "enter 0x10, 0", { 0xC8, 0x10, 0x00, 0x00 }, 4 },
+            { "lock cmpxchg [rcx], edx", { 0xF0, 0x0F, 0xB1, 0x11 }, 4 },
+            { "pause", { 0xF3, 0x90 }, 2 },
+            { "fld dword [rax]", { 0xD9, 0x00 }, 2 },
+            { "mov eax, imm32", { 0xB8, 0x01, 0x02, 0x03, 0x04 }, 5 },
+            { "movabs rax, imm64", { 0x48, 0xB8, 1, 2, 3, 4, 5, 6, 7, 8 }, 10 },
+
+            // 66 shrinks imm32 operands to imm16
+            { "mov ax, imm16", { 0x66, 0xB8, 0x34, 0x12 }, 4 },
+            { "add ax, imm16", { 0x66, 0x05, 0x34, 0x12 }, 4 },
+            { "cmp word [rax], imm16", { 0x66, 0x81, 0x38, 0x34, 0x12 }, 5 },
+            { "mov word [rax], imm16", { 0x66, 0xC7, 0x00, 0x34, 0x12 }, 5 },
+            { "push imm16", { 0x66, 0x68, 0x34, 0x12 }, 4 },
+            { "add ax, 1 (imm8 stays)", { 0x66, 0x83, 0xC0, 0x01 }, 4 },
+
+            // F6/F7: only /0 and /1 (test) carry an immediate
+            { "test byte [rax], 1", { 0xF6, 0x00, 0x01 }, 3 },
+            { "test dword [rax], imm32", { 0xF7, 0x00, 0x01, 0x02, 0x03, 0x04 }, 6 },
+            { "test word [rax], imm16", { 0x66, 0xF7, 0x00, 0x34, 0x12 }, 5 },
+            { "test rcx, imm32", { 0x48, 0xF7, 0xC1, 0x01, 0x00, 0x00, 0x00 }, 7 },
+            { "not dword [rax]", { 0xF7, 0x10 }, 2 },
+            { "neg rax", { 0x48, 0xF7, 0xD8 }, 3 },
+            { "div rcx", { 0x48, 0xF7, 0xF1 }, 3 },
+            { "mul byte [rax]", { 0xF6, 0x20 }, 2 },
+            { "idiv dword [rip+x]", { 0xF7, 0x3D, 0x10, 0x00, 0x00, 0x00 }, 6, Branch::None, true, 2 },
+
+            // moffs: 8 bytes of address, 4 with 67
+            { "movabs al, [moffs64]", { 0xA0, 1, 2, 3, 4, 5, 6, 7, 8 }, 9 },
+            { "movabs rax, [moffs64]", { 0x48, 0xA1, 1, 2, 3, 4, 5, 6, 7, 8 }, 10 },
+            { "movabs [moffs64], eax", { 0xA3, 1, 2, 3, 4, 5, 6, 7, 8 }, 9 },
+            { "mov eax, [moffs32]", { 0x67, 0xA1, 1, 2, 3, 4 }, 6 },
+
+            // RIP-relative, immediates after the displacement
+            { "mov rax, [rip+x]", { 0x48, 0x8B, 0x05, 0x78, 0x56, 0x34, 0x12 }, 7, Branch::None, true, 3 },
+            { "lea rcx, [rip+x]", { 0x48, 0x8D, 0x0D, 0x00, 0x01, 0x00, 0x00 }, 7, Branch::None, true, 3 },
+            { "cmp byte [rip+x], 0", { 0x80, 0x3D, 0x10, 0x00, 0x00, 0x00, 0x00 }, 7, Branch::None, true, 2 },
+            { "mov dword [rip+x], imm32", { 0xC7, 0x05, 0x10, 0x00, 0x00, 0x00, 1, 2, 3, 4 }, 10, Branch::None, true, 2 },
+            { "test byte [rip+x], 1", { 0xF6, 0x05, 0x10, 0x00, 0x00, 0x00, 0x01 }, 7, Branch::None, true, 2 },
+            { "cmp word [rip+x], imm16", { 0x66, 0x81, 0x3D, 0x10, 0x00, 0x00, 0x00, 0x34, 0x12 }, 9, Branch::None, true, 3 },
+            { "movss xmm0, [rip+x]", { 0xF3, 0x0F, 0x10, 0x05, 0x10, 0x00, 0x00, 0x00 }, 8, Branch::None, true, 4 },
+            { "jmp qword [rip+x]", { 0xFF, 0x25, 0x00, 0x00, 0x00, 0x00 }, 6, Branch::None, true, 2, true },
+
+            // 0F maps
+            { "cmovz eax, ecx", { 0x0F, 0x44, 0xC1 }, 3 },
+            { "movzx eax, byte [rcx]", { 0x0F, 0xB6, 0x01 }, 3 },
+            { "nop dword [rax+rax]", { 0x0F, 0x1F, 0x44, 0x00, 0x00 }, 5 },
+            { "bt eax, 3", { 0x0F, 0xBA, 0xE0, 0x03 }, 4 },
+            { "shld eax, ecx, 4", { 0x0F, 0xA4, 0xC8, 0x04 }, 4 },
+            { "cpuid", { 0x0F, 0xA2 }, 2 },
+            { "syscall", { 0x0F, 0x05 }, 2 },
+            { "rdtsc", { 0x0F, 0x31 }, 2 },
+            { "pshufd xmm0, xmm1, 0x1b", { 0x66, 0x0F, 0x70, 0xC1, 0x1B }, 5 },
+            { "pshufb xmm0, xmm1", { 0x66, 0x0F, 0x38, 0x00, 0xC1 }, 5 },
+            { "palignr xmm0, xmm1, 4", { 0x66, 0x0F, 0x3A, 0x0F, 0xC1, 0x04 }, 6 },
+
+            // VEX
+            { "vzeroupper", { 0xC5, 0xF8, 0x77 }, 3 },
+            { "vmovups ymm0, [rax]", { 0xC5, 0xFC, 0x10, 0x00 }, 4 },
+            { "vmovdqu ymm1, [rip+x]", { 0xC5, 0xFE, 0x6F, 0x0D, 0x10, 0x00, 0x00, 0x00 }, 8, Branch::None, true, 4 },
+            { "vpshufd xmm0, xmm1, 0x1b", { 0xC5, 0xF9, 0x70, 0xC1, 0x1B }, 5 },
+            { "vfmadd231ps ymm0, ymm1, ymm2", { 0xC4, 0xE2, 0x75, 0xB8, 0xC2 }, 5 },
+            { "andn eax, ebx, ecx", { 0xC4, 0xE2, 0x60, 0xF2, 0xC1 }, 5 },
+            { "vpermq ymm0, ymm1, 0x4e", { 0xC4, 0xE3, 0xFD, 0x00, 0xC1, 0x4E }, 6 },
+            { "vmovaps xmm0, [rip+x] (3-byte VEX)", { 0xC4, 0xE1, 0x78, 0x28, 0x05, 0x10, 0x00, 0x00, 0x00 }, 9, Branch::None, true, 5 },
+
+            // EVEX
+            { "vmovups zmm0, [rax]", { 0x62, 0xF1, 0x7C, 0x48, 0x10, 0x00 }, 6 },
+            { "vmovups zmm0, [rax+0x40]", { 0x62, 0xF1, 0x7C, 0x48, 0x10, 0x40, 0x01 }, 7 },
+            { "vmovdqu64 zmm1, [rip+x]", { 0x62, 0xF1, 0xFE, 0x48, 0x6F, 0x0D, 0x10, 0x00, 0x00, 0x00 }, 10, Branch::None, true, 6 },
+            { "vpternlogd zmm0, zmm1, zmm2, 0xff", { 0x62, 0xF3, 0x75, 0x48, 0x25, 0xC2, 0xFF }, 7 },
+            { "vpaddd zmm0, zmm1, zmm2", { 0x62, 0xF1, 0x75, 0x48, 0xFE, 0xC2 }, 6 },
+
+            // Branches
+            { "je rel8", { 0x74, 0x10 }, 2, Branch::Jcc, false, 1 },
+            { "jne rel32", { 0x0F, 0x85, 0x00, 0x01, 0x00, 0x00 }, 6, Branch::Jcc, false, 2 },
+            { "jmp rel8", { 0xEB, 0x10 }, 2, Branch::Jmp, false, 1, true },
+            { "jmp rel32", { 0xE9, 0x00, 0x01, 0x00, 0x00 }, 5, Branch::Jmp, false, 1, true },
+            { "call rel32", { 0xE8, 0x00, 0x01, 0x00, 0x00 }, 5, Branch::Call, false, 1 },
+            { "loop rel8", { 0xE2, 0xFE }, 2, Branch::Loop, false, 1 },
+            { "jrcxz rel8", { 0xE3, 0x05 }, 2, Branch::Loop, false, 1 },
+            { "jecxz rel8", { 0x67, 0xE3, 0x05 }, 3, Branch::Loop, false, 2 },
+            { "call rax", { 0xFF, 0xD0 }, 2 },
+            { "jmp rax", { 0xFF, 0xE0 }, 2, Branch::None, false, 0, true },
+            { "ret", { 0xC3 }, 1, Branch::None, false, 0, true },
+            { "ret 8", { 0xC2, 0x08, 0x00 }, 3, Branch::None, false, 0, true },
+            { "int3", { 0xCC }, 1, Branch::None, false, 0, true },
+        };
+        return encodings;
+    }
+
+    void DecodesKnownLengths() {
+        for (const Encoding& encoding : Encodings()) {
+            // Padding after the instruction must not change the result
+            std::vector<uint8_t> code = encoding.bytes;
+            code.resize(code.size() + 16, 0xCC);
+            Instruction ins;
+            bool decoded = Detour::Decode(code.data(), ins);
+            if (!decoded || ins.length != encoding.length) {
+                BegeerteTest::Fail(__FILE__, __LINE__, std::string(encoding.text) + ": length " + std::to_string(ins.length) + ", expected " + std::to_string(encoding.length));
+                continue;
+            }
+            if (ins.branch != encoding.branch || ins.ripRelative != encoding.ripRelative || ins.endsFlow != encoding.endsFlow) {
+                BegeerteTest::Fail(__FILE__, __LINE__, std::string(encoding.text) + ": wrong branch, RIP-relative or end-of-flow flag");
+                continue;
+            }
+            size_t offset = encoding.branch != Branch::None ? ins.relOffset : encoding.ripRelative ? ins.dispOffset : 0;
+            if (offset != encoding.offset) {
+                BegeerteTest::Fail(__FILE__, __LINE__, std::string(encoding.text) + ": operand offset " + std::to_string(offset) + ", expected " + std::to_string(encoding.offset));
+            }
+        }
+    }
+
+    void RejectsInvalidOpcodes() {
+        for (std::vector<uint8_t> bytes : { std::vector<uint8_t>{ 0x06 }, { 0x60 }, { 0x9A, 0, 0, 0, 0, 0, 0 }, { 0xEA, 0, 0, 0, 0, 0, 0 }, { 0x40, 0x40, 0x90 } }) {
+            bytes.resize(bytes.size() + 16, 0xCC);
+            Instruction ins;
+            CHECK(!Detour::Decode(bytes.data(), ins));
+        }
+    }
+
+    // Target code and trampoline next to each other in one buffer, so every relocation fits in rel32
+    struct Buffers {
+        std::vector<uint8_t> memory = std::vector<uint8_t>(0x400, 0xCC);
+        uint8_t* target = memory.data();
+        uint8_t* trampoline = memory.data() + 0x200;
+
+        void Code(std::initializer_list<uint8_t> bytes) {
+            std::copy(bytes.begin(), bytes.end(), target);
+        }
+    };
+
+    uint64_t AbsoluteJumpTarget(const uint8_t* at) {
+        // jmp [rip+0]; dq destination
+        if (at[0] != 0xFF || at[1] != 0x25 || at[2] || at[3] || at[4] || at[5]) {
+            return 0;
+        }
+        uint64_t destination;
+        std::memcpy(&destination, at + 6, 8);
+        return destination;
+    }
+
+    void RelocatesJcc() {
+        Buffers buffers;
+        // je +0x10; mov rbp, rsp; nop...
+        buffers.Code({ 0x74, 0x10, 0x48, 0x89, 0xE5, 0x90, 0x90 });
+        size_t stolen = 0, written = 0;
+        CHECK(Detour::BuildTrampoline(buffers.target, 5, buffers.trampoline, 128, stolen, written));
+        CHECK_EQ(stolen, 5u);
+        const uint8_t* out = buffers.trampoline;
+        CHECK_EQ(out[0], 0x75); // jne skips the absolute jump
+        CHECK_EQ(out[1], 14);
+        CHECK_EQ(AbsoluteJumpTarget(out + 2), reinterpret_cast<uint64_t>(buffers.target + 2 + 0x10));
+        CHECK(std::memcmp(out + 16, buffers.target + 2, 3) == 0);
+        CHECK_EQ(AbsoluteJumpTarget(out + 19), reinterpret_cast<uint64_t>(buffers.target + 5));
+        CHECK_EQ(written, 33u);
+
+        // jg rel32, near form: inverted to a short jle
+        buffers.Code({ 0x0F, 0x8F, 0x00, 0x01, 0x00, 0x00 });
+        CHECK(Detour::BuildTrampoline(buffers.target, 5, buffers.trampoline, 128, stolen, written));
+        CHECK_EQ(stolen, 6u);
+        CHECK_EQ(out[0], 0x7E);
+        CHECK_EQ(AbsoluteJumpTarget(out + 2), reinterpret_cast<uint64_t>(buffers.target + 6 + 0x100));
+    }
+
+    void RelocatesLoop() {
+        Buffers buffers;
+        // jecxz +0x20; xor eax, eax; nop
+        buffers.Code({ 0x67, 0xE3, 0x20, 0x31, 0xC0, 0x90 });
+        size_t stolen = 0, written = 0;
+        CHECK(Detour::BuildTrampoline(buffers.target, 5, buffers.trampoline, 128, stolen, written));
+        CHECK_EQ(stolen, 5u);
+        const uint8_t* out = buffers.trampoline;
+        // jecxz +2 keeps its prefix, then jmp +14 over the absolute jump taken when it branches
+        const uint8_t expected[] = { 0x67, 0xE3, 0x02, 0xEB, 0x0E };
+        CHECK(std::memcmp(out, expected, sizeof(expected)) == 0);
+        CHECK_EQ(AbsoluteJumpTarget(out + 5), reinterpret_cast<uint64_t>(buffers.target + 3 + 0x20));
+        CHECK(std::memcmp(out + 19, buffers.target + 3, 2) == 0);
+        CHECK_EQ(AbsoluteJumpTarget(out + 21), reinterpret_cast<uint64_t>(buffers.target + 5));
+    }
+
+    void RelocatesCall() {
+        Buffers buffers;
+        buffers.Code({ 0xE8, 0x00, 0x10, 0x00, 0x00, 0x90 });
+        size_t stolen = 0, written = 0;
+        CHECK(Detour::BuildTrampoline(buffers.target, 5, buffers.trampoline, 128, stolen, written));
+        CHECK_EQ(stolen, 5u);
+        const uint8_t* out = buffers.trampoline;
+        const uint8_t expected[] = { 0xFF, 0x15, 0x02, 0x00, 0x00, 0x00, 0xEB, 0x08 };
+        CHECK(std::memcmp(out, expected, sizeof(expected)) == 0);
+        uint64_t destination;
+        std::memcpy(&destination, out + 8, 8);
+        CHECK_EQ(destination, reinterpret_cast<uint64_t>(buffers.target + 5 + 0x1000));
+        CHECK_EQ(AbsoluteJumpTarget(out + 16), reinterpret_cast<uint64_t>(buffers.target + 5));
+    }
+
+    void RelocatesJmpWithoutReturn() {
+        Buffers buffers;
+        buffers.Code({ 0xE9, 0x00, 0x01, 0x00, 0x00 });
+        size_t stolen = 0, written = 0;
+        CHECK(Detour::BuildTrampoline(buffers.target, 5, buffers.trampoline, 128, stolen, written));
+        CHECK_EQ(stolen, 5u);
+        CHECK_EQ(written, 14u); // Nothing after an unconditional jmp
+        CHECK_EQ(AbsoluteJumpTarget(buffers.trampoline), reinterpret_cast<uint64_t>(buffers.target + 5 + 0x100));
+    }
+
+    void RelocatesRipRelative() {
+        Buffers buffers;
+        // mov rax, [rip+0x100]; cmp byte [rip-0x20], 7
+        buffers.Code({ 0x48, 0x8B, 0x05, 0x00, 0x01, 0x00, 0x00, 0x80, 0x3D, 0xE0, 0xFF, 0xFF, 0xFF, 0x07 });
+        size_t stolen = 0, written = 0;
+        CHECK(Detour::BuildTrampoline(buffers.target, 8, buffers.trampoline, 128, stolen, written));
+        CHECK_EQ(stolen, 14u);
+        const uint8_t* out = buffers.trampoline;
+        int32_t disp;
+        std::memcpy(&disp, out + 3, 4);
+        CHECK(out + 7 + disp == buffers.target + 7 + 0x100); // Still addresses the same byte
+        std::memcpy(&disp, out + 9, 4);
+        CHECK(out + 14 + disp == buffers.target + 14 - 0x20);
+        CHECK_EQ(out[13], 0x07); // The immediate behind the displacement is untouched
+        CHECK_EQ(AbsoluteJumpTarget(out + 14), reinterpret_cast<uint64_t>(buffers.target + 14));
+    }
+
+    void RejectsRipRelativeOutOfRange() {
+        Buffers buffers;
+        buffers.Code({ 0x48, 0x8B, 0x05, 0x00, 0x01, 0x00, 0x00 });
+        // A trampoline more than 2 GB away cannot reach the operand
+        void* far = mmap(reinterpret_cast<void*>((reinterpret_cast<uintptr_t>(buffers.target) + (1ULL << 33)) & ~0xFFFFULL), 0x1000,
+            PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        CHECK(far != MAP_FAILED);
+        int64_t distance = static_cast<uint8_t*>(far) - buffers.target;
+        if (far != MAP_FAILED && (distance > INT32_MAX || distance < INT32_MIN)) {
+            size_t stolen = 0, written = 0;
+            CHECK(!Detour::BuildTrampoline(buffers.target, 5, static_cast<uint8_t*>(far), 128, stolen, written));
+        }
+        if (far != MAP_FAILED) {
+            munmap(far, 0x1000);
+        }
+    }
+
+    void RejectsUnsafePrologues() {
+        Buffers buffers;
+        size_t stolen = 0, written = 0;
+        // je +1 lands inside the bytes that the jmp replaces
+        buffers.Code({ 0x74, 0x01, 0x90, 0x90, 0x90, 0x90, 0x90 });
+        CHECK(!Detour::BuildTrampoline(buffers.target, 5, buffers.trampoline, 128, stolen, written));
+        // ret before 5 bytes: too short to hold the jmp
+        buffers.Code({ 0x31, 0xC0, 0xC3, 0x90, 0x90, 0x90 });
+        CHECK(!Detour::BuildTrampoline(buffers.target, 5, buffers.trampoline, 128, stolen, written));
+        // Not decodable
+        buffers.Code({ 0x06, 0x90, 0x90, 0x90, 0x90, 0x90 });
+        CHECK(!Detour::BuildTrampoline(buffers.target, 5, buffers.trampoline, 128, stolen, written));
+        // No room for the relocated code
+        buffers.Code({ 0x74, 0x10, 0x48, 0x89, 0xE5, 0x90 });
+        CHECK(!Detour::BuildTrampoline(buffers.target, 5, buffers.trampoline, 20, stolen, written));
+    }
+
+    // Enable, Disable and Remove take the target's address
+    void* Code(int (*function)(int)) {
+        return reinterpret_cast<void*>(function);
+    }
+
+    // Called through pointers the optimizer cannot see through, so every call really goes to the patched code
+    template<typename F>
+    F* Opaque(F* function) {
+        F* volatile pointer = function;
+        return pointer;
+    }
+
+    int (*OriginalCompare)(int) = nullptr;
+    int CompareCalls = 0;
+    int CompareDetour(int x) {
+        CompareCalls++;
+        return OriginalCompare(x) + 1000;
+    }
+
+    void HooksLocalFunction() {
+        auto compare = Opaque(DetourTestCompare);
+        CHECK_EQ(compare(5), 110);
+        CHECK_EQ(compare(-3), 103);
+
+        CHECK(Detour::Create(DetourTestCompare, CompareDetour, &OriginalCompare, "compare"));
+        CHECK(OriginalCompare != nullptr);
+        CHECK(!Detour::Create(DetourTestCompare, CompareDetour, &OriginalCompare)); // Already hooked
+        CHECK_EQ(compare(5), 110); // Created but not enabled yet
+
+        CHECK(Detour::Enable(Code(DetourTestCompare)));
+        CHECK_EQ(compare(5), 1110);
+        CHECK_EQ(compare(-3), 1103); // The relocated js and RIP-relative load both take effect
+        CHECK_EQ(CompareCalls, 2);
+        CHECK_EQ(OriginalCompare(5), 110);
+        DetourTestBias = 200;
+        CHECK_EQ(OriginalCompare(-3), 203);
+        DetourTestBias = 100;
+
+        auto hooks = Detour::List();
+        CHECK_EQ(hooks.size(), 1u);
+        if (!hooks.empty()) {
+            CHECK_EQ(hooks[0].name, std::string("compare"));
+            CHECK_EQ(hooks[0].stolen, 10u); // test, js and the whole RIP-relative mov
+            CHECK(hooks[0].enabled);
+        }
+
+        CHECK(Detour::Disable(Code(DetourTestCompare)));
+        CHECK_EQ(compare(5), 110);
+        CHECK_EQ(CompareCalls, 2);
+        CHECK(Detour::Enable(Code(DetourTestCompare)));
+        CHECK_EQ(compare(1), 1102);
+        CHECK(Detour::Remove(Code(DetourTestCompare)));
+        CHECK_EQ(compare(1), 102);
+        CHECK(!Detour::Enable(Code(DetourTestCompare)));
+        CHECK(Detour::List().empty());
+    }
+
+    int (*OriginalCall)(int) = nullptr;
+    int CallDetour(int x) { return OriginalCall(x) * 10; }
+
+    int (*OriginalLoop)(int) = nullptr;
+    int LoopDetour(int n) { return -OriginalLoop(n); }
+
+    int (*OriginalJump)(int) = nullptr;
+    int JumpDetour(int x) { return OriginalJump(x) + 1; }
+
+    void HooksThroughRelocatedBranches() {
+        auto call = Opaque(DetourTestCall);
+        auto loop = Opaque(DetourTestLoop);
+        auto jump = Opaque(DetourTestJump);
+        CHECK_EQ(call(1), 8);
+        CHECK_EQ(loop(0), 0);
+        CHECK_EQ(loop(5), 5);
+        CHECK_EQ(jump(2), 104);
+
+        CHECK(Detour::Create(DetourTestCall, CallDetour, &OriginalCall, "call"));
+        CHECK(Detour::Create(DetourTestLoop, LoopDetour, &OriginalLoop, "loop"));
+        CHECK(Detour::Create(DetourTestJump, JumpDetour, &OriginalJump, "jump"));
+        CHECK(Detour::Enable(Code(DetourTestCall)));
+        CHECK(Detour::Enable(Code(DetourTestLoop)));
+        CHECK(Detour::Enable(Code(DetourTestJump)));
+
+        CHECK_EQ(call(1), 80);   // The relocated call returns into the trampoline
+        CHECK_EQ(loop(0), 0);    // jrcxz taken through its absolute jump
+        CHECK_EQ(loop(5), -5);   // ... and not taken
+        CHECK_EQ(jump(2), 105);
+        CHECK_EQ(Detour::List().size(), 3u);
+
+        Detour::RemoveAll();
+        CHECK_EQ(call(1), 8);
+        CHECK_EQ(loop(5), 5);
+        CHECK_EQ(jump(2), 104);
+        CHECK(Detour::List().empty());
+    }
+}
+
+int main() {
+    BegeerteTest::Run("Decodes known lengths", DecodesKnownLengths);
+    BegeerteTest::Run("Rejects invalid opcodes", RejectsInvalidOpcodes);
+    BegeerteTest::Run("Relocates Jcc", RelocatesJcc);
+    BegeerteTest::Run("Relocates loop", RelocatesLoop);
+    BegeerteTest::Run("Relocates call", RelocatesCall);
+    BegeerteTest::Run("Relocates jmp without a jump back", RelocatesJmpWithoutReturn);
+    BegeerteTest::Run("Relocates RIP-relative operands", RelocatesRipRelative);
+    BegeerteTest::Run("Rejects RIP-relative operands out of range", RejectsRipRelativeOutOfRange);
+    BegeerteTest::Run("Rejects unsafe prologues", RejectsUnsafePrologues);
+    BegeerteTest::Run("Hooks a local function", HooksLocalFunction);
+    BegeerteTest::Run("Hooks through relocated branches", HooksThroughRelocatedBranches);
+    return BegeerteTest::Finish();
+}
\ No newline at end of file
@@ -0,0 +1,64 @@
+// BegHost: runs the .beg scripts outside the server process. With [Host] OutOfProcess=1 the plugin publishes
+// the entity list to shared memory after every server tick; BegHost runs the scripts against those snapshots
+// and sends the bytes their Player_Set* calls change back. Place it next to the server executable so it reads
+// the same Begeerte.ini and Scripts folder; with [Host] AutoStart=1 the plugin starts and restarts it.
+// Usage: BegHost.exe [channel]   (defaults to [Host] Channel)
+#include "HostEntityList.h"
+#include "SnapshotChannel.h"
+#include "plugins.h"
+#include "Hook.h"
+#include "Config.h"
+#include "ServiceLoop.h"
+#include <iostream>
+#include <thread>
+#include <atomic>
+#include <chrono>
+
+// The host's server tick is a new snapshot, so on_tick keeps the rhythm it has in-process
+namespace Hook {
+    static std::atomic<TickCallback> tickCallback{ nullptr };
+
+    void SetTickCallback(TickCallback callback) {
+        tickCallback.store(callback);
+    }
+}
+
+int main(int argc, char** argv) {
+    std::string name = argc > 1 ? argv[1] : Config::GetString("Host", "Channel", "BegeerteSnapshot");
+
+    std::unique_ptr<BegeerteScript::SnapshotChannel> channel;
+    for (bool told = false; !(channel = BegeerteScript::SnapshotChannel::Open(name)); told = true) {
+        if (!told) {
+            std::cout << "[BegHost] Waiting for the server to create '" << name << "'..." << std::endl;
+        }
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+    }
+    std::cout << "[BegHost] Attached to '" << name << "'." << std::endl;
+    HostEntityList::Attach(*channel);
+
+    ServiceLoop::Start();
+    channel->Heartbeat();
+    BegeerteScript::Plugins::Init();
+
+    uint64_t sequence = channel->Sequence();
+    auto lastTick = std::chrono::steady_clock::now();
+    while (true) {
+        // Beats on its own thread's schedule, so only a stuck host (not a busy script) looks dead to the server
+        channel->Heartbeat();
+        uint64_t current = channel->Sequence();
+        if (current == sequence || (current & 1)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+        sequence = current;
+        auto now = std::chrono::steady_clock::now();
+        double dt_ms = std::chrono::duration<double, std::milli>(now - lastTick).count();
+        lastTick = now;
+
+        // Writes made outside on_tick go out with the next snapshot as well
+        HostEntityList::FlushWrites();
+        if (Hook::TickCallback callback = Hook::tickCallback.load()) {
+            callback(dt_ms);
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,12 @@
+#pragma once
+#include "SnapshotChannel.h"
+
+// BegHost's EntityList: the same interface as src/EntityList.cpp, served from the snapshots the plugin
+// publishes. Every entity keeps its own copy while it stays on the server, so Player* handles behave as they
+// do in-process; the bytes scripts change in those copies are sent back as writes.
+namespace HostEntityList {
+    void Attach(BegeerteScript::SnapshotChannel& channel);
+
+    // Sends what scripts changed since the last snapshot. EntityList::Update does this first, too.
+    void FlushWrites();
+}
\ No newline at end of file
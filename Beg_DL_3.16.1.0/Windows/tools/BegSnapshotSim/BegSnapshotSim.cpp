@@ -0,0 +1,78 @@
+// BegSnapshotSim: stands in for the server when testing BegHost or the snapshot channel, on Windows or Linux.
+// It creates the channel, publishes fake entities every tick, applies the writes the host sends back to its
+// own copies and prints each one. Every 10 seconds one entity leaves and a new one takes its place.
+// Usage: BegSnapshotSim [players=8] [tick ms=33] [channel=BegeerteSnapshot] [seconds=0, run until killed]
+#include "SnapshotChannel.h"
+#include <iostream>
+#include <thread>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include <cstring>
+#include <cstdlib>
+
+using BegeerteScript::SnapshotChannel;
+
+static constexpr uint8_t EntityValidFlag = 232; // CheatData::EntityValidFlag
+
+static void Fill(SnapshotChannel::Entity& entity, uint64_t address) {
+    entity.address = address;
+    for (uint32_t offset = 0; offset < SnapshotChannel::EntityBytes; ++offset) {
+        entity.bytes[offset] = static_cast<uint8_t>((address >> 4) + offset * 7);
+    }
+    entity.bytes[0] = EntityValidFlag;
+}
+
+int main(int argc, char** argv) {
+    int players = argc > 1 ? std::clamp(atoi(argv[1]), 0, static_cast<int>(SnapshotChannel::MaxEntities)) : 8;
+    auto tick = std::chrono::milliseconds(argc > 2 ? std::max(atoi(argv[2]), 1) : 33);
+    std::string name = argc > 3 ? argv[3] : "BegeerteSnapshot";
+    int seconds = argc > 4 ? atoi(argv[4]) : 0;
+
+    std::unique_ptr<SnapshotChannel> channel = SnapshotChannel::Create(name);
+    if (!channel) {
+        std::cerr << "BegSnapshotSim: could not create '" << name << "'" << std::endl;
+        return 1;
+    }
+
+    uint64_t nextAddress = 0x10000000;
+    std::vector<SnapshotChannel::Entity> entities(players);
+    for (auto& entity : entities) {
+        Fill(entity, nextAddress += 0x1000);
+    }
+    std::cout << "BegSnapshotSim: publishing " << players << " entities to '" << name << "' every " << tick.count() << " ms" << std::endl;
+
+    auto start = std::chrono::steady_clock::now();
+    auto lastChurn = start;
+    uint64_t applied = 0, dropped = 0;
+    for (auto next = start; seconds <= 0 || std::chrono::steady_clock::now() - start < std::chrono::seconds(seconds); next += tick) {
+        std::this_thread::sleep_until(next);
+
+        SnapshotChannel::Write write;
+        while (channel->PopWrite(write)) {
+            auto entity = std::find_if(entities.begin(), entities.end(), [&](const auto& e) { return e.address == write.address; });
+            if (entity == entities.end() || write.offset >= SnapshotChannel::EntityBytes) {
+                dropped++;
+                continue;
+            }
+            entity->bytes[write.offset] = write.value;
+            applied++;
+            std::cout << "BegSnapshotSim: entity 0x" << std::hex << write.address << " +0x" << write.offset << std::dec
+                << " = " << static_cast<int>(write.value) << std::endl;
+        }
+
+        if (!entities.empty() && std::chrono::steady_clock::now() - lastChurn >= std::chrono::seconds(10)) {
+            lastChurn = std::chrono::steady_clock::now();
+            size_t leaving = static_cast<size_t>(rand()) % entities.size();
+            std::cout << "BegSnapshotSim: entity 0x" << std::hex << entities[leaving].address << " left, 0x" << nextAddress + 0x1000
+                << std::dec << " joined" << std::endl;
+            Fill(entities[leaving], nextAddress += 0x1000);
+        }
+
+        SnapshotChannel::Entity* out = channel->BeginPublish();
+        std::copy(entities.begin(), entities.end(), out);
+        channel->EndPublish(static_cast<uint32_t>(entities.size()));
+    }
+    std::cout << "BegSnapshotSim: " << applied << " write(s) applied, " << dropped << " dropped, host heartbeat " << channel->HostHeartbeat() << std::endl;
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,11 @@
+#pragma once
+#include <string>
+
+// 读取 Begeerte/Begeerte.ini 中的配置项，文件或键不存在时返回默认值
+namespace Config {
+    int GetInt(const std::string& section, const std::string& key, int defaultValue);
+    std::string GetString(const std::string& section, const std::string& key, const std::string& defaultValue);
+
+    // 配置文件的完整路径（服务端 exe 目录下的 Begeerte/Begeerte.ini）
+    const std::string& GetPath();
+}
\ No newline at end of file
@@ -1,6 +1,6 @@
-#pragma once
-
-namespace Console {
-    void Initialize();
-    void Cleanup();
+#pragma once
+
+namespace Console {
+    void Initialize();
+    void Cleanup();
 }
\ No newline at end of file
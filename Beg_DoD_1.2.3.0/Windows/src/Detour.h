@@ -0,0 +1,55 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// x86-64 inline hook：把目标函数开头替换为一条 jmp，被替换的指令搬到跳板中重定位后继续执行
+// 不依赖 Windows 以外的代码，解码器和跳板可以在 Linux 上对本地函数测试
+namespace Detour {
+    // 单条指令的解码结果
+    struct Instruction {
+        enum class Branch { None, Jmp, Call, Jcc, Loop };
+
+        size_t length = 0;           // 0 表示无法解码
+        uint8_t opcode = 0;          // 去掉前缀和 0F/0F38/0F3A 之后的操作码
+        int map = 0;                 // 0 单字节, 1 = 0F, 2 = 0F38, 3 = 0F3A
+        bool ripRelative = false;    // 使用 [rip+disp32] 寻址
+        size_t dispOffset = 0;       // ripRelative 时 disp32 在指令中的位置
+        Branch branch = Branch::None;
+        size_t relOffset = 0;        // 相对跳转偏移量在指令中的位置
+        size_t relSize = 0;          // 相对跳转偏移量的字节数（1 或 4）
+        bool endsFlow = false;       // ret / jmp / int3 之后不会顺序执行
+    };
+
+    // 解码 code 处的一条指令，失败时返回 false
+    bool Decode(const uint8_t* code, Instruction& out);
+
+    // 复制 target 开头至少 minBytes 字节的完整指令到 trampoline（地址为 trampolineAddress），
+    // 重定位 RIP 相对寻址和相对跳转，并在末尾跳回 target 的剩余部分。
+    // stolen 为复制的原始字节数，written 为写入跳板的字节数
+    bool BuildTrampoline(const uint8_t* target, size_t minBytes, uint8_t* trampoline, size_t capacity, size_t& stolen, size_t& written);
+
+    // 创建 hook 但不启用；original 接收调用原函数用的跳板地址
+    bool Create(void* target, void* detour, void** original, const std::string& name = "");
+    bool Enable(void* target);
+    bool Disable(void* target);
+    // 禁用并从注册表中移除。跳板内存不会释放，可能仍有线程在其中执行
+    bool Remove(void* target);
+    void RemoveAll();
+
+    template<typename F>
+    bool Create(F* target, F* detour, F** original, const std::string& name = "") {
+        return Create(reinterpret_cast<void*>(target), reinterpret_cast<void*>(detour), reinterpret_cast<void**>(original), name);
+    }
+
+    struct HookInfo {
+        std::string name;
+        void* target;
+        void* detour;
+        void* trampoline;
+        size_t stolen;
+        bool enabled;
+    };
+    std::vector<HookInfo> List();
+}
\ No newline at end of file
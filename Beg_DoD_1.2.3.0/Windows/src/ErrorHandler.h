@@ -1,7 +1,7 @@
-#pragma once
-#include <windows.h>
-
-namespace ErrorHandlerNs {
-    void RegisterExceptionFilter();
-    LONG WINAPI UnhandledExceptionFilter(EXCEPTION_POINTERS* ExceptionInfo);
+#pragma once
+#include <windows.h>
+
+namespace ErrorHandlerNs {
+    void RegisterExceptionFilter();
+    LONG WINAPI UnhandledExceptionFilter(EXCEPTION_POINTERS* ExceptionInfo);
 }
\ No newline at end of file
@@ -1,8 +1,17 @@
-#pragma once
-#include <Windows.h>
-
-namespace Hook {
-    void Initialize();
-    void Cleanup();
-    DWORD64 GetLocalPlayerAddress();
+#pragma once
+#include "Platform.h"
+
+namespace Hook {
+    void Initialize();
+    void Cleanup();
+    DWORD64 GetLocalPlayerAddress();
+
+    // 每个服务器 tick 调用一次，dt_ms 为距上一个 tick 的毫秒数。
+    // 只有引擎 tick 的 hook 安装成功后才在游戏线程上同步调用；GAME_ENGINE_TICK 未设置或 hook 失败时，
+    // 由服务线程按 [Hook] FallbackTickMs 调用，与游戏线程并行
+    using TickCallback = void(*)(double dt_ms);
+    void SetTickCallback(TickCallback callback);
+
+    // 引擎 tick 的 detour 调用此函数。在它第一次被调用之前，由服务线程按 [Hook] FallbackTickMs 代为驱动
+    void OnServerTick();
 }
\ No newline at end of file
@@ -0,0 +1,73 @@
+#include "IdleMode.h"
+#include "ScriptScheduler.h"
+#include "ServiceLoop.h"
+#include "EntityList.h"
+#include "Config.h"
+#include <iostream>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+
+namespace BegeerteScript {
+    namespace IdleMode {
+
+        using Clock = std::chrono::steady_clock;
+
+        static std::atomic<bool> Idle{ false };
+        static std::chrono::seconds EmptyAfter{ 300 };
+        static std::chrono::milliseconds ProbeInterval{ 5000 };
+
+        // Only touched by the probe on the service thread
+        static unsigned long long SeenEpoch = 0;
+        static Clock::time_point EmptySince; // Empty while players are present
+
+        static void Probe() {
+            // Outside idle mode the scripts normally keep the entity list fresh; only walk it here when
+            // nothing did since the last probe. In idle mode this is the only walk there is.
+            unsigned long long epoch = EntityList::GetUpdateEpoch();
+            if (Idle.load(std::memory_order_relaxed) || epoch == SeenEpoch) {
+                EntityList::Update();
+                epoch = EntityList::GetUpdateEpoch();
+            }
+            SeenEpoch = epoch;
+
+            size_t players = EntityList::GetPlayerCount();
+            if (players > 0) {
+                EmptySince = {};
+                if (Idle.exchange(false)) {
+                    ScriptScheduler::Shared().Park(ScriptScheduler::ParkReason::Idle, false);
+                    std::cout << "[BegeerteScript] " << players << " player(s) on the server, leaving idle mode." << std::endl;
+                }
+                return;
+            }
+            if (Idle.load(std::memory_order_relaxed)) {
+                return;
+            }
+            auto now = Clock::now();
+            if (EmptySince == Clock::time_point{}) {
+                EmptySince = now;
+            }
+            else if (now - EmptySince >= EmptyAfter) {
+                Idle.store(true);
+                ScriptScheduler::Shared().Park(ScriptScheduler::ParkReason::Idle, true);
+                std::cout << "[BegeerteScript] No players for " << EmptyAfter.count() << " s, scripts parked until someone joins (checking every "
+                    << ProbeInterval.count() << " ms)." << std::endl;
+            }
+        }
+
+        void Init() {
+            int empty_sec = Config::GetInt("Idle", "EmptySec", 300);
+            if (empty_sec <= 0) {
+                return;
+            }
+            EmptyAfter = std::chrono::seconds(empty_sec);
+            ProbeInterval = std::chrono::milliseconds(std::max(Config::GetInt("Idle", "ProbeMs", 5000), 100));
+            ServiceLoop::Register("idle probe", ProbeInterval, Probe);
+        }
+
+        bool Active() {
+            return Idle.load(std::memory_order_relaxed);
+        }
+
+    } // namespace IdleMode
+} // namespace BegeerteScript
\ No newline at end of file
@@ -0,0 +1,16 @@
+#pragma once
+
+namespace BegeerteScript {
+
+    // Parks every script while the server has had no players for [Idle] EmptySec seconds. While idle,
+    // the service thread probes the entity list every [Idle] ProbeMs and the first player found brings
+    // the scripts back; the events queued by that probe wake the scripts that handle them.
+    namespace IdleMode {
+        // Registers the probe with the service loop; EmptySec=0 disables idle mode
+        void Init();
+
+        // True while scripts are parked; on_tick skips the tick and its entity list update
+        bool Active();
+    }
+
+} // namespace BegeerteScript
\ No newline at end of file
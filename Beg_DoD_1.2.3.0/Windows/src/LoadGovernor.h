@@ -0,0 +1,19 @@
+#pragma once
+
+// 根据服务器每帧耗时调节插件自身的负载：帧耗时超过目标时逐级降低脚本和实体列表的刷新频率，
+// 服务器恢复后再逐级恢复。RecordFrame 只由引擎 tick 的 detour 调用，未 hook 引擎 tick 时（发布版本
+// 未设置 GAME_ENGINE_TICK）没有帧耗时，Scale() 始终为 1，FrameMs() 始终为 0。
+namespace LoadGovernor {
+    // 读取 [Governor] 配置，TargetFrameMs=0 时不进行调节
+    void Initialize();
+
+    // 游戏线程每帧调用一次，frame_ms 为引擎 tick 本身的耗时
+    void RecordFrame(double frame_ms);
+
+    // 当前降频级别，0 为正常
+    int Level();
+    // 刷新间隔的倍数，级别 n 对应 2^n
+    int Scale();
+    // 平滑后的帧耗时（毫秒），尚无数据时为 0
+    double FrameMs();
+}
\ No newline at end of file
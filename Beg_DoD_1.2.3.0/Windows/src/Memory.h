@@ -1,12 +1,12 @@
-#pragma once
-#include <Windows.h>
-
-namespace Memory {
-    template<typename T>
-    bool Read(DWORD64 address, T& value);
-
-    template<typename T>
-    bool Write(DWORD64 address, T value);
-
-    DWORD64 GetModuleBase(const char* moduleName);
+#pragma once
+#include "Platform.h"
+
+namespace Memory {
+    template<typename T>
+    bool Read(DWORD64 address, T& value);
+
+    template<typename T>
+    bool Write(DWORD64 address, T value);
+
+    DWORD64 GetModuleBase(const char* moduleName);
 }
\ No newline at end of file
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <atomic>
+#include <utility>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+
+namespace BegeerteScript {
+
+    // Bounded lock-free queue for many producers and one consumer. Every cell carries a sequence number
+    // telling whose turn it is, so a producer claims a cell with one compare-exchange on 'tail' and
+    // publishes it with a release store; the consumer never touches a shared counter other than its own.
+    // A full queue rejects the push instead of blocking, and the rejection is counted in Dropped().
+    template<typename T>
+    class MpscQueue {
+    public:
+        // 'capacity' is rounded up to a power of two
+        explicit MpscQueue(size_t capacity) {
+            size_t size = 2;
+            while (size < capacity) {
+                size <<= 1;
+            }
+            mask = size - 1;
+            cells.reset(new Cell[size]);
+            for (size_t i = 0; i < size; ++i) {
+                cells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+        MpscQueue(const MpscQueue&) = delete;
+        MpscQueue& operator=(const MpscQueue&) = delete;
+
+        // Any thread. False (and counted as dropped) when the queue is full.
+        bool TryPush(const T& item) {
+            size_t position = tail.load(std::memory_order_relaxed);
+            while (true) {
+                Cell& cell = cells[position & mask];
+                size_t sequence = cell.sequence.load(std::memory_order_acquire);
+                intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+                if (difference == 0) {
+                    if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                        cell.item = item;
+                        cell.sequence.store(position + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (difference < 0) {
+                    dropped.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                else {
+                    position = tail.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        // Consumer only. False when nothing has been published yet.
+        bool TryPop(T& item) {
+            Cell& cell = cells[head & mask];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            if (sequence != head + 1) {
+                return false;
+            }
+            item = std::move(cell.item);
+            cell.sequence.store(head + mask + 1, std::memory_order_release);
+            head++;
+            return true;
+        }
+
+        // Consumer only
+        bool Empty() const {
+            return cells[head & mask].sequence.load(std::memory_order_acquire) != head + 1;
+        }
+
+        size_t Capacity() const { return mask + 1; }
+        uint64_t Dropped() const { return dropped.load(std::memory_order_relaxed); }
+
+    private:
+        struct Cell {
+            std::atomic<size_t> sequence;
+            T item{};
+        };
+
+        std::unique_ptr<Cell[]> cells;
+        size_t mask = 0;
+        alignas(64) std::atomic<size_t> tail{ 0 };
+        alignas(64) size_t head = 0;
+        std::atomic<uint64_t> dropped{ 0 };
+    };
+
+} // namespace BegeerteScript
\ No newline at end of file
@@ -1,16 +1,22 @@
-#pragma once
-#include <Windows.h>
-#include <vector>
-
-// άָ
-namespace Offset {
-    // ʵб (EntityList) ָɨ
-    namespace EntityList {
-        static constexpr DWORD64 MODULE_OFFSET = 0x07ECC790;                  // ʵбĻַƫ
-        static const std::vector<DWORD64> FIXED_PREFIX_OFFSETS{ 0x38, 0xB0 };   // ǰù̶ƫ
-        static constexpr DWORD64 ENTITY_OFFSET_START = 0x10;                 // ʵƫƷΧ
-        static constexpr DWORD64 ENTITY_OFFSET_END = 0x4000;                  // ʵƫƷΧյ
-        static constexpr DWORD64 ENTITY_OFFSET_STEP = 0x20;                   // ʵƫƲ
-        static const std::vector<DWORD64> FIXED_SUFFIX_OFFSETS{ 0x90, 0x0 };  // ù̶ƫ
-    }
+#pragma once
+#include "Platform.h"
+#include <vector>
+
+// 在这里维护所有指针
+namespace Offset {
+    // 定义实体列表 (EntityList) 的指针扫描参数
+    namespace EntityList {
+        static constexpr DWORD64 MODULE_OFFSET = 0x07ECC790;                  // 实体列表的基址偏移
+        static const std::vector<DWORD64> FIXED_PREFIX_OFFSETS{ 0x38, 0xB0 };   // 前置固定偏移，最后一级指向实体所在的 TArray
+        static constexpr DWORD64 ENTITY_ARRAY_NUM_OFFSET = 0x8;              // TArray 中 Num 相对数据指针的偏移，Max 紧随其后
+        static constexpr DWORD64 ENTITY_OFFSET_START = 0x10;                 // 实体偏移范围起点（第一个元素中实体指针的位置）
+        static constexpr DWORD64 ENTITY_OFFSET_END = 0x4000;                  // 实体偏移范围终点，Num 不可用时扫描整个范围
+        static constexpr DWORD64 ENTITY_OFFSET_STEP = 0x20;                   // 实体偏移步长（TArray 元素大小）
+        static const std::vector<DWORD64> FIXED_SUFFIX_OFFSETS{ 0x90, 0x0 };  // 后置固定偏移
+    }
+
+    // 引擎函数的模块偏移，0 表示尚未定位
+    namespace Engine {
+        static constexpr DWORD64 GAME_ENGINE_TICK = 0x0;                     // UGameEngine::Tick(float DeltaSeconds, bool bIdleMode)
+    }
 }
\ No newline at end of file
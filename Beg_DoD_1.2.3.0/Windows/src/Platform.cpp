@@ -0,0 +1,29 @@
+#include "Platform.h"
+#include <cstdlib>
+#include <system_error>
+
+namespace Platform {
+    std::filesystem::path ExecutableDirectory() {
+#ifdef _WIN32
+        char path_buffer[MAX_PATH];
+        GetModuleFileNameA(NULL, path_buffer, MAX_PATH);
+        return std::filesystem::path(path_buffer).parent_path();
+#else
+        std::error_code error;
+        std::filesystem::path path = std::filesystem::read_symlink("/proc/self/exe", error);
+        return error ? std::filesystem::current_path() : path.parent_path();
+#endif
+    }
+
+    std::string Narrow(const wchar_t* text) {
+        char buffer[256];
+#ifdef _WIN32
+        size_t convertedChars = 0;
+        wcstombs_s(&convertedChars, buffer, sizeof(buffer), text, _TRUNCATE);
+#else
+        size_t convertedChars = std::wcstombs(buffer, text, sizeof(buffer) - 1);
+        buffer[convertedChars == static_cast<size_t>(-1) ? 0 : convertedChars] = '\0';
+#endif
+        return std::string(buffer);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,209 @@
+#include "PlayerEvents.h"
+#include "ScriptScheduler.h"
+#include <unordered_map>
+#include <vector>
+#include <mutex>
+#include <algorithm>
+#include <cstddef>
+
+namespace BegeerteScript {
+    namespace PlayerEvents {
+
+        struct Field {
+            const char* name;
+            size_t offset;
+        };
+
+        // validFlag is left out: it turning valid or invalid is a join or a leave
+        static const Field Fields[] = {
+            { "Character", offsetof(EntityList::Player, Character) },
+            { "Health", offsetof(EntityList::Player, Health) },
+            { "SkinIndex", offsetof(EntityList::Player, SkinIndex) },
+            { "Gender", offsetof(EntityList::Player, Gender) },
+            { "GrowthStage", offsetof(EntityList::Player, GrowthStage) },
+            { "SavedGrowth", offsetof(EntityList::Player, SavedGrowth) },
+            { "VitalityHealth", offsetof(EntityList::Player, VitalityHealth) },
+            { "VitalityArmor", offsetof(EntityList::Player, VitalityArmor) },
+            { "VitalityBile", offsetof(EntityList::Player, VitalityBile) },
+            { "VitalityStamina", offsetof(EntityList::Player, VitalityStamina) },
+            { "VitalityHunger", offsetof(EntityList::Player, VitalityHunger) },
+            { "VitalityThirst", offsetof(EntityList::Player, VitalityThirst) },
+            { "VitalityTorpor", offsetof(EntityList::Player, VitalityTorpor) },
+            { "DamageBite", offsetof(EntityList::Player, DamageBite) },
+            { "DamageProjectile", offsetof(EntityList::Player, DamageProjectile) },
+            { "DamageSwipe", offsetof(EntityList::Player, DamageSwipe) },
+            { "MitigationBlunt", offsetof(EntityList::Player, MitigationBlunt) },
+            { "MitigationPierce", offsetof(EntityList::Player, MitigationPierce) },
+            { "MitigationFire", offsetof(EntityList::Player, MitigationFire) },
+            { "MitigationFrost", offsetof(EntityList::Player, MitigationFrost) },
+            { "MitigationAcid", offsetof(EntityList::Player, MitigationAcid) },
+            { "MitigationVenom", offsetof(EntityList::Player, MitigationVenom) },
+            { "MitigationPlasma", offsetof(EntityList::Player, MitigationPlasma) },
+            { "MitigationElectricity", offsetof(EntityList::Player, MitigationElectricity) },
+            { "OverallQuality", offsetof(EntityList::Player, OverallQuality) },
+        };
+        constexpr int FieldTotal = static_cast<int>(sizeof(Fields) / sizeof(Fields[0]));
+        static_assert(FieldTotal <= 64, "Field masks are 64 bits wide");
+
+        struct PlayerState {
+            EntityList::Player* player = nullptr;
+            uint8_t values[FieldTotal] = {};
+        };
+        using Snapshot = std::vector<PlayerState>; // In entity id order, so events come in that order too
+
+        // ObserveMutex guards the previous snapshot and orders deliveries; Observe, which may run on the game
+        // thread, only ever try-locks it. SubscribersMutex is held just long enough to copy or edit the list.
+        static std::mutex ObserveMutex;
+        static Snapshot Previous; // Stale while nobody is subscribed
+        static std::mutex SubscribersMutex;
+        static std::vector<std::shared_ptr<Subscription>> Subscribers;
+        static std::atomic<size_t> SubscriberCount{ 0 };
+
+        static Snapshot Capture() {
+            Snapshot snapshot;
+            std::vector<EntityList::Player*> players = EntityList::GetValidPlayers(); // One list, even if another thread updates it meanwhile
+            snapshot.reserve(players.size());
+            for (EntityList::Player* player : players) {
+                PlayerState state;
+                state.player = player;
+                const uint8_t* base = reinterpret_cast<const uint8_t*>(player);
+                for (int field = 0; field < FieldTotal; ++field) {
+                    state.values[field] = base[Fields[field].offset];
+                }
+                snapshot.push_back(state);
+            }
+            return snapshot;
+        }
+
+        static void Deliver(const std::vector<PlayerEvent>& events) {
+            std::vector<std::shared_ptr<Subscription>> subscribers;
+            {
+                std::lock_guard<std::mutex> lock(SubscribersMutex);
+                subscribers = Subscribers;
+            }
+            for (const auto& subscription : subscribers) {
+                uint64_t fields = subscription->fields.load(std::memory_order_relaxed);
+                bool queued = false;
+                for (const PlayerEvent& event : events) {
+                    bool wanted = event.kind == PlayerEvent::Kind::Join ? subscription->joins.load(std::memory_order_relaxed) :
+                        event.kind == PlayerEvent::Kind::Leave ? subscription->leaves.load(std::memory_order_relaxed) :
+                        (fields >> event.field) & 1;
+                    if (wanted && subscription->queue.TryPush(event)) {
+                        queued = true;
+                    }
+                }
+                if (queued) {
+                    ScriptScheduler::Shared().Wake(subscription->coroutine);
+                }
+            }
+        }
+
+        void Init() {
+            EntityList::SetUpdateCallback(Observe);
+        }
+
+        void Subscribe(const std::shared_ptr<Subscription>& subscription) {
+            std::lock_guard<std::mutex> observe_lock(ObserveMutex);
+            if (SubscriberCount.load() == 0) {
+                Previous = Capture();
+            }
+            if (subscription->joins) {
+                for (const PlayerState& state : Previous) {
+                    PlayerEvent event;
+                    event.kind = PlayerEvent::Kind::Join;
+                    event.player = state.player;
+                    subscription->queue.TryPush(event);
+                }
+            }
+            {
+                std::lock_guard<std::mutex> lock(SubscribersMutex);
+                Subscribers.push_back(subscription);
+                SubscriberCount = Subscribers.size();
+            }
+            if (!subscription->queue.Empty()) {
+                ScriptScheduler::Shared().Wake(subscription->coroutine);
+            }
+        }
+
+        void Unsubscribe(const Subscription* subscription) {
+            std::lock_guard<std::mutex> lock(SubscribersMutex);
+            std::erase_if(Subscribers, [subscription](const std::shared_ptr<Subscription>& entry) { return entry.get() == subscription; });
+            SubscriberCount = Subscribers.size();
+        }
+
+        void Observe() {
+            if (SubscriberCount.load(std::memory_order_relaxed) == 0) {
+                return;
+            }
+            // Another thread is diffing a newer update; the next one covers whatever this one would have seen
+            std::unique_lock<std::mutex> lock(ObserveMutex, std::try_to_lock);
+            if (!lock.owns_lock()) {
+                return;
+            }
+
+            Snapshot current = Capture();
+            std::unordered_map<EntityList::Player*, const PlayerState*> before;
+            before.reserve(Previous.size());
+            for (const PlayerState& state : Previous) {
+                before.emplace(state.player, &state);
+            }
+
+            std::vector<PlayerEvent> events;
+            for (const PlayerState& state : current) {
+                auto previous = before.find(state.player);
+                if (previous == before.end()) {
+                    PlayerEvent event;
+                    event.kind = PlayerEvent::Kind::Join;
+                    event.player = state.player;
+                    events.push_back(event);
+                    continue;
+                }
+                const PlayerState& old_state = *previous->second;
+                before.erase(previous); // Whatever is left afterwards has left
+                for (int field = 0; field < FieldTotal; ++field) {
+                    if (state.values[field] != old_state.values[field]) {
+                        PlayerEvent event;
+                        event.kind = PlayerEvent::Kind::FieldChanged;
+                        event.player = state.player;
+                        event.field = static_cast<uint8_t>(field);
+                        event.old_value = old_state.values[field];
+                        event.new_value = state.values[field];
+                        events.push_back(event);
+                    }
+                }
+            }
+            for (const PlayerState& state : Previous) {
+                if (before.count(state.player)) {
+                    PlayerEvent event;
+                    event.kind = PlayerEvent::Kind::Leave;
+                    event.player = state.player;
+                    events.push_back(event);
+                }
+            }
+            Previous = std::move(current);
+
+            // Still under the lock, so events from two updates never reach a queue interleaved
+            if (!events.empty()) {
+                Deliver(events);
+            }
+        }
+
+        int FieldIndex(const std::string& name) {
+            for (int field = 0; field < FieldTotal; ++field) {
+                if (name == Fields[field].name) {
+                    return field;
+                }
+            }
+            return -1;
+        }
+
+        const char* FieldName(int index) {
+            return index >= 0 && index < FieldTotal ? Fields[index].name : "";
+        }
+
+        int FieldCount() {
+            return FieldTotal;
+        }
+
+    } // namespace PlayerEvents
+} // namespace BegeerteScript
\ No newline at end of file
@@ -0,0 +1,145 @@
+#include "ScriptChannels.h"
+#include "ScriptScheduler.h"
+#include <map>
+#include <iomanip>
+#include <stdexcept>
+
+namespace BegeerteScript {
+
+    Channel::Channel(const std::string& name, bool any_type, Value::Type type, size_t capacity)
+        : name(name), capacity(capacity), any_type(any_type), type(type), queue(capacity) {}
+
+    bool Channel::Send(const Value& value) {
+        if (!queue.TryPush(value)) {
+            return false;
+        }
+        uint64_t total = sent.fetch_add(1, std::memory_order_relaxed) + 1;
+        size_t depth = static_cast<size_t>(total - received.load(std::memory_order_relaxed));
+        size_t seen = high_water.load(std::memory_order_relaxed);
+        while (depth > seen && !high_water.compare_exchange_weak(seen, depth, std::memory_order_relaxed)) {
+        }
+        // Only costs the scheduler a lookup when the receiver is actually asleep on this channel. The fence
+        // pairs with ArmWakeup: either the receiver sees this value or this sees its request.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (wake_receiver.load(std::memory_order_relaxed) && wake_receiver.exchange(false)) {
+            ScriptScheduler::Shared().Wake(waiting_coroutine.load(std::memory_order_relaxed));
+        }
+        return true;
+    }
+
+    bool Channel::Receive(Value& value) {
+        if (!queue.TryPop(value)) {
+            return false;
+        }
+        received.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    bool Channel::ClaimReceiver(const void* script) {
+        const void* expected = nullptr;
+        return receiver.compare_exchange_strong(expected, script) || expected == script;
+    }
+
+    const char* Channel::TypeName() const {
+        if (any_type) return "any";
+        switch (type) {
+        case Value::Type::BOOL: return "bool";
+        case Value::Type::NUMBER_INT: return "int";
+        case Value::Type::NUMBER_FLOAT: return "float";
+        case Value::Type::STRING: return "string";
+        case Value::Type::PLAYER_PTR: return "player";
+        default: return "?";
+        }
+    }
+
+    size_t Channel::Size() const {
+        uint64_t out = received.load(std::memory_order_relaxed);
+        uint64_t in = sent.load(std::memory_order_relaxed);
+        return in > out ? static_cast<size_t>(in - out) : 0;
+    }
+
+    void Channel::Dump(std::ostream& out) const {
+        out << "  channel " << std::left << std::setw(20) << name << std::right << " " << std::setw(6) << TypeName()
+            << "  " << Size() << "/" << capacity << " queued, peak " << high_water.load(std::memory_order_relaxed)
+            << ", sent " << sent.load(std::memory_order_relaxed) << ", received " << received.load(std::memory_order_relaxed)
+            << ", dropped " << queue.Dropped() << (receiver.load(std::memory_order_relaxed) ? "" : ", no receiver yet") << std::endl;
+    }
+
+    namespace Channels {
+
+        // Only taken to create or look up a name; scripts cache what they get back
+        static std::mutex RegistryMutex;
+        static std::map<std::string, std::shared_ptr<Channel>> ChannelRegistry;
+        static std::map<std::string, std::shared_ptr<SharedSlot>> SlotRegistry;
+
+        bool ParseType(const std::string& name, bool& any_type, Value::Type& type) {
+            any_type = false;
+            if (name == "any") { any_type = true; type = Value::Type::NIL; }
+            else if (name == "int") type = Value::Type::NUMBER_INT;
+            else if (name == "float") type = Value::Type::NUMBER_FLOAT;
+            else if (name == "string") type = Value::Type::STRING;
+            else if (name == "bool") type = Value::Type::BOOL;
+            else if (name == "player") type = Value::Type::PLAYER_PTR;
+            else return false;
+            return true;
+        }
+
+        std::shared_ptr<Channel> Open(const std::string& name, bool any_type, Value::Type type, size_t capacity) {
+            std::lock_guard<std::mutex> lock(RegistryMutex);
+            auto existing = ChannelRegistry.find(name);
+            if (existing != ChannelRegistry.end()) {
+                if (!existing->second->SameType(any_type, type)) {
+                    throw std::runtime_error("Channel '" + name + "' is already open with type " + existing->second->TypeName() + ".");
+                }
+                return existing->second;
+            }
+            auto channel = std::make_shared<Channel>(name, any_type, type, capacity);
+            ChannelRegistry.emplace(name, channel);
+            return channel;
+        }
+
+        std::shared_ptr<Channel> Find(const std::string& name) {
+            std::lock_guard<std::mutex> lock(RegistryMutex);
+            auto existing = ChannelRegistry.find(name);
+            return existing != ChannelRegistry.end() ? existing->second : nullptr;
+        }
+
+        std::shared_ptr<SharedSlot> Slot(const std::string& name) {
+            std::lock_guard<std::mutex> lock(RegistryMutex);
+            auto& slot = SlotRegistry[name];
+            if (!slot) {
+                slot = std::make_shared<SharedSlot>();
+            }
+            return slot;
+        }
+
+        void Publish(SharedSlot& slot, const Value& value) {
+            std::lock_guard<std::mutex> lock(slot.mutex);
+            slot.value = value;
+            slot.version.fetch_add(1, std::memory_order_release);
+        }
+
+        void Read(SharedSlot& slot, SharedView& view) {
+            if (slot.version.load(std::memory_order_acquire) == view.version) {
+                return;
+            }
+            std::lock_guard<std::mutex> lock(slot.mutex);
+            view.value = slot.value;
+            view.version = slot.version.load(std::memory_order_relaxed);
+        }
+
+        void Dump(std::ostream& out) {
+            std::lock_guard<std::mutex> lock(RegistryMutex);
+            out << "[BegeerteChannels] " << ChannelRegistry.size() << " channel(s), " << SlotRegistry.size() << " shared value(s)" << std::endl;
+            for (const auto& [name, channel] : ChannelRegistry) {
+                channel->Dump(out);
+            }
+            for (const auto& [name, slot] : SlotRegistry) {
+                out << "  shared  " << std::left << std::setw(20) << name << std::right << "  published "
+                    << slot->version.load(std::memory_order_relaxed) << "x" << std::endl;
+            }
+        }
+
+    } // namespace Channels
+
+} // namespace BegeerteScript
\ No newline at end of file
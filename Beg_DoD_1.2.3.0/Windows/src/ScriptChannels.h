@@ -0,0 +1,81 @@
+#pragma once
+
+#include "plugins.h"
+#include "MpscQueue.h"
+#include <string>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <ostream>
+#include <cstdint>
+
+namespace BegeerteScript {
+
+    // Named, typed queue from any number of scripts to the one script that receives from it.
+    // Sending never blocks: a full channel rejects the value and counts it as dropped.
+    class Channel {
+    public:
+        Channel(const std::string& name, bool any_type, Value::Type type, size_t capacity);
+
+        // Any thread. False when the channel is full.
+        bool Send(const Value& value);
+        // Receiver only. False when nothing is queued.
+        bool Receive(Value& value);
+        // The first script to receive owns the channel; false if another one already does
+        bool ClaimReceiver(const void* script);
+        // Receiver only: asks the next Send to wake 'coroutine'. Check the channel again before sleeping.
+        void ArmWakeup(uint64_t coroutine) {
+            waiting_coroutine.store(coroutine, std::memory_order_relaxed);
+            wake_receiver.store(true, std::memory_order_seq_cst);
+        }
+        void DisarmWakeup() { wake_receiver.store(false, std::memory_order_relaxed); }
+
+        bool Accepts(const Value& value) const { return any_type || value.GetType() == type; }
+        bool SameType(bool other_any, Value::Type other_type) const { return any_type == other_any && (any_type || type == other_type); }
+        const char* TypeName() const;
+        size_t Size() const;
+
+        const std::string name;
+        const size_t capacity;
+
+        void Dump(std::ostream& out) const;
+
+    private:
+        bool any_type;
+        Value::Type type;
+        MpscQueue<Value> queue;
+        std::atomic<const void*> receiver{ nullptr };
+        std::atomic<uint64_t> waiting_coroutine{ 0 };
+        std::atomic<bool> wake_receiver{ false };
+        std::atomic<uint64_t> sent{ 0 };
+        std::atomic<uint64_t> received{ 0 };
+        std::atomic<size_t> high_water{ 0 };
+    };
+
+    // Value many scripts read and some script occasionally replaces. Readers keep a copy together with
+    // the version it came from, so reading an unchanged value is a single atomic load.
+    struct SharedSlot {
+        std::mutex mutex;  // Held while the value is replaced or copied out
+        Value value;
+        std::atomic<uint64_t> version{ 0 };
+    };
+
+    namespace Channels {
+        // Type names as used by channel_open: int, float, string, bool, player or any. False if unknown.
+        bool ParseType(const std::string& name, bool& any_type, Value::Type& type);
+
+        // Creates the channel or returns the existing one; throws if it exists with another type
+        std::shared_ptr<Channel> Open(const std::string& name, bool any_type, Value::Type type, size_t capacity);
+        // Null if nobody opened it yet
+        std::shared_ptr<Channel> Find(const std::string& name);
+
+        // Creates the slot on first use; it holds nil until something is published
+        std::shared_ptr<SharedSlot> Slot(const std::string& name);
+        void Publish(SharedSlot& slot, const Value& value);
+        // Refreshes 'view' from the slot if the slot changed since 'view' was taken
+        void Read(SharedSlot& slot, SharedView& view);
+
+        void Dump(std::ostream& out);
+    }
+
+} // namespace BegeerteScript
\ No newline at end of file
@@ -0,0 +1,360 @@
+#include "ScriptFileIO.h"
+#include "Config.h"
+#include "ThreadPlacement.h"
+#include <unordered_map>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <algorithm>
+#include <system_error>
+#include <iostream>
+#include <cstring>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fstream>
+#endif
+
+namespace BegeerteScript {
+
+    namespace {
+        struct Request {
+#ifdef _WIN32
+            OVERLAPPED overlapped{}; // Must stay first: completions hand back a pointer to it
+            HANDLE file = INVALID_HANDLE_VALUE;
+            uint64_t offset = 0;     // Next read or write position
+#endif
+            ScriptFileIO::Op op = ScriptFileIO::Op::Read;
+            std::filesystem::path path;
+            std::string key;         // Normalized path, orders requests on the same file
+            std::string data;        // Write/Append: what is left to write
+            size_t max_bytes = SIZE_MAX;
+            ScriptFileIO::Callback done;
+            ScriptFileIO::Result result;
+        };
+
+        // Files with a request in flight, and the requests waiting behind it
+        std::mutex FilesMutex;
+        std::unordered_map<std::string, std::deque<Request*>> BusyFiles;
+
+        void Start(Request* request);
+
+        // Hands the result over, then starts the next request on the same file
+        void Finish(Request* request) {
+            if (request->done) {
+                try {
+                    request->done(request->result);
+                }
+                catch (const std::exception& e) {
+                    std::cerr << "[BegeerteScript] File I/O callback failed: " << e.what() << std::endl;
+                }
+            }
+            else if (!request->result.error.empty()) {
+                std::cerr << "[BegeerteScript] " << request->result.error << std::endl;
+            }
+
+            Request* next = nullptr;
+            {
+                std::lock_guard<std::mutex> lock(FilesMutex);
+                auto busy = BusyFiles.find(request->key);
+                if (busy->second.empty()) {
+                    BusyFiles.erase(busy);
+                }
+                else {
+                    next = busy->second.front();
+                    busy->second.pop_front();
+                }
+            }
+            delete request;
+            if (next) {
+                Start(next);
+            }
+        }
+
+        void Fail(Request* request, const std::string& what) {
+            request->result.error = request->path.filename().string() + ": " + what;
+            Finish(request);
+        }
+
+        // Write and Append create missing parent directories first
+        bool PrepareDirectory(Request* request) {
+            if (request->op == ScriptFileIO::Op::Read || !request->path.has_parent_path()) {
+                return true;
+            }
+            std::error_code error;
+            std::filesystem::create_directories(request->path.parent_path(), error);
+            if (error) {
+                Fail(request, "could not create its directory: " + error.message());
+                return false;
+            }
+            return true;
+        }
+
+        size_t ThreadCount() {
+            // [Scripts] IOThreads: threads that serve file requests, at least one
+            return static_cast<size_t>(std::max(Config::GetInt("Scripts", "IOThreads", 1), 1));
+        }
+
+#ifdef _WIN32
+        // Requests reach the port twice: once posted by Submit to be opened on an I/O thread (CreateFile can
+        // block as well), then as completions of their overlapped reads and writes
+        constexpr ULONG_PTR OpenKey = 1;
+        constexpr ULONG_PTR FileKey = 2;
+        constexpr DWORD ChunkBytes = 1 << 20;
+
+        HANDLE Port = nullptr;
+
+        std::string SystemError(int code) {
+            return std::error_code(code, std::system_category()).message();
+        }
+
+        void Complete(Request* request) {
+            CloseHandle(request->file);
+            request->file = INVALID_HANDLE_VALUE;
+            Finish(request);
+        }
+
+        void FailWith(Request* request, DWORD code, const char* what) {
+            if (request->file != INVALID_HANDLE_VALUE) {
+                CloseHandle(request->file);
+                request->file = INVALID_HANDLE_VALUE;
+            }
+            Fail(request, std::string(what) + ": " + SystemError(static_cast<int>(code)));
+        }
+
+        // Issues the next chunk; its completion comes back through the port even when it finishes at once
+        void Issue(Request* request) {
+            std::memset(&request->overlapped, 0, sizeof(request->overlapped));
+            BOOL ok;
+            if (request->op == ScriptFileIO::Op::Read) {
+                request->overlapped.Offset = static_cast<DWORD>(request->offset);
+                request->overlapped.OffsetHigh = static_cast<DWORD>(request->offset >> 32);
+                DWORD length = static_cast<DWORD>(std::min<size_t>(request->result.data.size() - request->offset, ChunkBytes));
+                ok = ReadFile(request->file, request->result.data.data() + request->offset, length, nullptr, &request->overlapped);
+            }
+            else {
+                if (request->op == ScriptFileIO::Op::Append) {
+                    request->overlapped.Offset = 0xFFFFFFFF; // Write at the current end of the file
+                    request->overlapped.OffsetHigh = 0xFFFFFFFF;
+                }
+                else {
+                    request->overlapped.Offset = static_cast<DWORD>(request->offset);
+                    request->overlapped.OffsetHigh = static_cast<DWORD>(request->offset >> 32);
+                }
+                DWORD length = static_cast<DWORD>(std::min<size_t>(request->data.size() - request->offset, ChunkBytes));
+                ok = WriteFile(request->file, request->data.data() + request->offset, length, nullptr, &request->overlapped);
+            }
+            DWORD error = ok ? ERROR_SUCCESS : GetLastError();
+            if (error == ERROR_HANDLE_EOF) {
+                request->result.data.resize(static_cast<size_t>(request->offset)); // The file shrank since it was opened
+                Complete(request);
+            }
+            else if (error != ERROR_SUCCESS && error != ERROR_IO_PENDING) {
+                FailWith(request, error, request->op == ScriptFileIO::Op::Read ? "read failed" : "write failed");
+            }
+        }
+
+        void Open(Request* request) {
+            if (!PrepareDirectory(request)) {
+                return;
+            }
+            DWORD access = GENERIC_READ, disposition = OPEN_EXISTING;
+            if (request->op == ScriptFileIO::Op::Write) {
+                access = GENERIC_WRITE;
+                disposition = CREATE_ALWAYS;
+            }
+            else if (request->op == ScriptFileIO::Op::Append) {
+                access = FILE_APPEND_DATA;
+                disposition = OPEN_ALWAYS;
+            }
+            request->file = CreateFileW(request->path.c_str(), access, FILE_SHARE_READ, nullptr, disposition,
+                FILE_ATTRIBUTE_NORMAL | FILE_FLAG_OVERLAPPED, nullptr);
+            if (request->file == INVALID_HANDLE_VALUE) {
+                FailWith(request, GetLastError(), "could not open");
+                return;
+            }
+            if (!CreateIoCompletionPort(request->file, Port, FileKey, 0)) {
+                FailWith(request, GetLastError(), "could not attach to the I/O port");
+                return;
+            }
+
+            if (request->op == ScriptFileIO::Op::Read) {
+                LARGE_INTEGER size;
+                if (!GetFileSizeEx(request->file, &size)) {
+                    FailWith(request, GetLastError(), "could not get its size");
+                    return;
+                }
+                if (static_cast<uint64_t>(size.QuadPart) > request->max_bytes) {
+                    CloseHandle(request->file);
+                    request->file = INVALID_HANDLE_VALUE;
+                    Fail(request, std::to_string(size.QuadPart) + " bytes is larger than the " + std::to_string(request->max_bytes) + " bytes allowed");
+                    return;
+                }
+                request->result.data.resize(static_cast<size_t>(size.QuadPart));
+                if (request->result.data.empty()) {
+                    Complete(request);
+                    return;
+                }
+            }
+            else if (request->data.empty()) {
+                Complete(request);
+                return;
+            }
+            Issue(request);
+        }
+
+        void Completed(Request* request, DWORD transferred, BOOL ok) {
+            if (!ok) {
+                DWORD error = GetLastError();
+                if (error == ERROR_HANDLE_EOF) {
+                    request->result.data.resize(static_cast<size_t>(request->offset));
+                    Complete(request);
+                }
+                else {
+                    FailWith(request, error, request->op == ScriptFileIO::Op::Read ? "read failed" : "write failed");
+                }
+                return;
+            }
+            request->offset += transferred;
+            request->result.bytes += transferred;
+            size_t total = request->op == ScriptFileIO::Op::Read ? request->result.data.size() : request->data.size();
+            if (transferred == 0 && request->op == ScriptFileIO::Op::Read) {
+                request->result.data.resize(static_cast<size_t>(request->offset));
+                Complete(request);
+            }
+            else if (request->offset < total) {
+                Issue(request);
+            }
+            else {
+                Complete(request);
+            }
+        }
+
+        void IOThread(size_t index) {
+            ThreadPlacement::Apply("IO", index);
+            while (true) {
+                DWORD transferred = 0;
+                ULONG_PTR key = 0;
+                OVERLAPPED* overlapped = nullptr;
+                BOOL ok = GetQueuedCompletionStatus(Port, &transferred, &key, &overlapped, INFINITE);
+                if (!overlapped) {
+                    continue; // The wait itself failed, no request involved
+                }
+                Request* request = reinterpret_cast<Request*>(overlapped);
+                if (key == OpenKey) {
+                    Open(request);
+                }
+                else {
+                    Completed(request, transferred, ok);
+                }
+            }
+        }
+
+        void Start(Request* request) {
+            static const bool started = [] {
+                size_t count = ThreadCount();
+                Port = CreateIoCompletionPort(INVALID_HANDLE_VALUE, nullptr, 0, static_cast<DWORD>(count));
+                if (Port) {
+                    for (size_t i = 0; i < count; ++i) {
+                        std::thread(IOThread, i).detach();
+                    }
+                }
+                return Port != nullptr;
+                }();
+            if (!started || !PostQueuedCompletionStatus(Port, 0, OpenKey, &request->overlapped)) {
+                Fail(request, "the I/O completion port is not available");
+            }
+        }
+#else
+        // No completion port here: a few threads do the same work with blocking calls
+        std::mutex QueueMutex;
+        std::condition_variable QueueReady;
+        std::deque<Request*> Queue;
+
+        void Run(Request* request) {
+            if (!PrepareDirectory(request)) {
+                return;
+            }
+            if (request->op == ScriptFileIO::Op::Read) {
+                std::ifstream file(request->path, std::ios::binary | std::ios::ate);
+                if (!file.is_open()) {
+                    Fail(request, "could not open: " + std::string(std::strerror(errno)));
+                    return;
+                }
+                uint64_t size = static_cast<uint64_t>(file.tellg());
+                if (size > request->max_bytes) {
+                    Fail(request, std::to_string(size) + " bytes is larger than the " + std::to_string(request->max_bytes) + " bytes allowed");
+                    return;
+                }
+                request->result.data.resize(static_cast<size_t>(size));
+                file.seekg(0);
+                file.read(request->result.data.data(), static_cast<std::streamsize>(size));
+                request->result.data.resize(static_cast<size_t>(file.gcount()));
+                request->result.bytes = request->result.data.size();
+            }
+            else {
+                std::ofstream file(request->path, std::ios::binary | (request->op == ScriptFileIO::Op::Append ? std::ios::app : std::ios::trunc));
+                if (!file.is_open() || !file.write(request->data.data(), static_cast<std::streamsize>(request->data.size())).flush()) {
+                    Fail(request, "write failed: " + std::string(std::strerror(errno)));
+                    return;
+                }
+                request->result.bytes = request->data.size();
+            }
+            Finish(request);
+        }
+
+        void IOThread(size_t index) {
+            ThreadPlacement::Apply("IO", index);
+            while (true) {
+                Request* request;
+                {
+                    std::unique_lock<std::mutex> lock(QueueMutex);
+                    QueueReady.wait(lock, [] { return !Queue.empty(); });
+                    request = Queue.front();
+                    Queue.pop_front();
+                }
+                Run(request);
+            }
+        }
+
+        void Start(Request* request) {
+            static const bool started = [] {
+                for (size_t i = 0, count = ThreadCount(); i < count; ++i) {
+                    std::thread(IOThread, i).detach();
+                }
+                return true;
+                }();
+            (void)started;
+            {
+                std::lock_guard<std::mutex> lock(QueueMutex);
+                Queue.push_back(request);
+            }
+            QueueReady.notify_one();
+        }
+#endif
+    }
+
+    void ScriptFileIO::Submit(Op op, const std::filesystem::path& path, std::string data, Callback done, size_t max_bytes) {
+        auto* request = new Request();
+        request->op = op;
+        request->path = path;
+        request->key = path.lexically_normal().string();
+        request->data = std::move(data);
+        request->max_bytes = max_bytes;
+        request->done = std::move(done);
+
+        {
+            std::lock_guard<std::mutex> lock(FilesMutex);
+            auto busy = BusyFiles.find(request->key);
+            if (busy != BusyFiles.end()) {
+                busy->second.push_back(request); // Starts when the one ahead of it finishes
+                return;
+            }
+            BusyFiles.emplace(request->key, std::deque<Request*>());
+        }
+        Start(request);
+    }
+
+} // namespace BegeerteScript
\ No newline at end of file
@@ -0,0 +1,32 @@
+#pragma once
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+namespace BegeerteScript {
+
+    // Background file I/O for scripts and the script log. Requests go to dedicated I/O threads (an I/O
+    // completion port with overlapped reads and writes on Windows, a small blocking thread pool elsewhere), so
+    // the caller never waits for the disk. Requests on the same file run one at a time in submission order;
+    // requests on different files overlap.
+    class ScriptFileIO {
+    public:
+        enum class Op { Read, Write, Append };
+
+        struct Result {
+            std::string data;   // Read: the file's contents
+            size_t bytes = 0;   // Bytes read or written
+            std::string error;  // Empty on success
+        };
+
+        // Runs on an I/O thread once the request is done, so it must only hand the result over
+        using Callback = std::function<void(Result&)>;
+
+        // Write replaces the file, Append adds to its end; both create it and its missing parent directories.
+        // Reads of files larger than 'max_bytes' fail without loading them.
+        static void Submit(Op op, const std::filesystem::path& path, std::string data, Callback done, size_t max_bytes = SIZE_MAX);
+    };
+
+} // namespace BegeerteScript
\ No newline at end of file
@@ -0,0 +1,162 @@
+#include "ScriptHost.h"
+#include "SnapshotChannel.h"
+#include "EntityList.h"
+#include "Hook.h"
+#include "ServiceLoop.h"
+#include "Config.h"
+#include "Platform.h"
+#include <Windows.h>
+#include <iostream>
+#include <filesystem>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+
+namespace BegeerteScript {
+    namespace ScriptHost {
+
+        static_assert(sizeof(EntityList::Player) <= SnapshotChannel::EntityBytes, "EntityList::Player does not fit in a snapshot entity");
+
+        using Clock = std::chrono::steady_clock;
+
+        static std::unique_ptr<SnapshotChannel> Channel;
+        static std::string ChannelName;
+        static std::atomic<uint64_t> AppliedWrites{ 0 };
+        static std::atomic<uint64_t> DroppedWrites{ 0 };
+
+        // Only touched by the watch service
+        static std::string HostPath;
+        static bool AutoStart = false;
+        static std::chrono::milliseconds Timeout{ 5000 };
+        static std::chrono::milliseconds RestartDelay{ 5000 };
+        static PROCESS_INFORMATION Process = {};
+        static Clock::time_point NextLaunch;
+        static uint64_t LastHeartbeat = 0;
+        static Clock::time_point LastBeat;
+        static bool Attached = false;
+
+        // Game thread, after every server tick: the host sees the same entity list in-process scripts would
+        static void PublishTick(double) {
+            EntityList::Update();
+            // Held for the whole tick, so the list cannot change under the loops below even if another thread updates it
+            EntityList::Entities published = EntityList::GetAllEntities();
+            const std::vector<DWORD64>& entities = *published;
+
+            // Writes were made against an earlier snapshot. The slot is only a hint, the address decides.
+            SnapshotChannel::Write write;
+            while (Channel->PopWrite(write)) {
+                bool known = write.slot < entities.size() && entities[write.slot] == write.address;
+                if (!known) {
+                    known = std::find(entities.begin(), entities.end(), write.address) != entities.end();
+                }
+                if (!known || write.offset >= sizeof(EntityList::Player)) {
+                    DroppedWrites.fetch_add(1, std::memory_order_relaxed);
+                    continue;
+                }
+                *reinterpret_cast<byte*>(write.address + write.offset) = write.value;
+                AppliedWrites.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            // Published after the writes, so the host reads back what it wrote
+            uint32_t count = static_cast<uint32_t>(std::min<size_t>(entities.size(), SnapshotChannel::MaxEntities));
+            SnapshotChannel::Entity* out = Channel->BeginPublish();
+            for (uint32_t i = 0; i < count; ++i) {
+                out[i].address = entities[i];
+                std::memcpy(out[i].bytes, reinterpret_cast<const void*>(entities[i]), sizeof(EntityList::Player));
+            }
+            Channel->EndPublish(count);
+        }
+
+        static void Launch() {
+            STARTUPINFOA startup = { sizeof(startup) };
+            std::string command = "\"" + HostPath + "\" " + ChannelName;
+            std::string directory = std::filesystem::path(HostPath).parent_path().string();
+            if (!CreateProcessA(HostPath.c_str(), command.data(), nullptr, nullptr, FALSE, 0, nullptr, directory.c_str(), &startup, &Process)) {
+                std::cerr << "[BegeerteHost] Could not start " << HostPath << " (error " << GetLastError() << "), retrying in "
+                    << RestartDelay.count() << " ms." << std::endl;
+                Process = {};
+                NextLaunch = Clock::now() + RestartDelay;
+                return;
+            }
+            CloseHandle(Process.hThread);
+            LastBeat = Clock::now(); // Give it the full timeout to attach
+            std::cout << "[BegeerteHost] Started BegHost (pid " << Process.dwProcessId << ")." << std::endl;
+        }
+
+        // Service thread: tracks the host's heartbeat and, with AutoStart, keeps a host process running
+        static void Watch() {
+            auto now = Clock::now();
+            uint64_t beat = Channel->HostHeartbeat();
+            bool stalled = false;
+            if (beat != LastHeartbeat) {
+                LastHeartbeat = beat;
+                LastBeat = now;
+                if (!Attached) {
+                    Attached = true;
+                    std::cout << "[BegeerteHost] Script host attached." << std::endl;
+                }
+            }
+            else if (now - LastBeat >= Timeout) {
+                stalled = true;
+                if (Attached) {
+                    Attached = false;
+                    std::cout << "[BegeerteHost] Script host stopped responding (" << AppliedWrites.load() << " writes applied, "
+                        << DroppedWrites.load() << " dropped so far)." << std::endl;
+                }
+            }
+
+            if (!AutoStart) {
+                return;
+            }
+            if (Process.hProcess) {
+                if (WaitForSingleObject(Process.hProcess, 0) != WAIT_OBJECT_0) {
+                    if (!stalled) {
+                        return;
+                    }
+                    // Alive but silent: the main loop is stuck, so the scripts are as good as gone
+                    std::cerr << "[BegeerteHost] BegHost has not responded for " << Timeout.count() << " ms, terminating it." << std::endl;
+                    TerminateProcess(Process.hProcess, 1);
+                    WaitForSingleObject(Process.hProcess, 1000);
+                }
+                DWORD code = 0;
+                GetExitCodeProcess(Process.hProcess, &code);
+                CloseHandle(Process.hProcess);
+                Process = {};
+                Attached = false;
+                NextLaunch = now + RestartDelay;
+                std::cerr << "[BegeerteHost] BegHost exited with code 0x" << std::hex << code << std::dec << ", restarting in "
+                    << RestartDelay.count() << " ms." << std::endl;
+                return;
+            }
+            if (now >= NextLaunch) {
+                Launch();
+            }
+        }
+
+        bool Start() {
+            if (Config::GetInt("Host", "OutOfProcess", 0) == 0) {
+                return false;
+            }
+            ChannelName = Config::GetString("Host", "Channel", "BegeerteSnapshot");
+            Channel = SnapshotChannel::Create(ChannelName);
+            if (!Channel) {
+                std::cerr << "[BegeerteHost] Could not create the shared memory '" << ChannelName << "', running scripts in-process." << std::endl;
+                return false;
+            }
+
+            // BegHost sits next to the server executable, so it finds the same Begeerte.ini and Scripts folder
+            HostPath = (Platform::ExecutableDirectory() / "BegHost.exe").string();
+            AutoStart = Config::GetInt("Host", "AutoStart", 1) != 0;
+            Timeout = std::chrono::milliseconds(std::max(Config::GetInt("Host", "TimeoutMs", 5000), 1000));
+            RestartDelay = std::chrono::milliseconds(std::max(Config::GetInt("Host", "RestartDelayMs", 5000), 0));
+
+            Hook::SetTickCallback(PublishTick);
+            ServiceLoop::Register("script host", std::chrono::milliseconds(1000), Watch);
+            std::cout << "[BegeerteHost] Scripts run out of process, publishing the entity list to '" << ChannelName << "'"
+                << (AutoStart ? " and starting " + HostPath : std::string()) << "." << std::endl;
+            return true;
+        }
+
+    } // namespace ScriptHost
+} // namespace BegeerteScript
\ No newline at end of file
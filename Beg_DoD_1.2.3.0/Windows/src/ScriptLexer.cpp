@@ -0,0 +1,152 @@
+#include "ScriptLexer.h"
+#include <iostream>
+#include <stdexcept>
+#include <cctype>
+
+namespace BegeerteScript::Lexer {
+
+    static void SyntaxError(const std::string& message, const std::string& script_path, size_t line_number) {
+        std::cerr << "Syntax Error in '" << script_path << "'";
+        if (line_number > 0) {
+            std::cerr << " (Line " << line_number << ")";
+        }
+        std::cerr << ": " << message << std::endl;
+        throw std::runtime_error("Syntax error occurred."); // Stop execution
+    }
+
+    // Very basic tokenizer
+    std::vector<Token> Tokenize(const std::string& script_content, const std::string& script_path) {
+        std::vector<Token> tokens;
+        std::string current_token_text;
+        size_t line_number = 1;
+
+        for (size_t i = 0; i < script_content.length(); ++i) {
+            char c = script_content[i];
+
+            if (c == '\n') {
+                line_number++;
+                tokens.push_back({ Token::Type::END_OF_LINE, ";", line_number - 1 }); // Treat newline as EOL/semicolon
+                continue;
+            }
+            if (std::isspace(c)) continue; // Skip whitespace
+
+            // Comments
+            if (c == '/' && i + 1 < script_content.length()) {
+                if (script_content[i + 1] == '/') { // Single line comment
+                    while (i < script_content.length() && script_content[i] != '\n') {
+                        i++;
+                    }
+                    if (i < script_content.length() && script_content[i] == '\n') line_number++;
+                    tokens.push_back({ Token::Type::END_OF_LINE, ";", line_number - 1 });
+                    continue;
+                }
+                else if (script_content[i + 1] == '*') { // Multi-line comment
+                    i += 2;
+                    while (i + 1 < script_content.length() && !(script_content[i] == '*' && script_content[i + 1] == '/')) {
+                        if (script_content[i] == '\n') line_number++;
+                        i++;
+                    }
+                    i++; // Skip the final '/'
+                    continue;
+                }
+            }
+
+            // Operators and special characters
+            if (std::string("=(){},;+-*/%&|!<>").find(c) != std::string::npos) {
+                if (c == '=' && i + 1 < script_content.length() && script_content[i + 1] == '=') { // ==
+                    tokens.push_back({ Token::Type::OPERATOR, "==", line_number });
+                    i++;
+                }
+                else if (c == '!' && i + 1 < script_content.length() && script_content[i + 1] == '=') { // !=
+                    tokens.push_back({ Token::Type::OPERATOR, "!=", line_number });
+                    i++;
+                }
+                else if (c == '<' && i + 1 < script_content.length() && script_content[i + 1] == '=') { // <=
+                    tokens.push_back({ Token::Type::OPERATOR, "<=", line_number });
+                    i++;
+                }
+                else if (c == '>' && i + 1 < script_content.length() && script_content[i + 1] == '=') { // >=
+                    tokens.push_back({ Token::Type::OPERATOR, ">=", line_number });
+                    i++;
+                }
+                else if (c == '&' && i + 1 < script_content.length() && script_content[i + 1] == '&') { // &&
+                    tokens.push_back({ Token::Type::OPERATOR, "&&", line_number });
+                    i++;
+                }
+                else if (c == '|' && i + 1 < script_content.length() && script_content[i + 1] == '|') { // ||
+                    tokens.push_back({ Token::Type::OPERATOR, "||", line_number });
+                    i++;
+                }
+                else {
+                    tokens.push_back({ Token::Type::OPERATOR, std::string(1, c), line_number });
+                }
+                continue;
+            }
+
+            // Identifiers (and keywords)
+            if (std::isalpha(c) || c == '_') {
+                current_token_text = c;
+                while (i + 1 < script_content.length() && (std::isalnum(script_content[i + 1]) || script_content[i + 1] == '_')) {
+                    current_token_text += script_content[++i];
+                }
+                if (current_token_text == "let" || current_token_text == "if" || current_token_text == "else" ||
+                    current_token_text == "while" || current_token_text == "true" || current_token_text == "false" ||
+                    current_token_text == "nil" || current_token_text == "import" || current_token_text == "function" ||
+                    current_token_text == "return" || current_token_text == "for" || current_token_text == "in" ||
+                    current_token_text == "parallel") {
+                    tokens.push_back({ Token::Type::KEYWORD, current_token_text, line_number });
+                }
+                else {
+                    tokens.push_back({ Token::Type::IDENTIFIER, current_token_text, line_number });
+                }
+                continue;
+            }
+
+            // Numbers (integer and float)
+            if (std::isdigit(c) || (c == '.' && i + 1 < script_content.length() && std::isdigit(script_content[i + 1]))) {
+                current_token_text = c;
+                bool has_decimal = (c == '.');
+                while (i + 1 < script_content.length() && (std::isdigit(script_content[i + 1]) || (!has_decimal && script_content[i + 1] == '.'))) {
+                    current_token_text += script_content[++i];
+                    if (script_content[i] == '.') has_decimal = true;
+                }
+                tokens.push_back({ Token::Type::NUMBER, current_token_text, line_number });
+                continue;
+            }
+
+            // Strings
+            if (c == '"') {
+                current_token_text = ""; // Don't include quotes in value
+                i++; // Skip opening quote
+                while (i < script_content.length() && script_content[i] != '"') {
+                    if (script_content[i] == '\\' && i + 1 < script_content.length()) { // Handle escape sequences (basic)
+                        i++;
+                        switch (script_content[i]) {
+                        case 'n': current_token_text += '\n'; break;
+                        case 't': current_token_text += '\t'; break;
+                        case '"': current_token_text += '"'; break;
+                        case '\\': current_token_text += '\\'; break;
+                        default: current_token_text += script_content[i]; // Add char as is
+                        }
+                    }
+                    else {
+                        current_token_text += script_content[i];
+                    }
+                    if (script_content[i] == '\n') line_number++; // String can span lines
+                    i++;
+                }
+                if (i == script_content.length()) { // Unterminated string
+                    SyntaxError("Unterminated string literal", script_path, line_number);
+                }
+                tokens.push_back({ Token::Type::STRING, current_token_text, line_number });
+                continue;
+            }
+
+            SyntaxError("Unexpected character: " + std::string(1, c), script_path, line_number);
+            tokens.push_back({ Token::Type::UNKNOWN, std::string(1,c), line_number }); // Should be caught by SyntaxError
+        }
+        tokens.push_back({ Token::Type::END_OF_FILE, "", line_number });
+        return tokens;
+    }
+
+} // namespace BegeerteScript::Lexer
\ No newline at end of file
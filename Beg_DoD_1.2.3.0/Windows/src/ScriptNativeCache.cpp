@@ -0,0 +1,113 @@
+#include "plugins.h"
+#include <atomic>
+#include <mutex>
+
+namespace BegeerteScript {
+
+    // --- NativeTraits ---
+    NativeTraits NativeTraits::TickStable(const std::string& group) {
+        return { NativeKind::TickStable, NativeGroups::Id(group) };
+    }
+
+    NativeTraits NativeTraits::Mutating(const std::string& group) {
+        return { NativeKind::Mutating, NativeGroups::Id(group) };
+    }
+
+    // --- NativeGroups ---
+    namespace NativeGroups {
+        // Groups are only created while natives are registered, so a small fixed table is enough
+        static constexpr int MaxGroups = 64;
+        static std::atomic<uint32_t> Versions[MaxGroups];
+        static std::map<std::string, int> Names;
+        static std::mutex NamesMutex;
+
+        int Id(const std::string& group) {
+            if (group.empty()) {
+                return -1;
+            }
+            std::lock_guard<std::mutex> lock(NamesMutex);
+            auto it = Names.find(group);
+            if (it != Names.end()) {
+                return it->second;
+            }
+            if (Names.size() >= MaxGroups) {
+                throw std::runtime_error("Too many native cache groups (max " + std::to_string(MaxGroups) + ").");
+            }
+            int id = static_cast<int>(Names.size());
+            Names[group] = id;
+            return id;
+        }
+
+        uint32_t Version(int group) {
+            return group < 0 ? 0 : Versions[group].load(std::memory_order_acquire);
+        }
+
+        void Invalidate(int group) {
+            if (group >= 0) {
+                Versions[group].fetch_add(1, std::memory_order_acq_rel);
+            }
+        }
+    }
+
+    // --- NativeResultCache ---
+    static size_t HashValue(const Value& value) {
+        size_t type_hash = static_cast<size_t>(value.type) * 0x9E3779B97F4A7C15ull;
+        switch (value.type) {
+        case Value::Type::BOOL: return type_hash ^ std::hash<bool>()(std::get<bool>(value.value));
+        case Value::Type::NUMBER_INT: return type_hash ^ std::hash<long long>()(std::get<long long>(value.value));
+        case Value::Type::NUMBER_FLOAT: return type_hash ^ std::hash<double>()(std::get<double>(value.value));
+        case Value::Type::STRING: return type_hash ^ std::hash<std::string>()(std::get<std::string>(value.value));
+        case Value::Type::PLAYER_PTR: return type_hash ^ std::hash<const void*>()(std::get<EntityList::Player*>(value.value));
+        default: return type_hash;
+        }
+    }
+
+    static size_t HashArgs(const ArgList& args) {
+        size_t hash = args.size();
+        for (const auto& arg : args) {
+            hash = hash * 31 + HashValue(arg);
+        }
+        return hash;
+    }
+
+    static bool SameArgs(const ArgList& a, const ArgList& b) {
+        if (a.size() != b.size()) return false;
+        for (size_t i = 0; i < a.size(); ++i) {
+            if (a[i].type != b[i].type || a[i].value != b[i].value) return false;
+        }
+        return true;
+    }
+
+    const Value* NativeResultCache::Find(const void* call_site, const ArgList& args, const NativeTraits& traits) {
+        if (!enabled) {
+            return nullptr;
+        }
+
+        unsigned long long current = EntityList::GetUpdateEpoch();
+        if (current != epoch) {
+            std::erase_if(entries, [](const auto& entry) { return entry.second.kind == NativeKind::TickStable; });
+            epoch = current;
+        }
+
+        auto it = entries.find(Key{ call_site, HashArgs(args) });
+        if (it == entries.end() || it->second.group_version != NativeGroups::Version(traits.group) ||
+            !SameArgs(it->second.args, args)) {
+            misses++;
+            return nullptr;
+        }
+        hits++;
+        return &it->second.result;
+    }
+
+    void NativeResultCache::Store(const void* call_site, const ArgList& args, NativeKind kind, uint32_t group_version, const Value& result) {
+        if (!enabled) {
+            return;
+        }
+        if (entries.size() >= MaxEntries) {
+            entries.clear();
+        }
+        Key key{ call_site, HashArgs(args) };
+        entries.insert_or_assign(key, Entry{ ArgList(args.begin(), args.end(), entries.get_allocator().resource()), result, kind, group_version });
+    }
+
+} // namespace BegeerteScript
\ No newline at end of file
@@ -0,0 +1,639 @@
+#include "ScriptScheduler.h"
+#include "Config.h"
+#include "ThreadPlacement.h"
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <ucontext.h>
+#endif
+
+namespace BegeerteScript {
+
+    struct ScriptScheduler::Coroutine {
+        uint64_t id = 0;
+        std::string name;
+        std::function<void()> body;
+        Worker* worker = nullptr;
+
+        // Guarded by worker->mutex; read by Snapshot()
+        State state = State::Ready;
+        Priority priority = Priority::Normal;
+        Clock::duration deadline{};  // 0: the class default
+        Clock::time_point ready_since; // When it last became ready, its deadline counts from here
+        Clock::time_point wake_time;
+        uint64_t switches = 0;
+        uint64_t preempted = 0;
+        Clock::duration cpu{};
+        bool wakeable = false;       // Sleeping in SleepUntilWoken
+        bool wake_requested = false; // Wake() came while it was not in SleepUntilWoken
+
+        // Written by the coroutine itself right before it switches back to its worker
+        State next_state = State::Ready;
+        Clock::time_point next_wake_time;
+        bool next_forced = false;
+        bool next_wakeable = false;
+
+        // Only touched by the coroutine itself
+        uint64_t pauses = 0;
+
+#ifdef _WIN32
+        LPVOID fiber = nullptr;
+#else
+        ucontext_t context;
+        std::unique_ptr<char[]> stack;
+#endif
+    };
+
+    struct ScriptScheduler::Worker {
+        size_t index = 0;
+        ScriptScheduler* owner = nullptr;
+        std::thread thread;
+
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::deque<Coroutine*> ready;
+        std::vector<Coroutine*> sleeping; // Min-heap on wake_time
+        std::vector<std::unique_ptr<Coroutine>> owned;
+
+        // Per-tick CPU use of each class, reset when the tick changes; guarded by mutex
+        uint64_t budget_tick = 0;
+        Clock::duration used[PriorityCount]{};
+        ClassStats classes[PriorityCount];
+
+        // Only touched by the worker thread and the coroutine it is running
+        Coroutine* running = nullptr;
+        Clock::time_point slice_start;
+        uint32_t back_edges = 0;
+        bool preemption_held = false;
+#ifdef _WIN32
+        LPVOID main_fiber = nullptr;
+#else
+        ucontext_t main_context;
+#endif
+    };
+
+    thread_local ScriptScheduler::Worker* ScriptScheduler::current_worker = nullptr;
+    std::atomic<bool> ScriptScheduler::virtual_time{ false };
+    std::atomic<ScriptScheduler::Clock::rep> ScriptScheduler::virtual_now{ 0 };
+
+    ScriptScheduler::ScriptScheduler(size_t worker_count, std::chrono::milliseconds tick, size_t stack_bytes)
+        : tick_length(tick.count() > 0 ? tick : std::chrono::milliseconds(1)), start_time(Clock::now()), stack_size(stack_bytes) {
+        for (size_t i = 0; i < std::max<size_t>(worker_count, 1); ++i) {
+            auto worker = std::make_unique<Worker>();
+            worker->index = i;
+            worker->owner = this;
+            workers.push_back(std::move(worker));
+        }
+        for (auto& worker : workers) {
+            worker->thread = std::thread(&ScriptScheduler::WorkerMain, this, std::ref(*worker));
+        }
+    }
+
+    ScriptScheduler::~ScriptScheduler() {
+        stopping = true;
+        for (auto& worker : workers) {
+            {
+                std::lock_guard<std::mutex> lock(worker->mutex);
+            }
+            worker->wake.notify_all();
+        }
+        for (auto& worker : workers) {
+            worker->thread.join();
+#ifdef _WIN32
+            for (auto& coroutine : worker->owned) {
+                if (coroutine->fiber) DeleteFiber(coroutine->fiber);
+            }
+#endif
+        }
+    }
+
+    ScriptScheduler& ScriptScheduler::Shared() {
+        // Never destroyed: suspended scripts cannot be unwound safely while the process tears down
+        static ScriptScheduler* scheduler = [] {
+            // Virtual time only stays reproducible when one thread decides when it may move forward
+            bool simulate = Config::GetInt("Scripts", "VirtualTime", 0) != 0;
+            int threads = simulate ? 1 : Config::GetInt("Scripts", "SchedulerThreads", 2);
+            int tick_ms = Config::GetInt("Scripts", "TickMs", 50);
+            int stack_kb = Config::GetInt("Scripts", "FiberStackKB", 1024);
+            auto* created = new ScriptScheduler(threads > 0 ? static_cast<size_t>(threads) : 1,
+                std::chrono::milliseconds(tick_ms), static_cast<size_t>(std::max(stack_kb, 64)) * 1024);
+            created->slice = std::chrono::milliseconds(std::max(Config::GetInt("Scripts", "SliceMs", 10), 1));
+            const char* deadline_keys[PriorityCount] = { "CriticalDeadlineMs", "NormalDeadlineMs", "BatchDeadlineMs" };
+            for (size_t i = 0; i < PriorityCount; ++i) {
+                int deadline_ms = Config::GetInt("Scripts", deadline_keys[i], static_cast<int>(created->default_deadline[i].count()));
+                created->default_deadline[i] = std::chrono::milliseconds(std::max(deadline_ms, 1));
+            }
+            created->budget_percent[0] = std::clamp(Config::GetInt("Scripts", "CriticalBudgetPct", created->budget_percent[0]), 0, 100);
+            created->budget_percent[1] = std::clamp(Config::GetInt("Scripts", "NormalBudgetPct", created->budget_percent[1]), 0, 100);
+            if (simulate) {
+                created->virtual_limit = std::chrono::seconds(std::max(Config::GetInt("Scripts", "VirtualTimeLimitSec", 0), 0));
+                created->virtual_started = Clock::now();
+                // Start on a whole millisecond so millisecond timers land exactly on their due time
+                Clock::time_point first = std::chrono::ceil<std::chrono::milliseconds>(created->start_time);
+                virtual_now.store(first.time_since_epoch().count());
+                virtual_time.store(true);
+                std::cout << "[BegeerteScheduler] Running on virtual time, scripts see simulated time advance as fast as they allow" << std::endl;
+            }
+            std::cout << "[BegeerteScheduler] " << created->WorkerCount() << " worker thread(s), tick " << tick_ms << " ms" << std::endl;
+            return created;
+            }();
+        return *scheduler;
+    }
+
+    uint64_t ScriptScheduler::Spawn(const std::string& name, std::function<void()> body) {
+        auto coroutine = std::make_unique<Coroutine>();
+        coroutine->id = next_id++;
+        coroutine->name = name;
+        coroutine->body = std::move(body);
+
+#ifdef _WIN32
+        coroutine->fiber = CreateFiberEx(64 * 1024, stack_size, FIBER_FLAG_FLOAT_SWITCH,
+            [](LPVOID param) { CoroutineEntry(static_cast<Coroutine*>(param)); }, coroutine.get());
+        if (!coroutine->fiber) {
+            throw std::runtime_error("CreateFiberEx failed for script '" + name + "'.");
+        }
+#else
+        coroutine->stack.reset(new char[stack_size]);
+        getcontext(&coroutine->context);
+        coroutine->context.uc_stack.ss_sp = coroutine->stack.get();
+        coroutine->context.uc_stack.ss_size = stack_size;
+        coroutine->context.uc_link = nullptr;
+        // makecontext only passes ints; the entry picks the coroutine up from its worker instead
+        makecontext(&coroutine->context, reinterpret_cast<void (*)()>(+[] { CoroutineEntry(current_worker->running); }), 0);
+#endif
+
+        // Least loaded worker; the coroutine stays there for its whole life
+        Worker* target = workers.front().get();
+        size_t target_load = SIZE_MAX;
+        for (auto& worker : workers) {
+            std::lock_guard<std::mutex> lock(worker->mutex);
+            if (worker->owned.size() < target_load) {
+                target = worker.get();
+                target_load = worker->owned.size();
+            }
+        }
+
+        uint64_t id = coroutine->id;
+        coroutine->worker = target;
+        {
+            std::lock_guard<std::mutex> lock(target->mutex);
+            MakeReady(*target, coroutine.get(), Now());
+            target->owned.push_back(std::move(coroutine));
+        }
+        target->wake.notify_one();
+        return id;
+    }
+
+    bool ScriptScheduler::Wake(uint64_t id) {
+        auto later = [](const Coroutine* a, const Coroutine* b) { return a->wake_time > b->wake_time; };
+        for (auto& worker : workers) {
+            std::unique_lock<std::mutex> lock(worker->mutex);
+            auto owned = std::find_if(worker->owned.begin(), worker->owned.end(),
+                [id](const std::unique_ptr<Coroutine>& coroutine) { return coroutine->id == id; });
+            if (owned == worker->owned.end()) {
+                continue;
+            }
+            Coroutine* coroutine = owned->get();
+            if (coroutine->state != State::Sleeping || !coroutine->wakeable) {
+                coroutine->wake_requested = true; // Picked up by its next SleepUntilWoken
+                return true;
+            }
+            // Pull it out of the sleeping heap; its wake time was the only thing keeping it there
+            std::erase(worker->sleeping, coroutine);
+            std::make_heap(worker->sleeping.begin(), worker->sleeping.end(), later);
+            MakeReady(*worker, coroutine, Now());
+            lock.unlock();
+            worker->wake.notify_one();
+            return true;
+        }
+        return false;
+    }
+
+    void ScriptScheduler::CoroutineEntry(Coroutine* coroutine) {
+        try {
+            coroutine->body();
+        }
+        catch (const std::exception& e) {
+            std::cerr << "[BegeerteScheduler] Script '" << coroutine->name << "' ended with an error: " << e.what() << std::endl;
+        }
+        catch (...) {
+            std::cerr << "[BegeerteScheduler] Script '" << coroutine->name << "' ended with an unknown error." << std::endl;
+        }
+        coroutine->body = nullptr; // Drop captured state while still on this stack
+        coroutine->next_state = State::Finished;
+
+        // A coroutine must never return from its entry point; the worker frees it after this switch
+        Worker* worker = coroutine->worker;
+#ifdef _WIN32
+        SwitchToFiber(worker->main_fiber);
+#else
+        setcontext(&worker->main_context);
+#endif
+    }
+
+    void ScriptScheduler::WorkerMain(Worker& worker) {
+        current_worker = &worker;
+        ThreadPlacement::Apply("Scheduler", worker.index);
+#ifdef _WIN32
+        worker.main_fiber = ConvertThreadToFiber(nullptr);
+#endif
+        auto later = [](const Coroutine* a, const Coroutine* b) { return a->wake_time > b->wake_time; };
+
+        std::unique_lock<std::mutex> lock(worker.mutex);
+        while (!stopping) {
+            if (parked.load(std::memory_order_relaxed) != 0) {
+                worker.wake.wait(lock); // Park(false) notifies under this mutex, so the wakeup cannot be missed
+                continue;
+            }
+            Clock::time_point now = Now();
+            while (!worker.sleeping.empty() && worker.sleeping.front()->wake_time <= now) {
+                std::pop_heap(worker.sleeping.begin(), worker.sleeping.end(), later);
+                Coroutine* woken = worker.sleeping.back();
+                worker.sleeping.pop_back();
+                MakeReady(worker, woken, woken->wake_time); // Any delay past its wake time counts against its deadline
+            }
+
+            if (worker.ready.empty() && VirtualTime() && !worker.sleeping.empty()) {
+                // Nothing can happen before the next wakeup, so skip straight to it
+                Clock::time_point next = worker.sleeping.front()->wake_time;
+                if (virtual_limit.count() > 0 && next - start_time > virtual_limit) {
+                    parked.fetch_or(static_cast<uint32_t>(ParkReason::VirtualTimeLimit), std::memory_order_relaxed);
+                    std::cout << "[BegeerteScheduler] Virtual time limit of " << std::chrono::duration_cast<std::chrono::seconds>(virtual_limit).count()
+                        << " s reached after " << std::fixed << std::setprecision(2) << std::chrono::duration<double>(Clock::now() - virtual_started).count()
+                        << " s of real time, scripts parked" << std::endl;
+                    continue;
+                }
+                virtual_now.store(next.time_since_epoch().count(), std::memory_order_relaxed);
+                continue;
+            }
+
+            if (worker.ready.empty()) {
+                // Nothing runnable: block until the next wakeup or a Spawn, using no CPU meanwhile
+                if (worker.sleeping.empty()) {
+                    worker.wake.wait(lock);
+                }
+                else {
+                    worker.wake.wait_until(lock, worker.sleeping.front()->wake_time);
+                }
+                continue;
+            }
+
+            Coroutine* coroutine = PickReady(worker, now);
+            coroutine->state = State::Running;
+            coroutine->switches++;
+            worker.running = coroutine;
+            lock.unlock();
+
+            worker.slice_start = Clock::now();
+            worker.back_edges = 0;
+#ifdef _WIN32
+            SwitchToFiber(coroutine->fiber);
+#else
+            swapcontext(&worker.main_context, &coroutine->context);
+#endif
+            Clock::duration ran = Clock::now() - worker.slice_start;
+
+            lock.lock();
+            worker.running = nullptr;
+            coroutine->cpu += ran;
+            size_t priority = static_cast<size_t>(coroutine->priority);
+            worker.used[priority] += ran;
+            worker.classes[priority].cpu_ms += std::chrono::duration<double, std::milli>(ran).count();
+            if (coroutine->next_forced) {
+                coroutine->preempted++;
+                coroutine->next_forced = false;
+            }
+            coroutine->state = coroutine->next_state;
+            switch (coroutine->state) {
+            case State::Ready:
+                MakeReady(worker, coroutine, Now());
+                break;
+            case State::Sleeping:
+                if (coroutine->next_wakeable && coroutine->wake_requested) {
+                    coroutine->wake_requested = false;
+                    MakeReady(worker, coroutine, Now());
+                    break;
+                }
+                coroutine->wakeable = coroutine->next_wakeable;
+                coroutine->wake_time = coroutine->next_wake_time;
+                worker.sleeping.push_back(coroutine);
+                std::push_heap(worker.sleeping.begin(), worker.sleeping.end(), later);
+                break;
+            case State::Finished:
+#ifdef _WIN32
+                DeleteFiber(coroutine->fiber);
+#endif
+                std::erase_if(worker.owned, [coroutine](const std::unique_ptr<Coroutine>& owned) { return owned.get() == coroutine; });
+                break;
+            default:
+                break;
+            }
+        }
+        lock.unlock();
+#ifdef _WIN32
+        ConvertFiberToThread();
+#endif
+    }
+
+    // Caller holds worker.mutex
+    void ScriptScheduler::MakeReady(Worker& worker, Coroutine* coroutine, Clock::time_point since) {
+        coroutine->state = State::Ready;
+        coroutine->ready_since = since;
+        worker.ready.push_back(coroutine);
+    }
+
+    ScriptScheduler::Clock::duration ScriptScheduler::DeadlineOf(const Coroutine& coroutine) const {
+        return coroutine.deadline.count() > 0 ? coroutine.deadline : Clock::duration(default_deadline[static_cast<size_t>(coroutine.priority)]);
+    }
+
+    // Caller holds worker.mutex and ready is not empty. A linear scan: a worker only ever has a handful of
+    // scripts ready at once, and it keeps the ready list a plain FIFO for equal keys.
+    ScriptScheduler::Coroutine* ScriptScheduler::PickReady(Worker& worker, Clock::time_point now) {
+        uint64_t tick = CurrentTick();
+        if (tick != worker.budget_tick) {
+            worker.budget_tick = tick;
+            std::fill(std::begin(worker.used), std::end(worker.used), Clock::duration::zero());
+        }
+        auto rank = [&](const Coroutine* coroutine) {
+            size_t priority = static_cast<size_t>(coroutine->priority);
+            int percent = budget_percent[priority];
+            // In clock units, so short ticks keep their share instead of rounding it down to 0 ms
+            Clock::duration share = std::max(Clock::duration(tick_length) * percent / 100, Clock::duration(1));
+            bool over_budget = percent > 0 && worker.used[priority] >= share;
+            return over_budget ? priority + PriorityCount : priority;
+        };
+
+        auto best = worker.ready.begin();
+        size_t best_rank = rank(*best);
+        Clock::time_point best_deadline = (*best)->ready_since + DeadlineOf(**best);
+        for (auto candidate = std::next(best); candidate != worker.ready.end(); ++candidate) {
+            size_t candidate_rank = rank(*candidate);
+            Clock::time_point candidate_deadline = (*candidate)->ready_since + DeadlineOf(**candidate);
+            if (candidate_rank < best_rank || (candidate_rank == best_rank && candidate_deadline < best_deadline)) {
+                best = candidate;
+                best_rank = candidate_rank;
+                best_deadline = candidate_deadline;
+            }
+        }
+        Coroutine* coroutine = *best;
+        worker.ready.erase(best);
+
+        ClassStats& stats = worker.classes[static_cast<size_t>(coroutine->priority)];
+        stats.runs++;
+        if (now > best_deadline) {
+            static const long long bounds_ms[LatenessBuckets - 1] = { 1, 2, 5, 10, 20, 50, 100 };
+            long long late_us = std::chrono::duration_cast<std::chrono::microseconds>(now - best_deadline).count();
+            size_t bucket = 0;
+            while (bucket < LatenessBuckets - 1 && late_us >= bounds_ms[bucket] * 1000) {
+                bucket++;
+            }
+            stats.missed++;
+            stats.lateness[bucket]++;
+        }
+        return coroutine;
+    }
+
+    void ScriptScheduler::Suspend(State state, Clock::time_point wake_time, bool forced, bool wakeable) {
+        Worker* worker = current_worker;
+        Coroutine* coroutine = worker->running;
+        coroutine->next_state = state;
+        coroutine->next_wake_time = wake_time;
+        coroutine->next_forced = forced;
+        coroutine->next_wakeable = wakeable;
+        if (!forced) {
+            coroutine->pauses++;
+        }
+#ifdef _WIN32
+        SwitchToFiber(worker->main_fiber);
+#else
+        swapcontext(&coroutine->context, &worker->main_context);
+#endif
+    }
+
+    bool ScriptScheduler::InCoroutine() {
+        return current_worker && current_worker->running;
+    }
+
+    uint64_t ScriptScheduler::CurrentId() {
+        return InCoroutine() ? current_worker->running->id : 0;
+    }
+
+    void ScriptScheduler::Sleep(std::chrono::milliseconds duration) {
+        if (!InCoroutine()) {
+            std::this_thread::sleep_for(duration);
+            return;
+        }
+        current_worker->owner->Suspend(State::Sleeping, Now() + duration);
+    }
+
+    void ScriptScheduler::SleepUntil(Clock::time_point wake_time) {
+        if (!InCoroutine()) {
+            // 'wake_time' is script time, which under VirtualTime runs ahead of the real clock: wait out what is left of it
+            std::this_thread::sleep_for(wake_time - Now());
+            return;
+        }
+        current_worker->owner->Suspend(State::Sleeping, wake_time);
+    }
+
+    void ScriptScheduler::SleepUntilWoken(Clock::time_point wake_time) {
+        if (!InCoroutine()) {
+            std::this_thread::sleep_for(wake_time - Now());
+            return;
+        }
+        current_worker->owner->Suspend(State::Sleeping, wake_time, false, true);
+    }
+
+    void ScriptScheduler::Yield() {
+        if (!InCoroutine()) {
+            std::this_thread::yield();
+            return;
+        }
+        current_worker->owner->Suspend(State::Ready, Clock::time_point());
+    }
+
+    void ScriptScheduler::SleepTicks(uint64_t ticks) {
+        ScriptScheduler& scheduler = InCoroutine() ? *current_worker->owner : Shared();
+        SleepUntil(scheduler.TickDeadline(ticks));
+    }
+
+    bool ScriptScheduler::YieldIfSliceExpired() {
+        Worker* worker = current_worker;
+        if (!worker || !worker->running || worker->preemption_held) {
+            return false;
+        }
+        // Reading the clock on every back-edge would cost more than the loop bodies themselves
+        if ((++worker->back_edges & 0xFF) != 0) {
+            return false;
+        }
+        if (Clock::now() - worker->slice_start >= worker->owner->slice) {
+            worker->owner->Suspend(State::Ready, Clock::time_point(), true);
+            return true;
+        }
+        return false;
+    }
+
+    bool ScriptScheduler::ForceYield() {
+        if (!Preemptible()) {
+            return false;
+        }
+        current_worker->owner->Suspend(State::Ready, Clock::time_point(), true);
+        return true;
+    }
+
+    void ScriptScheduler::HoldPreemption(bool hold) {
+        if (InCoroutine()) {
+            current_worker->preemption_held = hold;
+        }
+    }
+
+    bool ScriptScheduler::Preemptible() {
+        return InCoroutine() && !current_worker->preemption_held;
+    }
+
+    void ScriptScheduler::Park(ParkReason reason, bool park) {
+        uint32_t bit = static_cast<uint32_t>(reason);
+        if (park) {
+            parked.fetch_or(bit, std::memory_order_relaxed);
+        }
+        else {
+            parked.fetch_and(~bit, std::memory_order_relaxed);
+        }
+        for (auto& worker : workers) {
+            std::lock_guard<std::mutex> lock(worker->mutex);
+            worker->wake.notify_all();
+        }
+    }
+
+    bool ScriptScheduler::SetPriority(Priority priority, std::chrono::milliseconds deadline) {
+        if (!InCoroutine()) {
+            return false;
+        }
+        Worker* worker = current_worker;
+        std::lock_guard<std::mutex> lock(worker->mutex);
+        worker->running->priority = priority;
+        worker->running->deadline = deadline.count() > 0 ? Clock::duration(deadline) : Clock::duration::zero();
+        return true;
+    }
+
+    bool ScriptScheduler::ParsePriority(const std::string& name, Priority& priority) {
+        if (name == "critical") priority = Priority::Critical;
+        else if (name == "normal") priority = Priority::Normal;
+        else if (name == "batch") priority = Priority::Batch;
+        else return false;
+        return true;
+    }
+
+    const char* ScriptScheduler::PriorityName(Priority priority) {
+        switch (priority) {
+        case Priority::Critical: return "critical";
+        case Priority::Normal: return "normal";
+        case Priority::Batch: return "batch";
+        default: return "?";
+        }
+    }
+
+    ScriptScheduler::Clock::time_point ScriptScheduler::Now() {
+        if (virtual_time.load(std::memory_order_relaxed)) {
+            return Clock::time_point(Clock::duration(virtual_now.load(std::memory_order_relaxed)));
+        }
+        return Clock::now();
+    }
+
+    uint64_t ScriptScheduler::PauseCount() {
+        return InCoroutine() ? current_worker->running->pauses : 0;
+    }
+
+    uint64_t ScriptScheduler::CurrentTick() const {
+        return static_cast<uint64_t>((Now() - start_time) / tick_length);
+    }
+
+    // Every waiter of the same tick wakes together
+    ScriptScheduler::Clock::time_point ScriptScheduler::TickDeadline(uint64_t ticks) const {
+        return start_time + tick_length * (CurrentTick() + ticks);
+    }
+
+    const char* ScriptScheduler::StateName(State state) {
+        switch (state) {
+        case State::Ready: return "ready";
+        case State::Running: return "running";
+        case State::Sleeping: return "sleeping";
+        case State::Finished: return "finished";
+        default: return "?";
+        }
+    }
+
+    ScriptScheduler::Stats ScriptScheduler::Snapshot() {
+        Stats stats;
+        stats.tick = CurrentTick();
+        Clock::time_point now = Now();
+        for (auto& worker : workers) {
+            std::lock_guard<std::mutex> lock(worker->mutex);
+            stats.ready_per_worker.push_back(worker->ready.size());
+            stats.sleeping_per_worker.push_back(worker->sleeping.size());
+            for (size_t i = 0; i < PriorityCount; ++i) {
+                const ClassStats& from = worker->classes[i];
+                ClassStats& to = stats.classes[i];
+                to.runs += from.runs;
+                to.missed += from.missed;
+                to.cpu_ms += from.cpu_ms;
+                for (size_t bucket = 0; bucket < LatenessBuckets; ++bucket) {
+                    to.lateness[bucket] += from.lateness[bucket];
+                }
+            }
+            for (const auto& coroutine : worker->owned) {
+                CoroutineInfo info;
+                info.id = coroutine->id;
+                info.name = coroutine->name;
+                info.state = coroutine->state;
+                info.priority = coroutine->priority;
+                info.deadline_ms = std::chrono::duration_cast<std::chrono::milliseconds>(DeadlineOf(*coroutine)).count();
+                info.worker = worker->index;
+                info.wakes_in_ms = coroutine->state == State::Sleeping ?
+                    std::chrono::duration_cast<std::chrono::milliseconds>(coroutine->wake_time - now).count() : 0;
+                info.switches = coroutine->switches;
+                info.preempted = coroutine->preempted;
+                info.cpu_ms = std::chrono::duration<double, std::milli>(coroutine->cpu).count();
+                stats.coroutines.push_back(info);
+            }
+        }
+        return stats;
+    }
+
+    void ScriptScheduler::Dump(std::ostream& out) {
+        Stats stats = Snapshot();
+        out << "[BegeerteScheduler] tick " << stats.tick << ", " << stats.coroutines.size() << " script(s)" << (Parked() ? ", parked" : "") << std::endl;
+        for (size_t i = 0; i < stats.ready_per_worker.size(); ++i) {
+            out << "  worker " << i << ": " << stats.ready_per_worker[i] << " ready, " << stats.sleeping_per_worker[i] << " sleeping" << std::endl;
+        }
+        for (const auto& info : stats.coroutines) {
+            out << "  #" << info.id << " " << std::left << std::setw(24) << info.name << std::right
+                << " worker " << info.worker << "  " << std::setw(8) << StateName(info.state);
+            if (info.state == State::Sleeping) {
+                out << "  wakes in " << info.wakes_in_ms << " ms";
+            }
+            out << "  " << PriorityName(info.priority) << " (" << info.deadline_ms << " ms)";
+            out << "  resumed " << info.switches << "x, preempted " << info.preempted << "x, cpu " << std::fixed << std::setprecision(1) << info.cpu_ms << " ms" << std::endl;
+        }
+        for (size_t i = 0; i < PriorityCount; ++i) {
+            const ClassStats& stats_class = stats.classes[i];
+            out << "  class " << std::left << std::setw(8) << PriorityName(static_cast<Priority>(i)) << std::right << " ran " << stats_class.runs
+                << "x, cpu " << std::fixed << std::setprecision(1) << stats_class.cpu_ms << " ms, missed " << stats_class.missed << " deadline(s)";
+            if (stats_class.missed > 0) {
+                static const char* labels[LatenessBuckets] = { "<1", "<2", "<5", "<10", "<20", "<50", "<100", ">=100" };
+                out << ", late by";
+                for (size_t bucket = 0; bucket < LatenessBuckets; ++bucket) {
+                    if (stats_class.lateness[bucket] > 0) {
+                        out << " " << labels[bucket] << "ms:" << stats_class.lateness[bucket];
+                    }
+                }
+            }
+            out << std::endl;
+        }
+    }
+
+} // namespace BegeerteScript
\ No newline at end of file
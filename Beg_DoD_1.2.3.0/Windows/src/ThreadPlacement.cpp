@@ -0,0 +1,190 @@
+#include "ThreadPlacement.h"
+#include "Config.h"
+#include <string>
+#include <cstdint>
+#include <cstdlib>
+#include <stdio.h>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <sched.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#endif
+
+namespace ThreadPlacement {
+    struct Settings {
+        uint64_t affinity = 0; // 0 为不限制
+        std::string priority;  // 空为不修改
+        bool ecoQoS = false;
+    };
+
+    struct PriorityName {
+        const char* name;
+        int windows; // SetThreadPriority 的取值
+        int nice;    // setpriority 的取值
+    };
+
+    static const PriorityName Priorities[] = {
+        { "idle", -15, 19 },
+        { "lowest", -2, 10 },
+        { "below_normal", -1, 5 },
+        { "normal", 0, 0 },
+        { "above_normal", 1, -5 },
+    };
+
+    static const PriorityName* FindPriority(const std::string& name) {
+        for (const auto& priority : Priorities) {
+            if (name == priority.name) {
+                return &priority;
+            }
+        }
+        return nullptr;
+    }
+
+    // "0-3,6" 形式的 CPU 列表，只支持前 64 个逻辑处理器
+    static uint64_t ParseCpuList(const std::string& list) {
+        uint64_t mask = 0;
+        size_t pos = 0;
+        while (pos < list.size()) {
+            size_t end = list.find(',', pos);
+            std::string item = list.substr(pos, end == std::string::npos ? std::string::npos : end - pos);
+            pos = end == std::string::npos ? list.size() : end + 1;
+            if (item.empty()) {
+                continue;
+            }
+            size_t dash = item.find('-');
+            int first = atoi(item.c_str());
+            int last = dash == std::string::npos ? first : atoi(item.c_str() + dash + 1);
+            for (int cpu = first; cpu <= last && cpu < 64; ++cpu) {
+                if (cpu >= 0) {
+                    mask |= 1ULL << cpu;
+                }
+            }
+        }
+        return mask;
+    }
+
+    static std::string FormatCpuList(uint64_t mask) {
+        std::string list;
+        for (int cpu = 0; cpu < 64; ++cpu) {
+            if (!(mask >> cpu & 1)) {
+                continue;
+            }
+            int last = cpu;
+            while (last + 1 < 64 && (mask >> (last + 1) & 1)) {
+                last++;
+            }
+            if (!list.empty()) {
+                list += ",";
+            }
+            list += std::to_string(cpu);
+            if (last > cpu) {
+                list += "-" + std::to_string(last);
+            }
+            cpu = last;
+        }
+        return list.empty() ? "none" : list;
+    }
+
+    // <role>Affinity 等键覆盖同名的通用键
+    static Settings Load(const std::string& role) {
+        auto get = [&role](const char* key) {
+            return Config::GetString("Threads", role + key, Config::GetString("Threads", key, ""));
+        };
+        Settings settings;
+        settings.affinity = ParseCpuList(get("Affinity"));
+        settings.priority = get("Priority");
+        settings.ecoQoS = atoi(get("EcoQoS").c_str()) != 0;
+        return settings;
+    }
+
+#ifdef _WIN32
+    void Apply(const char* role, size_t index) {
+        Settings settings = Load(role);
+        HANDLE thread = GetCurrentThread();
+        std::string warnings;
+
+        if (settings.affinity) {
+            DWORD_PTR processMask = 0, systemMask = 0;
+            GetProcessAffinityMask(GetCurrentProcess(), &processMask, &systemMask);
+            DWORD_PTR mask = static_cast<DWORD_PTR>(settings.affinity) & processMask;
+            if (!mask || !SetThreadAffinityMask(thread, mask)) {
+                warnings += ", affinity not applied (CPUs outside the process mask?)";
+            }
+        }
+        if (!settings.priority.empty()) {
+            const PriorityName* priority = FindPriority(settings.priority);
+            if (!priority || !SetThreadPriority(thread, priority->windows)) {
+                warnings += ", unknown or rejected priority '" + settings.priority + "'";
+            }
+        }
+        if (settings.ecoQoS) {
+            // 让调度器把线程放到能效核心或降频运行，Windows 10 1709 之前的系统不支持
+            THREAD_POWER_THROTTLING_STATE state = {};
+            state.Version = THREAD_POWER_THROTTLING_CURRENT_VERSION;
+            state.ControlMask = THREAD_POWER_THROTTLING_EXECUTION_SPEED;
+            state.StateMask = THREAD_POWER_THROTTLING_EXECUTION_SPEED;
+            if (!SetThreadInformation(thread, ThreadPowerThrottling, &state, sizeof(state))) {
+                warnings += ", EcoQoS not supported";
+                settings.ecoQoS = false;
+            }
+        }
+
+        // 读回实际生效的值
+        GROUP_AFFINITY affinity = {};
+        GetThreadGroupAffinity(thread, &affinity);
+        int current = GetThreadPriority(thread);
+        const char* priorityName = "other";
+        for (const auto& priority : Priorities) {
+            if (priority.windows == current) {
+                priorityName = priority.name;
+            }
+        }
+        printf("[Begeerte] Thread %s %zu (tid %lu): CPUs %s, priority %s, EcoQoS %s%s\n", role, index, GetCurrentThreadId(),
+            FormatCpuList(affinity.Mask).c_str(), priorityName, settings.ecoQoS ? "on" : "off", warnings.c_str());
+    }
+#else
+    void Apply(const char* role, size_t index) {
+        Settings settings = Load(role);
+        pid_t tid = static_cast<pid_t>(syscall(SYS_gettid));
+        std::string warnings;
+
+        if (settings.affinity) {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            for (int cpu = 0; cpu < 64; ++cpu) {
+                if (settings.affinity >> cpu & 1) {
+                    CPU_SET(cpu, &set);
+                }
+            }
+            if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+                warnings += ", affinity not applied";
+            }
+        }
+        if (!settings.priority.empty()) {
+            const PriorityName* priority = FindPriority(settings.priority);
+            if (!priority || setpriority(PRIO_PROCESS, static_cast<id_t>(tid), priority->nice) != 0) {
+                warnings += ", unknown or rejected priority '" + settings.priority + "'";
+            }
+        }
+        if (settings.ecoQoS) {
+            warnings += ", EcoQoS is Windows only";
+        }
+
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        sched_getaffinity(0, sizeof(set), &set);
+        uint64_t mask = 0;
+        for (int cpu = 0; cpu < 64; ++cpu) {
+            if (CPU_ISSET(cpu, &set)) {
+                mask |= 1ULL << cpu;
+            }
+        }
+        printf("[Begeerte] Thread %s %zu (tid %d): CPUs %s, nice %d%s\n", role, index, static_cast<int>(tid),
+            FormatCpuList(mask).c_str(), getpriority(PRIO_PROCESS, static_cast<id_t>(tid)), warnings.c_str());
+    }
+#endif
+}
\ No newline at end of file
@@ -0,0 +1,9 @@
+#pragma once
+#include <cstddef>
+
+// 按 [Threads] 配置设置插件线程的 CPU 亲和性、优先级和 EcoQoS，避免与游戏线程争用同一批核心。
+// 每个插件线程启动时在自身线程上调用 Apply，并在控制台输出实际生效的设置。
+namespace ThreadPlacement {
+    // role 为 Service、Scheduler、Worker 或 IO，对应配置中的 <role>Affinity 等键；index 用于区分同一类的多个线程
+    void Apply(const char* role, size_t index = 0);
+}
\ No newline at end of file
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <vector>
+#include <functional>
+#include <cstdint>
+#include <cstddef>
+
+namespace BegeerteScript {
+
+    // Hierarchical timing wheel with 1 ms resolution: 4 levels of 64 slots (up to ~4.6 hours ahead) plus an
+    // overflow list. A timer sits in the level of the highest 6-bit group where its deadline differs from
+    // the current time and moves down a level each time its slot comes up. Schedule and Cancel are O(1),
+    // and Advance skips empty stretches through per-level occupancy bitmaps.
+    // Time is passed in by the caller, so the wheel can be driven by a virtual clock.
+    class TimerWheel {
+    public:
+        using TimerId = uint64_t; // Never 0
+        using FireFunction = std::function<void(TimerId id, uint64_t payload)>;
+
+        static constexpr uint64_t Never = UINT64_MAX;
+
+        explicit TimerWheel(uint64_t now = 0);
+
+        // Fires at 'deadline' (clamped to Now()) and then every 'period' ms if 'period' is not 0.
+        // Called from 'fire', a deadline of Now() or earlier becomes Now() + 1 so Advance cannot loop forever.
+        TimerId Schedule(uint64_t deadline, uint64_t period = 0, uint64_t payload = 0);
+
+        // False if the timer already fired (one-shot) or was cancelled. Safe to call from 'fire'.
+        bool Cancel(TimerId id);
+
+        // Moves the clock to 'now' and fires every timer due by then, in deadline order. 'fire' may schedule
+        // and cancel timers. A periodic timer that fell behind fires once and skips the periods it missed.
+        // Returns the number of timers fired.
+        size_t Advance(uint64_t now, const FireFunction& fire);
+
+        // Earliest time at which Advance has work to do, Never when empty. May be earlier than the next
+        // deadline when a higher level has to move timers down first.
+        uint64_t NextDeadline() const;
+
+        uint64_t Now() const { return current; }
+        size_t Size() const { return active; }
+        bool Empty() const { return active == 0; }
+
+    private:
+        static constexpr int Levels = 4;
+        static constexpr int SlotBits = 6;
+        static constexpr int Slots = 1 << SlotBits;
+        static constexpr uint32_t None = UINT32_MAX;
+        static constexpr int OverflowLevel = Levels;
+
+        enum class NodeState : uint8_t { Free, Queued, Firing, Cancelled };
+
+        struct Node {
+            uint64_t deadline = 0;
+            uint64_t period = 0;
+            uint64_t payload = 0;
+            uint32_t generation = 1;
+            uint32_t prev = None;
+            uint32_t next = None;
+            uint8_t level = 0;
+            uint8_t slot = 0;
+            NodeState state = NodeState::Free;
+        };
+
+        struct List {
+            uint32_t head = None;
+            uint32_t tail = None;
+        };
+
+        uint32_t AllocateNode();
+        void FreeNode(uint32_t index);
+        void Insert(uint32_t index);
+        void Unlink(uint32_t index);
+        void PushBack(List& list, uint32_t index);
+        List& ListOf(int level, int slot);
+        void Cascade(int level);
+        uint32_t Resolve(TimerId id) const;
+        static TimerId MakeId(uint32_t index, uint32_t generation);
+
+        uint64_t current;
+        size_t active = 0;
+        bool firing = false; // Inside 'fire': new timers due now wait for the next Advance
+        std::vector<Node> nodes;
+        std::vector<uint32_t> free_nodes;
+        List wheel[Levels][Slots];
+        uint64_t occupied[Levels] = {}; // Bit per non-empty slot
+        List overflow;
+    };
+
+} // namespace BegeerteScript
\ No newline at end of file
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstddef>
+
+namespace BegeerteScript {
+
+    // Fixed set of threads with one task deque each. A worker pops from the back of its own deque and
+    // steals from the front of the others when it runs dry, so uneven chunks still spread over every core.
+    class WorkerPool {
+    public:
+        using Task = std::function<void()>;
+
+        explicit WorkerPool(size_t thread_count);
+        ~WorkerPool();
+        WorkerPool(const WorkerPool&) = delete;
+        WorkerPool& operator=(const WorkerPool&) = delete;
+
+        size_t Size() const { return threads.size(); }
+
+        // Runs every task and returns once all of them have finished. The calling thread helps out, so
+        // nested calls from inside a task cannot deadlock and a pool of size 0 runs everything inline.
+        // The first exception thrown by a task is rethrown here.
+        void RunAll(std::vector<Task>& tasks);
+
+        // Queues 'task' and returns at once; a pool of size 0 runs it inline. Exceptions from the task are
+        // logged and dropped, so report failures through the task's own state.
+        void Submit(Task task);
+
+        // Pool shared by all scripts, sized by [Scripts] WorkerThreads (default: half the cores)
+        static WorkerPool& Shared();
+
+    private:
+        struct Queue {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        bool TryRunOne(size_t home);
+        void WorkerMain(size_t index);
+
+        std::vector<std::unique_ptr<Queue>> queues; // One per worker, plus one for outside callers
+        std::vector<std::thread> threads;
+        std::atomic<size_t> queued{ 0 };
+        std::atomic<size_t> next_queue{ 0 };
+        std::mutex wake_mutex;
+        std::condition_variable wake;
+        bool stopping = false;
+    };
+
+} // namespace BegeerteScript
\ No newline at end of file
@@ -6,13 +6,17 @@
 #include "ErrorHandler.h"
 #include "CheatData.h"
 #include "plugins.h"
+#include "ScriptHost.h"
 
 static void InitializeDll() {
     printf("[Begeerte] Last update %s.\n", g_cheatdata ? g_cheatdata->last_update : "unknown");
     ErrorHandlerNs::RegisterExceptionFilter();
     Hook::Initialize();
     // Cheat::Start();
-    BegeerteScript::Plugins::Init();
+    // [Host] OutOfProcess=1 时脚本在 BegHost 进程中运行，插件只发布实体列表
+    if (!BegeerteScript::ScriptHost::Start()) {
+        BegeerteScript::Plugins::Init();
+    }
 }
 
 static void CleanupDll() {
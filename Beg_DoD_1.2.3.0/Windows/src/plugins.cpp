@@ -1,1647 +1,2734 @@
-#include "plugins.h"
-#include <iostream>
-#include <windows.h> // For GetModuleFileNameA and directory operations
-#include <filesystem>
-#include <thread>
-#include <mutex>
-#include <atomic>
-#include <fstream>
-
-// Ensure g_cheatdata is declared (it should be defined and initialized in your main project)
-// If not, you'll get a linker error.
-// For testing within this file, you could add a dummy one, but it's better to link properly.
-// extern CheatGlobalData* g_cheatdata; 
-// CheatGlobalData dummy_cheat_data; // If you must define it here for a self-contained example
-// CheatGlobalData* g_cheatdata = &dummy_cheat_data;
-
-namespace BegeerteScript {
-
-    static std::filesystem::path ScriptDirectory;
-    static std::filesystem::path LogDirectory;
-    static std::mutex LogMutex;
-
-    // --- Interpreter Implementation (Simplified) ---
-    void Interpreter::Execute(const std::string& script_content, ScriptContext& context) {
-        std::vector<Token> tokens = Tokenize(script_content, context.current_script_path);
-        size_t index = 0;
-        try {
-            while (index < tokens.size() && tokens[index].type != Token::Type::END_OF_FILE) {
-                ParseStatement(tokens, index, context, context.current_script_path);
-                if (index < tokens.size() && tokens[index].type == Token::Type::END_OF_LINE) {
-                    index++; // Consume EOL
-                }
-            }
-        }
-        catch (const std::exception& e) {
-            // SyntaxError already prints, this catches other runtime_errors from parsing if any
-            // Or if SyntaxError doesn't rethrow but we want to stop.
-            std::cerr << "Execution halted in '" << context.current_script_path << "' due to error: " << e.what() << std::endl;
-            throw; // Re-throw to allow caller to handle unloading
-        }
-    }
-
-    // Very basic tokenizer
-    std::vector<Interpreter::Token> Interpreter::Tokenize(const std::string& script_content, const std::string& script_path) {
-        std::vector<Token> tokens;
-        std::string current_token_text;
-        size_t line_number = 1;
-
-        for (size_t i = 0; i < script_content.length(); ++i) {
-            char c = script_content[i];
-
-            if (c == '\n') {
-                line_number++;
-                tokens.push_back({ Token::Type::END_OF_LINE, ";", line_number - 1 }); // Treat newline as EOL/semicolon
-                continue;
-            }
-            if (std::isspace(c)) continue; // Skip whitespace
-
-            // Comments
-            if (c == '/' && i + 1 < script_content.length()) {
-                if (script_content[i + 1] == '/') { // Single line comment
-                    while (i < script_content.length() && script_content[i] != '\n') {
-                        i++;
-                    }
-                    if (i < script_content.length() && script_content[i] == '\n') line_number++;
-                    tokens.push_back({ Token::Type::END_OF_LINE, ";", line_number - 1 });
-                    continue;
-                }
-                else if (script_content[i + 1] == '*') { // Multi-line comment
-                    i += 2;
-                    while (i + 1 < script_content.length() && !(script_content[i] == '*' && script_content[i + 1] == '/')) {
-                        if (script_content[i] == '\n') line_number++;
-                        i++;
-                    }
-                    i++; // Skip the final '/'
-                    continue;
-                }
-            }
-
-            // Operators and special characters
-            if (std::string("=(){},;+-*/%&|!<>").find(c) != std::string::npos) {
-                if (c == '=' && i + 1 < script_content.length() && script_content[i + 1] == '=') { // ==
-                    tokens.push_back({ Token::Type::OPERATOR, "==", line_number });
-                    i++;
-                }
-                else if (c == '!' && i + 1 < script_content.length() && script_content[i + 1] == '=') { // !=
-                    tokens.push_back({ Token::Type::OPERATOR, "!=", line_number });
-                    i++;
-                }
-                else if (c == '<' && i + 1 < script_content.length() && script_content[i + 1] == '=') { // <=
-                    tokens.push_back({ Token::Type::OPERATOR, "<=", line_number });
-                    i++;
-                }
-                else if (c == '>' && i + 1 < script_content.length() && script_content[i + 1] == '=') { // >=
-                    tokens.push_back({ Token::Type::OPERATOR, ">=", line_number });
-                    i++;
-                }
-                else if (c == '&' && i + 1 < script_content.length() && script_content[i + 1] == '&') { // &&
-                    tokens.push_back({ Token::Type::OPERATOR, "&&", line_number });
-                    i++;
-                }
-                else if (c == '|' && i + 1 < script_content.length() && script_content[i + 1] == '|') { // ||
-                    tokens.push_back({ Token::Type::OPERATOR, "||", line_number });
-                    i++;
-                }
-                else {
-                    tokens.push_back({ Token::Type::OPERATOR, std::string(1, c), line_number });
-                }
-                continue;
-            }
-
-            // Identifiers (and keywords)
-            if (std::isalpha(c) || c == '_') {
-                current_token_text = c;
-                while (i + 1 < script_content.length() && (std::isalnum(script_content[i + 1]) || script_content[i + 1] == '_')) {
-                    current_token_text += script_content[++i];
-                }
-                if (current_token_text == "let" || current_token_text == "if" || current_token_text == "else" ||
-                    current_token_text == "while" || current_token_text == "true" || current_token_text == "false" ||
-                    current_token_text == "nil") {
-                    tokens.push_back({ Token::Type::KEYWORD, current_token_text, line_number });
-                }
-                else {
-                    tokens.push_back({ Token::Type::IDENTIFIER, current_token_text, line_number });
-                }
-                continue;
-            }
-
-            // Numbers (integer and float)
-            if (std::isdigit(c) || (c == '.' && i + 1 < script_content.length() && std::isdigit(script_content[i + 1]))) {
-                current_token_text = c;
-                bool has_decimal = (c == '.');
-                while (i + 1 < script_content.length() && (std::isdigit(script_content[i + 1]) || (!has_decimal && script_content[i + 1] == '.'))) {
-                    current_token_text += script_content[++i];
-                    if (script_content[i] == '.') has_decimal = true;
-                }
-                tokens.push_back({ Token::Type::NUMBER, current_token_text, line_number });
-                continue;
-            }
-
-            // Strings
-            if (c == '"') {
-                current_token_text = ""; // Don't include quotes in value
-                i++; // Skip opening quote
-                while (i < script_content.length() && script_content[i] != '"') {
-                    if (script_content[i] == '\\' && i + 1 < script_content.length()) { // Handle escape sequences (basic)
-                        i++;
-                        switch (script_content[i]) {
-                        case 'n': current_token_text += '\n'; break;
-                        case 't': current_token_text += '\t'; break;
-                        case '"': current_token_text += '"'; break;
-                        case '\\': current_token_text += '\\'; break;
-                        default: current_token_text += script_content[i]; // Add char as is
-                        }
-                    }
-                    else {
-                        current_token_text += script_content[i];
-                    }
-                    if (script_content[i] == '\n') line_number++; // String can span lines
-                    i++;
-                }
-                if (i == script_content.length()) { // Unterminated string
-                    SyntaxError("Unterminated string literal", script_path, line_number);
-                }
-                tokens.push_back({ Token::Type::STRING, current_token_text, line_number });
-                continue;
-            }
-
-            SyntaxError("Unexpected character: " + std::string(1, c), script_path, line_number);
-            tokens.push_back({ Token::Type::UNKNOWN, std::string(1,c), line_number }); // Should be caught by SyntaxError
-        }
-        tokens.push_back({ Token::Type::END_OF_FILE, "", line_number });
-        return tokens;
-    }
-
-    Value Interpreter::ParseFactor(const std::vector<Token>& tokens, size_t& index, ScriptContext& context, const std::string& script_path) {
-        if (index >= tokens.size()) SyntaxError("Unexpected end of input, expected factor", script_path, (tokens.empty() ? 0 : tokens.back().line_number));
-        const auto& token = tokens[index];
-
-        if (token.type == Token::Type::NUMBER) {
-            index++;
-            if (token.text.find('.') != std::string::npos) return Value(std::stod(token.text));
-            return Value(std::stoll(token.text));
-        }
-        if (token.type == Token::Type::STRING) {
-            index++;
-            return Value(token.text);
-        }
-        if (token.type == Token::Type::KEYWORD && token.text == "true") {
-            index++;
-            return Value(true);
-        }
-        if (token.type == Token::Type::KEYWORD && token.text == "false") {
-            index++;
-            return Value(false);
-        }
-        if (token.type == Token::Type::KEYWORD && token.text == "nil") {
-            index++;
-            return Value();
-        }
-        if (token.type == Token::Type::IDENTIFIER) {
-            std::string var_name = token.text;
-            index++;
-            if (index < tokens.size() && tokens[index].type == Token::Type::OPERATOR && tokens[index].text == "(") { // Function call
-                index++; // Consume '('
-                std::vector<Value> args = ParseArgumentList(tokens, index, context, script_path);
-                if (index >= tokens.size() || tokens[index].type != Token::Type::OPERATOR || tokens[index].text != ")") {
-                    SyntaxError("Expected ')' after function arguments", script_path, token.line_number);
-                }
-                index++; // Consume ')'
-                return context.CallFunction(var_name, args);
-            }
-            return context.GetVariable(var_name); // Variable access
-        }
-        if (token.type == Token::Type::OPERATOR && token.text == "(") { // Parenthesized expression
-            index++; // Consume '('
-            Value val = ParseExpression(tokens, index, context, script_path);
-            if (index >= tokens.size() || tokens[index].type != Token::Type::OPERATOR || tokens[index].text != ")") {
-                SyntaxError("Expected ')' after expression", script_path, token.line_number);
-            }
-            index++; // Consume ')'
-            return val;
-        }
-        // Basic unary minus/not for demonstration. Could be expanded.
-        if (token.type == Token::Type::OPERATOR && (token.text == "-" || token.text == "!")) {
-            std::string op = token.text;
-            index++;
-            Value operand = ParseFactor(tokens, index, context, script_path); // Higher precedence for unary
-            if (op == "-") {
-                if (operand.GetType() == Value::Type::NUMBER_INT) return Value(-operand.AsInt());
-                if (operand.GetType() == Value::Type::NUMBER_FLOAT) return Value(-operand.AsFloat());
-                SyntaxError("Operand for unary '-' must be a number.", script_path, token.line_number);
-            }
-            if (op == "!") {
-                return Value(!operand.IsTruthy());
-            }
-        }
-
-        SyntaxError("Unexpected token '" + token.text + "', expected a value, variable, or function call.", script_path, token.line_number);
-        return Value(); // Should not reach here
-    }
-
-    // Placeholder for Term (handles * / %) - for simplicity, merge into Expression or Factor for now
-    Value Interpreter::ParseTerm(const std::vector<Token>& tokens, size_t& index, ScriptContext& context, const std::string& script_path) {
-        Value left = ParseFactor(tokens, index, context, script_path);
-        while (index < tokens.size() && tokens[index].type == Token::Type::OPERATOR &&
-            (tokens[index].text == "*" || tokens[index].text == "/" || tokens[index].text == "%")) {
-            Token op_token = tokens[index];
-            index++;
-            Value right = ParseFactor(tokens, index, context, script_path);
-
-            if (left.GetType() != Value::Type::NUMBER_INT && left.GetType() != Value::Type::NUMBER_FLOAT ||
-                right.GetType() != Value::Type::NUMBER_INT && right.GetType() != Value::Type::NUMBER_FLOAT) {
-                SyntaxError("Operands for '" + op_token.text + "' must be numbers.", script_path, op_token.line_number);
-            }
-
-            bool use_float = (left.GetType() == Value::Type::NUMBER_FLOAT || right.GetType() == Value::Type::NUMBER_FLOAT);
-            double lval_f = left.AsFloat();
-            double rval_f = right.AsFloat();
-            long long lval_i = left.AsInt();
-            long long rval_i = right.AsInt();
-
-            if (op_token.text == "*") {
-                left = use_float ? Value(lval_f * rval_f) : Value(lval_i * rval_i);
-            }
-            else if (op_token.text == "/") {
-                if ((use_float && rval_f == 0.0) || (!use_float && rval_i == 0)) SyntaxError("Division by zero.", script_path, op_token.line_number);
-                left = use_float ? Value(lval_f / rval_f) : Value(lval_i / rval_i);
-            }
-            else if (op_token.text == "%") {
-                if (use_float) SyntaxError("Modulo operator '%' not supported for floats.", script_path, op_token.line_number);
-                if (rval_i == 0) SyntaxError("Modulo by zero.", script_path, op_token.line_number);
-                left = Value(lval_i % rval_i);
-            }
-        }
-        return left;
-    }
-
-    // Placeholder for Expression (handles + - and logical operators)
-    Value Interpreter::ParseExpression(const std::vector<Token>& tokens, size_t& index, ScriptContext& context, const std::string& script_path) {
-        Value left = ParseTerm(tokens, index, context, script_path); // Or ParseComparison for logical ops
-        while (index < tokens.size() && tokens[index].type == Token::Type::OPERATOR &&
-            (tokens[index].text == "+" || tokens[index].text == "-" ||
-                tokens[index].text == "==" || tokens[index].text == "!=" ||
-                tokens[index].text == "<" || tokens[index].text == "<=" ||
-                tokens[index].text == ">" || tokens[index].text == ">=" ||
-                tokens[index].text == "&&" || tokens[index].text == "||")) {
-            Token op_token = tokens[index];
-            index++;
-            Value right = ParseTerm(tokens, index, context, script_path); // Or ParseComparison
-
-            // Arithmetic
-            if (op_token.text == "+") {
-                if ((left.GetType() == Value::Type::NUMBER_INT || left.GetType() == Value::Type::NUMBER_FLOAT) &&
-                    (right.GetType() == Value::Type::NUMBER_INT || right.GetType() == Value::Type::NUMBER_FLOAT)) {
-                    bool use_float = (left.GetType() == Value::Type::NUMBER_FLOAT || right.GetType() == Value::Type::NUMBER_FLOAT);
-                    left = use_float ? Value(left.AsFloat() + right.AsFloat()) : Value(left.AsInt() + right.AsInt());
-                }
-                else if (left.GetType() == Value::Type::STRING || right.GetType() == Value::Type::STRING) { // String concatenation
-                    left = Value(left.AsString() + right.AsString());
-                }
-                else {
-                    SyntaxError("Invalid operands for '+'. Must be numbers or at least one string.", script_path, op_token.line_number);
-                }
-            }
-            else if (op_token.text == "-") {
-                if ((left.GetType() == Value::Type::NUMBER_INT || left.GetType() == Value::Type::NUMBER_FLOAT) &&
-                    (right.GetType() == Value::Type::NUMBER_INT || right.GetType() == Value::Type::NUMBER_FLOAT)) {
-                    bool use_float = (left.GetType() == Value::Type::NUMBER_FLOAT || right.GetType() == Value::Type::NUMBER_FLOAT);
-                    left = use_float ? Value(left.AsFloat() - right.AsFloat()) : Value(left.AsInt() - right.AsInt());
-                }
-                else {
-                    SyntaxError("Operands for '-' must be numbers.", script_path, op_token.line_number);
-                }
-            }
-            // Comparisons (simplified, no type coercion beyond basic number types)
-            else if (op_token.text == "==") {
-                // Basic equality, can be expanded
-                if (left.GetType() == right.GetType()) {
-                    if (left.GetType() == Value::Type::NIL) left = Value(true);
-                    else if (left.GetType() == Value::Type::BOOL) left = Value(left.AsBool() == right.AsBool());
-                    else if (left.GetType() == Value::Type::NUMBER_INT) left = Value(left.AsInt() == right.AsInt());
-                    else if (left.GetType() == Value::Type::NUMBER_FLOAT) left = Value(left.AsFloat() == right.AsFloat()); // Careful with float equality
-                    else if (left.GetType() == Value::Type::STRING) left = Value(left.AsString() == right.AsString());
-                    else if (left.GetType() == Value::Type::PLAYER_PTR) left = Value(left.AsPlayer() == right.AsPlayer());
-                    else left = Value(false); // Cannot compare other types for now
-                }
-                else if ((left.GetType() == Value::Type::NUMBER_INT && right.GetType() == Value::Type::NUMBER_FLOAT) ||
-                    (left.GetType() == Value::Type::NUMBER_FLOAT && right.GetType() == Value::Type::NUMBER_INT)) {
-                    left = Value(left.AsFloat() == right.AsFloat());
-                }
-                else left = Value(false);
-            }
-            else if (op_token.text == "!=") { // Implement similar to == but negated
-                if (left.GetType() == right.GetType()) {
-                    if (left.GetType() == Value::Type::NIL) left = Value(false);
-                    else if (left.GetType() == Value::Type::BOOL) left = Value(left.AsBool() != right.AsBool());
-                    else if (left.GetType() == Value::Type::NUMBER_INT) left = Value(left.AsInt() != right.AsInt());
-                    else if (left.GetType() == Value::Type::NUMBER_FLOAT) left = Value(left.AsFloat() != right.AsFloat());
-                    else if (left.GetType() == Value::Type::STRING) left = Value(left.AsString() != right.AsString());
-                    else if (left.GetType() == Value::Type::PLAYER_PTR) left = Value(left.AsPlayer() != right.AsPlayer());
-                    else left = Value(true);
-                }
-                else if ((left.GetType() == Value::Type::NUMBER_INT && right.GetType() == Value::Type::NUMBER_FLOAT) ||
-                    (left.GetType() == Value::Type::NUMBER_FLOAT && right.GetType() == Value::Type::NUMBER_INT)) {
-                    left = Value(left.AsFloat() != right.AsFloat());
-                }
-                else left = Value(true);
-            }
-            // Relational (numbers only for now)
-#define NUMERIC_COMPARE(op_char) \
-                if ((left.GetType() == Value::Type::NUMBER_INT || left.GetType() == Value::Type::NUMBER_FLOAT) && \
-                    (right.GetType() == Value::Type::NUMBER_INT || right.GetType() == Value::Type::NUMBER_FLOAT)) { \
-                    left = Value(left.AsFloat() op_char right.AsFloat()); \
-                } else { SyntaxError("Operands for '" + op_token.text + "' must be numbers.", script_path, op_token.line_number); }
-
-            else if (op_token.text == "<") { NUMERIC_COMPARE(< ) }
-            else if (op_token.text == "<=") { NUMERIC_COMPARE(<= ) }
-            else if (op_token.text == ">") { NUMERIC_COMPARE(> ) }
-            else if (op_token.text == ">=") { NUMERIC_COMPARE(>= ) }
-            // Logical
-            else if (op_token.text == "&&") {
-                if (!left.IsTruthy()) { // Short-circuit
-                    left = Value(false);
-                    // Need to skip evaluation of 'right' by advancing index past it properly
-                    // This simplified parser doesn't handle short-circuiting perfectly in ParseTerm yet
-                }
-                else {
-                    left = Value(right.IsTruthy());
-                }
-            }
-            else if (op_token.text == "||") {
-                if (left.IsTruthy()) { // Short-circuit
-                    left = Value(true);
-                    // Skip 'right'
-                }
-                else {
-                    left = Value(right.IsTruthy());
-                }
-            }
-        }
-        return left;
-    }
-
-    std::vector<Value> Interpreter::ParseArgumentList(const std::vector<Token>& tokens, size_t& index, ScriptContext& context, const std::string& script_path) {
-        std::vector<Value> args;
-        if (tokens[index].type == Token::Type::OPERATOR && tokens[index].text == ")") { // Empty arg list
-            return args;
-        }
-        while (index < tokens.size()) {
-            args.push_back(ParseExpression(tokens, index, context, script_path));
-            if (index < tokens.size() && tokens[index].type == Token::Type::OPERATOR && tokens[index].text == ",") {
-                index++; // Consume ','
-            }
-            else {
-                break; // End of arguments or syntax error (handled by caller checking for ')')
-            }
-        }
-        return args;
-    }
-
-    void Interpreter::ParseStatement(const std::vector<Token>& tokens, size_t& index, ScriptContext& context, const std::string& script_path) {
-        if (index >= tokens.size() || tokens[index].type == Token::Type::END_OF_FILE) return;
-
-        const auto& current_token = tokens[index];
-
-        if (current_token.type == Token::Type::KEYWORD && current_token.text == "let") {
-            ParseAssignmentOrFunctionCall(tokens, index, context, script_path);
-        }
-        else if (current_token.type == Token::Type::IDENTIFIER) {
-            // Could be assignment (if next is '=') or just a function call
-            if (index + 1 < tokens.size() && tokens[index + 1].type == Token::Type::OPERATOR && tokens[index + 1].text == "=") {
-                ParseAssignmentOrFunctionCall(tokens, index, context, script_path);
-            }
-            else { // Assume function call statement if not assignment
-                ParseFactor(tokens, index, context, script_path); // This will parse and execute the function call
-            }
-        }
-        else if (current_token.type == Token::Type::KEYWORD && current_token.text == "if") {
-            ParseIfStatement(tokens, index, context, script_path);
-        }
-        else if (current_token.type == Token::Type::KEYWORD && current_token.text == "while") {
-            ParseWhileStatement(tokens, index, context, script_path);
-        }
-        else if (current_token.type == Token::Type::OPERATOR && current_token.text == "{") {
-            ParseBlock(tokens, index, context, script_path); // Standalone block (less common but possible)
-        }
-        else if (current_token.type == Token::Type::END_OF_LINE) {
-            index++; // Consume EOL, do nothing
-            return;
-        }
-        else {
-            SyntaxError("Unexpected token at start of statement: " + current_token.text, script_path, current_token.line_number);
-        }
-
-        // Expect a semicolon or EOL after most statements, but our tokenizer treats EOL as a token
-        if (index < tokens.size() && tokens[index].type == Token::Type::OPERATOR && tokens[index].text == ";") {
-            index++; // Consume semicolon
-        }
-    }
-
-    void Interpreter::ParseAssignmentOrFunctionCall(const std::vector<Token>& tokens, size_t& index, ScriptContext& context, const std::string& script_path) {
-        bool is_declaration = false;
-        if (tokens[index].type == Token::Type::KEYWORD && tokens[index].text == "let") {
-            is_declaration = true;
-            index++; // Consume 'let'
-        }
-
-        if (index >= tokens.size() || tokens[index].type != Token::Type::IDENTIFIER) {
-            SyntaxError("Expected identifier after 'let' or at start of assignment.", script_path, (tokens.empty() ? 0 : tokens[index - 1].line_number));
-        }
-        std::string var_name = tokens[index].text;
-        size_t var_line = tokens[index].line_number;
-        index++;
-
-        if (!is_declaration && index < tokens.size() && tokens[index].type == Token::Type::OPERATOR && tokens[index].text == "(") {
-            // It was just an identifier, likely a function call statement.
-            // Rewind and parse as factor (which handles function calls).
-            index -= 1; // Rewind to identifier
-            ParseFactor(tokens, index, context, script_path); // This will parse and execute the function call
-            return;
-        }
-
-        if (index >= tokens.size() || tokens[index].type != Token::Type::OPERATOR || tokens[index].text != "=") {
-            SyntaxError("Expected '=' after identifier in assignment.", script_path, var_line);
-        }
-        index++; // Consume '='
-
-        Value val = ParseExpression(tokens, index, context, script_path);
-        context.SetVariable(var_name, val);
-    }
-
-    void Interpreter::SkipBlock(const std::vector<Token>& tokens, size_t& index, const std::string& script_path) {
-        if (index >= tokens.size() || tokens[index].type != Token::Type::OPERATOR || tokens[index].text != "{") {
-            // If not a block, assume single statement and try to skip it.
-            // This is tricky without full grammar. For now, just skip until EOL or ';'.
-            while (index < tokens.size() && tokens[index].type != Token::Type::END_OF_LINE &&
-                !(tokens[index].type == Token::Type::OPERATOR && tokens[index].text == ";")) {
-                index++;
-            }
-            if (index < tokens.size() && (tokens[index].type == Token::Type::END_OF_LINE || (tokens[index].type == Token::Type::OPERATOR && tokens[index].text == ";"))) {
-                index++; // consume EOL or ;
-            }
-            return;
-        }
-
-        index++; // Consume '{'
-        int brace_level = 1;
-        while (index < tokens.size() && brace_level > 0) {
-            if (tokens[index].type == Token::Type::OPERATOR && tokens[index].text == "{") {
-                brace_level++;
-            }
-            else if (tokens[index].type == Token::Type::OPERATOR && tokens[index].text == "}") {
-                brace_level--;
-            }
-            index++;
-        }
-        if (brace_level > 0) {
-            SyntaxError("Unterminated block while skipping.", script_path, tokens[index - 1].line_number);
-        }
-    }
-
-    void Interpreter::ParseBlock(const std::vector<Token>& tokens, size_t& index, ScriptContext& context, const std::string& script_path) {
-        if (index >= tokens.size() || tokens[index].type != Token::Type::OPERATOR || tokens[index].text != "{") {
-            SyntaxError("Expected '{' to start a block.", script_path, (tokens.empty() ? 0 : tokens[index].line_number));
-        }
-        index++; // Consume '{'
-
-        while (index < tokens.size() && !(tokens[index].type == Token::Type::OPERATOR && tokens[index].text == "}")) {
-            ParseStatement(tokens, index, context, script_path);
-            if (index < tokens.size() && tokens[index].type == Token::Type::END_OF_LINE) {
-                index++; // Consume EOL within block
-            }
-        }
-
-        if (index >= tokens.size() || !(tokens[index].type == Token::Type::OPERATOR && tokens[index].text == "}")) {
-            SyntaxError("Expected '}' to end a block.", script_path, (tokens.empty() ? 0 : tokens[index - 1].line_number));
-        }
-        index++; // Consume '}'
-    }
-
-    void Interpreter::ParseIfStatement(const std::vector<Token>& tokens, size_t& index, ScriptContext& context, const std::string& script_path) {
-        size_t if_line = tokens[index].line_number;
-        index++; // Consume 'if'
-
-        if (index >= tokens.size() || tokens[index].type != Token::Type::OPERATOR || tokens[index].text != "(") {
-            SyntaxError("Expected '(' after 'if'.", script_path, if_line);
-        }
-        index++; // Consume '('
-
-        Value condition = ParseExpression(tokens, index, context, script_path);
-
-        if (index >= tokens.size() || tokens[index].type != Token::Type::OPERATOR || tokens[index].text != ")") {
-            SyntaxError("Expected ')' after if condition.", script_path, if_line);
-        }
-        index++; // Consume ')'
-
-        bool condition_true = condition.IsTruthy();
-        bool executed_branch = false;
-
-        if (condition_true) {
-            executed_branch = true;
-            if (tokens[index].type == Token::Type::OPERATOR && tokens[index].text == "{") {
-                ParseBlock(tokens, index, context, script_path);
-            }
-            else { // Single statement
-                ParseStatement(tokens, index, context, script_path);
-            }
-        }
-        else {
-            // Skip the 'then' block/statement
-            if (tokens[index].type == Token::Type::OPERATOR && tokens[index].text == "{") {
-                SkipBlock(tokens, index, script_path);
-            }
-            else { // Single statement
-                // A bit naive, just skip one statement (until EOL/;)
-                size_t temp_idx = index;
-                ParseStatement(tokens, temp_idx, context, script_path); // "Dry run" to advance index past one statement
-                index = temp_idx; // This is problematic, SkipBlock is better
-            }
-        }
-
-        // Handle 'else if' and 'else'
-        if (index < tokens.size() && tokens[index].type == Token::Type::KEYWORD && tokens[index].text == "else") {
-            index++; // Consume 'else'
-            if (index < tokens.size() && tokens[index].type == Token::Type::KEYWORD && tokens[index].text == "if") { // else if
-                if (!condition_true) { // Only parse 'else if' if previous conditions were false
-                    ParseIfStatement(tokens, index, context, script_path); // Recursive call for 'else if' (consumes the 'if' part)
-                }
-                else {
-                    // Skip the entire 'else if (...){...}' block
-                    index++; // consume 'if' for skipping
-                    if (index < tokens.size() && tokens[index].text == "(") index++; else SyntaxError("Expected ( for else if skip", script_path, tokens[index - 1].line_number);
-                    int paren_level = 1;
-                    while (index < tokens.size() && paren_level > 0) {
-                        if (tokens[index].text == "(") paren_level++;
-                        if (tokens[index].text == ")") paren_level--;
-                        index++;
-                    }
-                    if (paren_level > 0) SyntaxError("Unterminated condition in 'else if' during skip.", script_path, tokens[index - 1].line_number);
-                    SkipBlock(tokens, index, script_path);
-                }
-            }
-            else { // 'else' block
-                if (!condition_true && !executed_branch) { // Only execute if no prior 'if' or 'else if' was true
-                    if (tokens[index].type == Token::Type::OPERATOR && tokens[index].text == "{") {
-                        ParseBlock(tokens, index, context, script_path);
-                    }
-                    else { // Single statement
-                        ParseStatement(tokens, index, context, script_path);
-                    }
-                }
-                else {
-                    SkipBlock(tokens, index, script_path);
-                }
-            }
-        }
-    }
-
-    void Interpreter::ParseWhileStatement(const std::vector<Token>& tokens, size_t& index, ScriptContext& context, const std::string& script_path) {
-        size_t while_line = tokens[index].line_number;
-        index++; // Consume 'while'
-
-        if (index >= tokens.size() || tokens[index].type != Token::Type::OPERATOR || tokens[index].text != "(") {
-            SyntaxError("Expected '(' after 'while'.", script_path, while_line);
-        }
-        size_t condition_start_index = index; // For re-evaluation
-        index++; // Consume '('
-
-        // Loop execution
-        while (true) {
-            size_t current_eval_index = condition_start_index + 1; // Start after '('
-            Value condition = ParseExpression(tokens, current_eval_index, context, script_path);
-
-            if (current_eval_index >= tokens.size() || tokens[current_eval_index].type != Token::Type::OPERATOR || tokens[current_eval_index].text != ")") {
-                SyntaxError("Expected ')' after while condition.", script_path, while_line);
-            }
-            // current_eval_index is now at ')'
-
-            if (!condition.IsTruthy()) {
-                index = current_eval_index + 1; // Move main index past condition ')'
-                SkipBlock(tokens, index, script_path); // Skip the loop body
-                break; // Exit loop
-            }
-
-            // Condition is true, execute body
-            size_t body_start_index = current_eval_index + 1; // After ')'
-            size_t temp_body_index = body_start_index; // Use a temporary index for the body execution
-
-            if (temp_body_index >= tokens.size()) { // Should not happen if ')' was found
-                SyntaxError("Unexpected end of script after while condition.", script_path, while_line);
-                break;
-            }
-
-            if (tokens[temp_body_index].type == Token::Type::OPERATOR && tokens[temp_body_index].text == "{") {
-                ParseBlock(tokens, temp_body_index, context, script_path);
-            }
-            else {
-                ParseStatement(tokens, temp_body_index, context, script_path);
-            }
-            // After body execution, loop back to re-evaluate condition (main 'index' is not changed by body parsing)
-        }
-    }
-
-    // --- Plugin Namespace Functions ---
-    namespace Plugins {
-
-        Value Printf(std::vector<Value>& args) {
-            if (args.empty()) return Value();
-            printf(args[0].AsString().c_str());
-            return Value();
-        }
-
-        Value Print(std::vector<Value>& args) {
-            for (size_t i = 0; i < args.size(); ++i) {
-                std::cout << args[i].AsString();
-                if (i < args.size() - 1) {
-                    std::cout << " ";
-                }
-            }
-            std::cout << std::endl;
-            return Value(); // Print returns nil
-        }
-
-        Value LogToFile(std::vector<Value>& args) {
-            if (args.empty() || args[0].GetType() != Value::Type::STRING) {
-                std::cerr << "LogToFile Error: Requires a string argument for the message." << std::endl;
-                return Value();
-            }
-            std::filesystem::path log_path = BegeerteScript::LogDirectory / "Begeerte_script.log";
-            {
-                std::lock_guard<std::mutex> lock(LogMutex);
-                std::ofstream log_file(log_path, std::ios::app);
-                if (log_file.is_open()) {
-                    for (const auto& arg : args) {
-                        log_file << arg.AsString() << " ";
-                    }
-                    log_file << std::endl;
-                    log_file.close();
-                }
-                else {
-                    std::cerr << "LogToFile Error: Could not open log file: " << log_path << std::endl;
-                }
-            }
-            return Value();
-        }
-
-        void RegisterEntityListAPI(ScriptContext& context) {
-            // ȷ g_cheatdata ѳʼ
-            if (!g_cheatdata) {
-                std::cerr << "Error: g_cheatdata is null. Cannot register EntityList API." << std::endl;
-                return;
-            }
-
-            // ע EntityList غ
-            context.RegisterFunction("EntityList_Update", [](std::vector<Value>& args) -> Value {
-                EntityList::Update();
-                return Value();
-                });
-
-            context.RegisterFunction("EntityList_GetMaxPlayers", [](std::vector<Value>& args) -> Value {
-                return Value((long long)EntityList::GetMaxPlayers());
-                });
-
-            context.RegisterFunction("EntityList_GetEntity", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 1 || args[0].GetType() != Value::Type::NUMBER_INT) {
-                    throw std::runtime_error("EntityList_GetEntity requires 1 integer argument (id).");
-                }
-                DWORD64 entity_addr = EntityList::GetEntity(static_cast<int>(args[0].AsInt()));
-                return Value(static_cast<long long>(entity_addr));
-                });
-
-            context.RegisterFunction("EntityList_GetPlayer", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 1 || args[0].GetType() != Value::Type::NUMBER_INT) {
-                    throw std::runtime_error("EntityList_GetPlayer requires 1 integer argument (id).");
-                }
-                EntityList::Player* player = EntityList::GetPlayer(static_cast<int>(args[0].AsInt()));
-                return Value(player);
-                });
-
-            context.RegisterFunction("EntityList_GetAllEntities", [](std::vector<Value>& args) -> Value {
-                const auto& entities = EntityList::GetAllEntities();
-                return Value((long long)entities.size());
-                });
-
-            // ע Player غ
-            context.RegisterFunction("Player_IsValid", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
-                    throw std::runtime_error("Player_IsValid requires 1 Player object argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value(false);
-                return Value(p->IsValid());
-                });
-
-            context.RegisterFunction("Player_GetCharacter", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
-                    throw std::runtime_error("Player_GetCharacter requires 1 Player object argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value("Error: Null Player");
-                const wchar_t* w_char = p->GetCharacter();
-                char buffer[256];
-                size_t convertedChars = 0;
-                wcstombs_s(&convertedChars, buffer, sizeof(buffer), w_char, _TRUNCATE);
-                return Value(std::string(buffer));
-                });
-
-            context.RegisterFunction("Player_GetGrowthStage", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
-                    throw std::runtime_error("Player_GetGrowthStage requires 1 Player object argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value("Error: Null Player");
-                const wchar_t* w_gs = p->GetGrowthStage();
-                char buffer[256];
-                size_t convertedChars = 0;
-                wcstombs_s(&convertedChars, buffer, sizeof(buffer), w_gs, _TRUNCATE);
-                return Value(std::string(buffer));
-                });
-
-            // Ϊÿ byte ֶע Get  Set 
-            // validFlag
-            context.RegisterFunction("Player_GetValidFlag", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
-                    throw std::runtime_error("Player_GetValidFlag requires 1 Player object argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value((long long)0);
-                return Value((long long)p->validFlag);
-                });
-
-            context.RegisterFunction("Player_SetValidFlag", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 2 || args[0].GetType() != Value::Type::PLAYER_PTR || args[1].GetType() != Value::Type::NUMBER_INT) {
-                    throw std::runtime_error("Player_SetValidFlag requires 1 Player object and 1 integer argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value();
-                p->validFlag = static_cast<byte>(args[1].AsInt());
-                return Value();
-                });
-
-            // SkinIndex
-            context.RegisterFunction("Player_GetSkinIndex", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
-                    throw std::runtime_error("Player_GetSkinIndex requires 1 Player object argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value((long long)0);
-                return Value((long long)p->SkinIndex);
-                });
-
-            context.RegisterFunction("Player_SetSkinIndex", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 2 || args[0].GetType() != Value::Type::PLAYER_PTR || args[1].GetType() != Value::Type::NUMBER_INT) {
-                    throw std::runtime_error("Player_SetSkinIndex requires 1 Player object and 1 integer argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value();
-                p->SkinIndex = static_cast<byte>(args[1].AsInt());
-                return Value();
-                });
-
-            // Gender
-            context.RegisterFunction("Player_GetGenderRaw", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
-                    throw std::runtime_error("Player_GetGenderRaw requires 1 Player object argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value((long long)0);
-                return Value((long long)p->Gender);
-                });
-
-            context.RegisterFunction("Player_SetGender", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 2 || args[0].GetType() != Value::Type::PLAYER_PTR || args[1].GetType() != Value::Type::NUMBER_INT) {
-                    throw std::runtime_error("Player_SetGender requires 1 Player object and 1 integer argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value();
-                p->Gender = static_cast<byte>(args[1].AsInt());
-                return Value();
-                });
-
-            // GrowthStage
-            context.RegisterFunction("Player_GetGrowthStageRaw", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
-                    throw std::runtime_error("Player_GetGrowthStageRaw requires 1 Player object argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value((long long)0);
-                return Value((long long)p->GrowthStage);
-                });
-
-            context.RegisterFunction("Player_SetGrowthStage", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 2 || args[0].GetType() != Value::Type::PLAYER_PTR || args[1].GetType() != Value::Type::NUMBER_INT) {
-                    throw std::runtime_error("Player_SetGrowthStage requires 1 Player object and 1 integer argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value();
-                p->GrowthStage = static_cast<byte>(args[1].AsInt());
-                return Value();
-                });
-
-            // SavedGrowth
-            context.RegisterFunction("Player_GetSavedGrowth", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
-                    throw std::runtime_error("Player_GetSavedGrowth requires 1 Player object argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value((long long)0);
-                return Value((long long)p->SavedGrowth);
-                });
-
-            context.RegisterFunction("Player_SetSavedGrowth", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 2 || args[0].GetType() != Value::Type::PLAYER_PTR || args[1].GetType() != Value::Type::NUMBER_INT) {
-                    throw std::runtime_error("Player_SetSavedGrowth requires 1 Player object and 1 integer argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value();
-                p->SavedGrowth = static_cast<byte>(args[1].AsInt());
-                return Value();
-                });
-
-            // VitalityHealth
-            context.RegisterFunction("Player_GetVitalityHealth", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
-                    throw std::runtime_error("Player_GetVitalityHealth requires 1 Player object argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value((long long)0);
-                return Value((long long)p->VitalityHealth);
-                });
-
-            context.RegisterFunction("Player_SetVitalityHealth", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 2 || args[0].GetType() != Value::Type::PLAYER_PTR || args[1].GetType() != Value::Type::NUMBER_INT) {
-                    throw std::runtime_error("Player_SetVitalityHealth requires 1 Player object and 1 integer argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value();
-                p->VitalityHealth = static_cast<byte>(args[1].AsInt());
-                return Value();
-                });
-
-            context.RegisterFunction("Player_GetVitalityHealthGrade", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
-                    throw std::runtime_error("Player_GetVitalityHealthGrade requires 1 Player object argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value("Error: Null Player");
-                const wchar_t* w_grade = p->GetGeneticGrades(p->VitalityHealth);
-                char buffer[256];
-                size_t convertedChars = 0;
-                wcstombs_s(&convertedChars, buffer, sizeof(buffer), w_grade, _TRUNCATE);
-                return Value(std::string(buffer));
-                });
-
-            // VitalityArmor
-            context.RegisterFunction("Player_GetVitalityArmor", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
-                    throw std::runtime_error("Player_GetVitalityArmor requires 1 Player object argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value((long long)0);
-                return Value((long long)p->VitalityArmor);
-                });
-
-            context.RegisterFunction("Player_SetVitalityArmor", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 2 || args[0].GetType() != Value::Type::PLAYER_PTR || args[1].GetType() != Value::Type::NUMBER_INT) {
-                    throw std::runtime_error("Player_SetVitalityArmor requires 1 Player object and 1 integer argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value();
-                p->VitalityArmor = static_cast<byte>(args[1].AsInt());
-                return Value();
-                });
-
-            context.RegisterFunction("Player_GetVitalityArmorGrade", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
-                    throw std::runtime_error("Player_GetVitalityArmorGrade requires 1 Player object argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value("Error: Null Player");
-                const wchar_t* w_grade = p->GetGeneticGrades(p->VitalityArmor);
-                char buffer[256];
-                size_t convertedChars = 0;
-                wcstombs_s(&convertedChars, buffer, sizeof(buffer), w_grade, _TRUNCATE);
-                return Value(std::string(buffer));
-                });
-
-            // VitalityBile
-            context.RegisterFunction("Player_GetVitalityBile", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
-                    throw std::runtime_error("Player_GetVitalityBile requires 1 Player object argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value((long long)0);
-                return Value((long long)p->VitalityBile);
-                });
-
-            context.RegisterFunction("Player_SetVitalityBile", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 2 || args[0].GetType() != Value::Type::PLAYER_PTR || args[1].GetType() != Value::Type::NUMBER_INT) {
-                    throw std::runtime_error("Player_SetVitalityBile requires 1 Player object and 1 integer argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value();
-                p->VitalityBile = static_cast<byte>(args[1].AsInt());
-                return Value();
-                });
-
-            context.RegisterFunction("Player_GetVitalityBileGrade", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
-                    throw std::runtime_error("Player_GetVitalityBileGrade requires 1 Player object argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value("Error: Null Player");
-                const wchar_t* w_grade = p->GetGeneticGrades(p->VitalityBile);
-                char buffer[256];
-                size_t convertedChars = 0;
-                wcstombs_s(&convertedChars, buffer, sizeof(buffer), w_grade, _TRUNCATE);
-                return Value(std::string(buffer));
-                });
-
-            // VitalityStamina
-            context.RegisterFunction("Player_GetVitalityStamina", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
-                    throw std::runtime_error("Player_GetVitalityStamina requires 1 Player object argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value((long long)0);
-                return Value((long long)p->VitalityStamina);
-                });
-
-            context.RegisterFunction("Player_SetVitalityStamina", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 2 || args[0].GetType() != Value::Type::PLAYER_PTR || args[1].GetType() != Value::Type::NUMBER_INT) {
-                    throw std::runtime_error("Player_SetVitalityStamina requires 1 Player object and 1 integer argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value();
-                p->VitalityStamina = static_cast<byte>(args[1].AsInt());
-                return Value();
-                });
-
-            context.RegisterFunction("Player_GetVitalityStaminaGrade", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
-                    throw std::runtime_error("Player_GetVitalityStaminaGrade requires 1 Player object argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value("Error: Null Player");
-                const wchar_t* w_grade = p->GetGeneticGrades(p->VitalityStamina);
-                char buffer[256];
-                size_t convertedChars = 0;
-                wcstombs_s(&convertedChars, buffer, sizeof(buffer), w_grade, _TRUNCATE);
-                return Value(std::string(buffer));
-                });
-
-            // VitalityHunger
-            context.RegisterFunction("Player_GetVitalityHunger", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
-                    throw std::runtime_error("Player_GetVitalityHunger requires 1 Player object argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value((long long)0);
-                return Value((long long)p->VitalityHunger);
-                });
-
-            context.RegisterFunction("Player_SetVitalityHunger", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 2 || args[0].GetType() != Value::Type::PLAYER_PTR || args[1].GetType() != Value::Type::NUMBER_INT) {
-                    throw std::runtime_error("Player_SetVitalityHunger requires 1 Player object and 1 integer argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value();
-                p->VitalityHunger = static_cast<byte>(args[1].AsInt());
-                return Value();
-                });
-
-            context.RegisterFunction("Player_GetVitalityHungerGrade", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
-                    throw std::runtime_error("Player_GetVitalityHungerGrade requires 1 Player object argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value("Error: Null Player");
-                const wchar_t* w_grade = p->GetGeneticGrades(p->VitalityHunger);
-                char buffer[256];
-                size_t convertedChars = 0;
-                wcstombs_s(&convertedChars, buffer, sizeof(buffer), w_grade, _TRUNCATE);
-                return Value(std::string(buffer));
-                });
-
-            // VitalityThirst
-            context.RegisterFunction("Player_GetVitalityThirst", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
-                    throw std::runtime_error("Player_GetVitalityThirst requires 1 Player object argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value((long long)0);
-                return Value((long long)p->VitalityThirst);
-                });
-
-            context.RegisterFunction("Player_SetVitalityThirst", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 2 || args[0].GetType() != Value::Type::PLAYER_PTR || args[1].GetType() != Value::Type::NUMBER_INT) {
-                    throw std::runtime_error("Player_SetVitalityThirst requires 1 Player object and 1 integer argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value();
-                p->VitalityThirst = static_cast<byte>(args[1].AsInt());
-                return Value();
-                });
-
-            context.RegisterFunction("Player_GetVitalityThirstGrade", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
-                    throw std::runtime_error("Player_GetVitalityThirstGrade requires 1 Player object argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value("Error: Null Player");
-                const wchar_t* w_grade = p->GetGeneticGrades(p->VitalityThirst);
-                char buffer[256];
-                size_t convertedChars = 0;
-                wcstombs_s(&convertedChars, buffer, sizeof(buffer), w_grade, _TRUNCATE);
-                return Value(std::string(buffer));
-                });
-
-            // VitalityTorpor
-            context.RegisterFunction("Player_GetVitalityTorpor", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
-                    throw std::runtime_error("Player_GetVitalityTorpor requires 1 Player object argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value((long long)0);
-                return Value((long long)p->VitalityTorpor);
-                });
-
-            context.RegisterFunction("Player_SetVitalityTorpor", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 2 || args[0].GetType() != Value::Type::PLAYER_PTR || args[1].GetType() != Value::Type::NUMBER_INT) {
-                    throw std::runtime_error("Player_SetVitalityTorpor requires 1 Player object and 1 integer argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value();
-                p->VitalityTorpor = static_cast<byte>(args[1].AsInt());
-                return Value();
-                });
-
-            context.RegisterFunction("Player_GetVitalityTorporGrade", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
-                    throw std::runtime_error("Player_GetVitalityTorporGrade requires 1 Player object argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value("Error: Null Player");
-                const wchar_t* w_grade = p->GetGeneticGrades(p->VitalityTorpor);
-                char buffer[256];
-                size_t convertedChars = 0;
-                wcstombs_s(&convertedChars, buffer, sizeof(buffer), w_grade, _TRUNCATE);
-                return Value(std::string(buffer));
-                });
-
-            // DamageBite
-            context.RegisterFunction("Player_GetDamageBite", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
-                    throw std::runtime_error("Player_GetDamageBite requires 1 Player object argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value((long long)0);
-                return Value((long long)p->DamageBite);
-                });
-
-            context.RegisterFunction("Player_SetDamageBite", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 2 || args[0].GetType() != Value::Type::PLAYER_PTR || args[1].GetType() != Value::Type::NUMBER_INT) {
-                    throw std::runtime_error("Player_SetDamageBite requires 1 Player object and 1 integer argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value();
-                p->DamageBite = static_cast<byte>(args[1].AsInt());
-                return Value();
-                });
-
-            context.RegisterFunction("Player_GetDamageBiteGrade", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
-                    throw std::runtime_error("Player_GetDamageBiteGrade requires 1 Player object argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value("Error: Null Player");
-                const wchar_t* w_grade = p->GetGeneticGrades(p->DamageBite);
-                char buffer[256];
-                size_t convertedChars = 0;
-                wcstombs_s(&convertedChars, buffer, sizeof(buffer), w_grade, _TRUNCATE);
-                return Value(std::string(buffer));
-                });
-
-            // DamageProjectile
-            context.RegisterFunction("Player_GetDamageProjectile", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
-                    throw std::runtime_error("Player_GetDamageProjectile requires 1 Player object argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value((long long)0);
-                return Value((long long)p->DamageProjectile);
-                });
-
-            context.RegisterFunction("Player_SetDamageProjectile", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 2 || args[0].GetType() != Value::Type::PLAYER_PTR || args[1].GetType() != Value::Type::NUMBER_INT) {
-                    throw std::runtime_error("Player_SetDamageProjectile requires 1 Player object and 1 integer argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value();
-                p->DamageProjectile = static_cast<byte>(args[1].AsInt());
-                return Value();
-                });
-
-            context.RegisterFunction("Player_GetDamageProjectileGrade", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
-                    throw std::runtime_error("Player_GetDamageProjectileGrade requires 1 Player object argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value("Error: Null Player");
-                const wchar_t* w_grade = p->GetGeneticGrades(p->DamageProjectile);
-                char buffer[256];
-                size_t convertedChars = 0;
-                wcstombs_s(&convertedChars, buffer, sizeof(buffer), w_grade, _TRUNCATE);
-                return Value(std::string(buffer));
-                });
-
-            // DamageSwipe
-            context.RegisterFunction("Player_GetDamageSwipe", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
-                    throw std::runtime_error("Player_GetDamageSwipe requires 1 Player object argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value((long long)0);
-                return Value((long long)p->DamageSwipe);
-                });
-
-            context.RegisterFunction("Player_SetDamageSwipe", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 2 || args[0].GetType() != Value::Type::PLAYER_PTR || args[1].GetType() != Value::Type::NUMBER_INT) {
-                    throw std::runtime_error("Player_SetDamageSwipe requires 1 Player object and 1 integer argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value();
-                p->DamageSwipe = static_cast<byte>(args[1].AsInt());
-                return Value();
-                });
-
-            context.RegisterFunction("Player_GetDamageSwipeGrade", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
-                    throw std::runtime_error("Player_GetDamageSwipeGrade requires 1 Player object argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value("Error: Null Player");
-                const wchar_t* w_grade = p->GetGeneticGrades(p->DamageSwipe);
-                char buffer[256];
-                size_t convertedChars = 0;
-                wcstombs_s(&convertedChars, buffer, sizeof(buffer), w_grade, _TRUNCATE);
-                return Value(std::string(buffer));
-                });
-
-            // MitigationBlunt
-            context.RegisterFunction("Player_GetMitigationBlunt", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
-                    throw std::runtime_error("Player_GetMitigationBlunt requires 1 Player object argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value((long long)0);
-                return Value((long long)p->MitigationBlunt);
-                });
-
-            context.RegisterFunction("Player_SetMitigationBlunt", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 2 || args[0].GetType() != Value::Type::PLAYER_PTR || args[1].GetType() != Value::Type::NUMBER_INT) {
-                    throw std::runtime_error("Player_SetMitigationBlunt requires 1 Player object and 1 integer argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value();
-                p->MitigationBlunt = static_cast<byte>(args[1].AsInt());
-                return Value();
-                });
-
-            context.RegisterFunction("Player_GetMitigationBluntGrade", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
-                    throw std::runtime_error("Player_GetMitigationBluntGrade requires 1 Player object argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value("Error: Null Player");
-                const wchar_t* w_grade = p->GetGeneticGrades(p->MitigationBlunt);
-                char buffer[256];
-                size_t convertedChars = 0;
-                wcstombs_s(&convertedChars, buffer, sizeof(buffer), w_grade, _TRUNCATE);
-                return Value(std::string(buffer));
-                });
-
-            // MitigationPierce
-            context.RegisterFunction("Player_GetMitigationPierce", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
-                    throw std::runtime_error("Player_GetMitigationPierce requires 1 Player object argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value((long long)0);
-                return Value((long long)p->MitigationPierce);
-                });
-
-            context.RegisterFunction("Player_SetMitigationPierce", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 2 || args[0].GetType() != Value::Type::PLAYER_PTR || args[1].GetType() != Value::Type::NUMBER_INT) {
-                    throw std::runtime_error("Player_SetMitigationPierce requires 1 Player object and 1 integer argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value();
-                p->MitigationPierce = static_cast<byte>(args[1].AsInt());
-                return Value();
-                });
-
-            context.RegisterFunction("Player_GetMitigationPierceGrade", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
-                    throw std::runtime_error("Player_GetMitigationPierceGrade requires 1 Player object argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value("Error: Null Player");
-                const wchar_t* w_grade = p->GetGeneticGrades(p->MitigationPierce);
-                char buffer[256];
-                size_t convertedChars = 0;
-                wcstombs_s(&convertedChars, buffer, sizeof(buffer), w_grade, _TRUNCATE);
-                return Value(std::string(buffer));
-                });
-
-            // MitigationFire
-            context.RegisterFunction("Player_GetMitigationFire", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
-                    throw std::runtime_error("Player_GetMitigationFire requires 1 Player object argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value((long long)0);
-                return Value((long long)p->MitigationFire);
-                });
-
-            context.RegisterFunction("Player_SetMitigationFire", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 2 || args[0].GetType() != Value::Type::PLAYER_PTR || args[1].GetType() != Value::Type::NUMBER_INT) {
-                    throw std::runtime_error("Player_SetMitigationFire requires 1 Player object and 1 integer argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value();
-                p->MitigationFire = static_cast<byte>(args[1].AsInt());
-                return Value();
-                });
-
-            context.RegisterFunction("Player_GetMitigationFireGrade", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
-                    throw std::runtime_error("Player_GetMitigationFireGrade requires 1 Player object argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value("Error: Null Player");
-                const wchar_t* w_grade = p->GetGeneticGrades(p->MitigationFire);
-                char buffer[256];
-                size_t convertedChars = 0;
-                wcstombs_s(&convertedChars, buffer, sizeof(buffer), w_grade, _TRUNCATE);
-                return Value(std::string(buffer));
-                });
-
-            // MitigationFrost
-            context.RegisterFunction("Player_GetMitigationFrost", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
-                    throw std::runtime_error("Player_GetMitigationFrost requires 1 Player object argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value((long long)0);
-                return Value((long long)p->MitigationFrost);
-                });
-
-            context.RegisterFunction("Player_SetMitigationFrost", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 2 || args[0].GetType() != Value::Type::PLAYER_PTR || args[1].GetType() != Value::Type::NUMBER_INT) {
-                    throw std::runtime_error("Player_SetMitigationFrost requires 1 Player object and 1 integer argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value();
-                p->MitigationFrost = static_cast<byte>(args[1].AsInt());
-                return Value();
-                });
-
-            context.RegisterFunction("Player_GetMitigationFrostGrade", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
-                    throw std::runtime_error("Player_GetMitigationFrostGrade requires 1 Player object argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value("Error: Null Player");
-                const wchar_t* w_grade = p->GetGeneticGrades(p->MitigationFrost);
-                char buffer[256];
-                size_t convertedChars = 0;
-                wcstombs_s(&convertedChars, buffer, sizeof(buffer), w_grade, _TRUNCATE);
-                return Value(std::string(buffer));
-                });
-
-            // MitigationAcid
-            context.RegisterFunction("Player_GetMitigationAcid", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
-                    throw std::runtime_error("Player_GetMitigationAcid requires 1 Player object argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value((long long)0);
-                return Value((long long)p->MitigationAcid);
-                });
-
-            context.RegisterFunction("Player_SetMitigationAcid", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 2 || args[0].GetType() != Value::Type::PLAYER_PTR || args[1].GetType() != Value::Type::NUMBER_INT) {
-                    throw std::runtime_error("Player_SetMitigationAcid requires 1 Player object and 1 integer argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value();
-                p->MitigationAcid = static_cast<byte>(args[1].AsInt());
-                return Value();
-                });
-
-            context.RegisterFunction("Player_GetMitigationAcidGrade", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
-                    throw std::runtime_error("Player_GetMitigationAcidGrade requires 1 Player object argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value("Error: Null Player");
-                const wchar_t* w_grade = p->GetGeneticGrades(p->MitigationAcid);
-                char buffer[256];
-                size_t convertedChars = 0;
-                wcstombs_s(&convertedChars, buffer, sizeof(buffer), w_grade, _TRUNCATE);
-                return Value(std::string(buffer));
-                });
-
-            // MitigationVenom
-            context.RegisterFunction("Player_GetMitigationVenom", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
-                    throw std::runtime_error("Player_GetMitigationVenom requires 1 Player object argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value((long long)0);
-                return Value((long long)p->MitigationVenom);
-                });
-
-            context.RegisterFunction("Player_SetMitigationVenom", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 2 || args[0].GetType() != Value::Type::PLAYER_PTR || args[1].GetType() != Value::Type::NUMBER_INT) {
-                    throw std::runtime_error("Player_SetMitigationVenom requires 1 Player object and 1 integer argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value();
-                p->MitigationVenom = static_cast<byte>(args[1].AsInt());
-                return Value();
-                });
-
-            context.RegisterFunction("Player_GetMitigationVenomGrade", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
-                    throw std::runtime_error("Player_GetMitigationVenomGrade requires 1 Player object argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value("Error: Null Player");
-                const wchar_t* w_grade = p->GetGeneticGrades(p->MitigationVenom);
-                char buffer[256];
-                size_t convertedChars = 0;
-                wcstombs_s(&convertedChars, buffer, sizeof(buffer), w_grade, _TRUNCATE);
-                return Value(std::string(buffer));
-                });
-
-            // MitigationPlasma
-            context.RegisterFunction("Player_GetMitigationPlasma", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
-                    throw std::runtime_error("Player_GetMitigationPlasma requires 1 Player object argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value((long long)0);
-                return Value((long long)p->MitigationPlasma);
-                });
-
-            context.RegisterFunction("Player_SetMitigationPlasma", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 2 || args[0].GetType() != Value::Type::PLAYER_PTR || args[1].GetType() != Value::Type::NUMBER_INT) {
-                    throw std::runtime_error("Player_SetMitigationPlasma requires 1 Player object and 1 integer argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value();
-                p->MitigationPlasma = static_cast<byte>(args[1].AsInt());
-                return Value();
-                });
-
-            context.RegisterFunction("Player_GetMitigationPlasmaGrade", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
-                    throw std::runtime_error("Player_GetMitigationPlasmaGrade requires 1 Player object argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value("Error: Null Player");
-                const wchar_t* w_grade = p->GetGeneticGrades(p->MitigationPlasma);
-                char buffer[256];
-                size_t convertedChars = 0;
-                wcstombs_s(&convertedChars, buffer, sizeof(buffer), w_grade, _TRUNCATE);
-                return Value(std::string(buffer));
-                });
-
-            // MitigationElectricity
-            context.RegisterFunction("Player_GetMitigationElectricity", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
-                    throw std::runtime_error("Player_GetMitigationElectricity requires 1 Player object argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value((long long)0);
-                return Value((long long)p->MitigationElectricity);
-                });
-
-            context.RegisterFunction("Player_SetMitigationElectricity", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 2 || args[0].GetType() != Value::Type::PLAYER_PTR || args[1].GetType() != Value::Type::NUMBER_INT) {
-                    throw std::runtime_error("Player_SetMitigationElectricity requires 1 Player object and 1 integer argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value();
-                p->MitigationElectricity = static_cast<byte>(args[1].AsInt());
-                return Value();
-                });
-
-            context.RegisterFunction("Player_GetMitigationElectricityGrade", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
-                    throw std::runtime_error("Player_GetMitigationElectricityGrade requires 1 Player object argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value("Error: Null Player");
-                const wchar_t* w_grade = p->GetGeneticGrades(p->MitigationElectricity);
-                char buffer[256];
-                size_t convertedChars = 0;
-                wcstombs_s(&convertedChars, buffer, sizeof(buffer), w_grade, _TRUNCATE);
-                return Value(std::string(buffer));
-                });
-
-            // OverallQuality
-            context.RegisterFunction("Player_GetOverallQuality", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
-                    throw std::runtime_error("Player_GetOverallQuality requires 1 Player object argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value((long long)0);
-                return Value((long long)p->OverallQuality);
-                });
-
-            context.RegisterFunction("Player_SetOverallQuality", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 2 || args[0].GetType() != Value::Type::PLAYER_PTR || args[1].GetType() != Value::Type::NUMBER_INT) {
-                    throw std::runtime_error("Player_SetOverallQuality requires 1 Player object and 1 integer argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value();
-                p->OverallQuality = static_cast<byte>(args[1].AsInt());
-                return Value();
-                });
-
-            context.RegisterFunction("Player_GetOverallQualityGrade", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
-                    throw std::runtime_error("Player_GetOverallQualityGrade requires 1 Player object argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value("Error: Null Player");
-                const wchar_t* w_grade = p->GetGeneticGrades(p->OverallQuality);
-                char buffer[256];
-                size_t convertedChars = 0;
-                wcstombs_s(&convertedChars, buffer, sizeof(buffer), w_grade, _TRUNCATE);
-                return Value(std::string(buffer));
-                });
-
-            // Character
-            context.RegisterFunction("Player_GetCharacterRaw", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
-                    throw std::runtime_error("Player_GetCharacterRaw requires 1 Player object argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value((long long)0);
-                return Value((long long)p->Character);
-                });
-
-            context.RegisterFunction("Player_SetCharacter", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 2 || args[0].GetType() != Value::Type::PLAYER_PTR || args[1].GetType() != Value::Type::NUMBER_INT) {
-                    throw std::runtime_error("Player_SetCharacter requires 1 Player object and 1 integer argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value();
-                p->Character = static_cast<byte>(args[1].AsInt());
-                return Value();
-                });
-
-            // Health
-            context.RegisterFunction("Player_GetHealth", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
-                    throw std::runtime_error("Player_GetHealth requires 1 Player object argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value((long long)0);
-                return Value((long long)p->Health);
-                });
-
-            context.RegisterFunction("Player_SetHealth", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 2 || args[0].GetType() != Value::Type::PLAYER_PTR || args[1].GetType() != Value::Type::NUMBER_INT) {
-                    throw std::runtime_error("Player_SetHealth requires 1 Player object and 1 integer argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value();
-                p->Health = static_cast<byte>(args[1].AsInt());
-                return Value();
-                });
-
-            context.RegisterFunction("Player_GetHealthGrade", [](std::vector<Value>& args) -> Value {
-                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
-                    throw std::runtime_error("Player_GetHealthGrade requires 1 Player object argument.");
-                }
-                EntityList::Player* p = args[0].AsPlayer();
-                if (!p) return Value("Error: Null Player");
-                const wchar_t* w_grade = p->GetGeneticGrades(p->Health);
-                char buffer[256];
-                size_t convertedChars = 0;
-                wcstombs_s(&convertedChars, buffer, sizeof(buffer), w_grade, _TRUNCATE);
-                return Value(std::string(buffer));
-                });
-        }
-
-        // Structure to hold script execution data
-        struct ScriptTask {
-            std::string path;
-            std::string content;
-            bool executed = false;
-            std::string error;
-        };
-
-        void Init() {
-            std::cout << "[BegeerteScript] Initializing..." << std::endl;
-
-            // Get the root directory of the current process
-            char path_buffer[MAX_PATH];
-            GetModuleFileNameA(NULL, path_buffer, MAX_PATH); // Gets EXE path
-            std::filesystem::path root_dir = std::filesystem::path(path_buffer).parent_path();
-
-            // Set script and log directories
-            ScriptDirectory = root_dir / "Begeerte" / "Scripts";
-            LogDirectory = root_dir / "Begeerte" / "Logs";
-
-            // Create directories if they don't exist
-            std::filesystem::create_directories(ScriptDirectory);
-            std::filesystem::create_directories(LogDirectory);
-
-            std::cout << "[BegeerteScript] Scanning for .beg files in: " << ScriptDirectory << std::endl;
-
-            // Collect all script tasks
-            std::vector<ScriptTask> tasks;
-            for (const auto& entry : std::filesystem::directory_iterator(ScriptDirectory)) {
-                if (entry.is_regular_file() && entry.path().extension() == ".beg") {
-                    std::string script_path_str = entry.path().string();
-                    std::cout << "[BegeerteScript] Found script: " << script_path_str << std::endl;
-
-                    std::ifstream script_file(entry.path());
-                    if (!script_file.is_open()) {
-                        std::cerr << "[BegeerteScript] Error: Could not open script file: " << script_path_str << std::endl;
-                        continue;
-                    }
-
-                    std::stringstream script_buffer;
-                    script_buffer << script_file.rdbuf();
-                    script_file.close();
-                    std::string script_content = script_buffer.str();
-
-                    tasks.emplace_back(ScriptTask{ script_path_str, script_content });
-                }
-            }
-
-            std::cout << "[BegeerteScript] Total scripts found: " << tasks.size() << std::endl;
-
-            // Create a separate thread for each script
-            for (auto& task : tasks) {
-                std::thread script_thread([task]() {  // Capture task by value
-                    std::cout << "[BegeerteScript] Loading script: " << std::filesystem::path(task.path).filename() << std::endl;
-                    Interpreter interpreter;
-                    ScriptContext context(task.path);
-                    // Register common functions
-                    context.RegisterFunction("printf", Printf);
-                    context.RegisterFunction("print", Print);
-                    context.RegisterFunction("LogToFile", LogToFile);
-                    // Register EntityList API for this script
-                    RegisterEntityListAPI(context);
-
-                    if (!g_cheatdata) {
-                        std::string error = "[BegeerteScript] FATAL: g_cheatdata not initialized. Aborting script: " + task.path;
-                        std::cerr << error << std::endl;
-                        // Log to file
-                        {
-                            std::lock_guard<std::mutex> lock(LogMutex);
-                            std::ofstream log_file(LogDirectory / "Begeerte_script.log", std::ios::app);
-                            if (log_file.is_open()) {
-                                log_file << error << std::endl;
-                                log_file.close();
-                            }
-                        }
-                        return;
-                    }
-
-                    try {
-                        interpreter.Execute(task.content, context);
-                        std::cout << "[BegeerteScript] Finished executing: " << std::filesystem::path(task.path).filename() << std::endl;
-                    }
-                    catch (const std::exception& e) {
-                        std::string error = "[BegeerteScript] Unhandled exception in " + std::filesystem::path(task.path).filename().string() + ": " + e.what();
-                        std::cerr << error << std::endl;
-                        // Log to file
-                        {
-                            std::lock_guard<std::mutex> lock(LogMutex);
-                            std::ofstream log_file(LogDirectory / "Begeerte_script.log", std::ios::app);
-                            if (log_file.is_open()) {
-                                log_file << error << std::endl;
-                                log_file.close();
-                            }
-                        }
-                    }
-                    });
-                script_thread.detach();  // Detach the thread to run independently
-            }
-
-            std::cout << "[BegeerteScript] Initialization complete. Scripts are running in separate threads." << std::endl;
-        }
-
-    } // namespace Plugins
+#include "plugins.h"
+#include "Config.h"
+#include "ScriptLinter.h"
+#include "WorkerPool.h"
+#include "ScriptScheduler.h"
+#include "ScriptChannels.h"
+#include "Hook.h"
+#include "LoadGovernor.h"
+#include "ServiceLoop.h"
+#include "IdleMode.h"
+#include "ScriptFileIO.h"
+#include "Platform.h"
+#include <iostream>
+#include <filesystem>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <fstream>
+#include <chrono>
+#include <algorithm>
+
+// Ensure g_cheatdata is declared (it should be defined and initialized in your main project)
+// If not, you'll get a linker error.
+// For testing within this file, you could add a dummy one, but it's better to link properly.
+// extern CheatGlobalData* g_cheatdata; 
+// CheatGlobalData dummy_cheat_data; // If you must define it here for a self-contained example
+// CheatGlobalData* g_cheatdata = &dummy_cheat_data;
+
+namespace BegeerteScript {
+
+    static std::filesystem::path ScriptDirectory;
+    static std::filesystem::path LogDirectory;
+    static std::filesystem::path DataDirectory; // Root of the files file_read/file_write/file_append may touch
+    static std::mutex LogMutex;
+    // With [Scripts] LogFlushMs set, log lines collect here and the service thread appends them in one write
+    static std::string PendingLog;
+    static bool BufferLog = false;
+
+    // Caller holds LogMutex
+    static void WriteLogFile(const std::string& text) {
+        std::ofstream log_file(LogDirectory / "Begeerte_script.log", std::ios::app);
+        if (log_file.is_open()) {
+            log_file << text;
+        }
+        else {
+            std::cerr << "[BegeerteScript] Could not open log file: " << LogDirectory / "Begeerte_script.log" << std::endl;
+        }
+    }
+
+    // Caller holds LogMutex
+    static void AppendLog(const std::string& text) {
+        if (BufferLog) {
+            PendingLog += text;
+        }
+        else {
+            WriteLogFile(text);
+        }
+    }
+
+    // Hands the buffered lines to the I/O threads, so the service thread never waits for the disk either
+    static void FlushScriptLog() {
+        std::string text;
+        {
+            std::lock_guard<std::mutex> lock(LogMutex);
+            text.swap(PendingLog);
+        }
+        if (!text.empty()) {
+            ScriptFileIO::Submit(ScriptFileIO::Op::Append, LogDirectory / "Begeerte_script.log", std::move(text), nullptr);
+        }
+    }
+
+    // Modules compiled so far, keyed by normalized path. Shared by all script threads.
+    static std::map<std::string, ModulePtr> ModuleCache;
+    static std::mutex ModuleCacheMutex;
+
+    static constexpr size_t MaxCallDepth = 200;
+
+    // --- Interpreter Implementation (Simplified) ---
+    void Interpreter::Execute(const std::string& script_content, ScriptContext& context) {
+        auto module = std::make_shared<CompiledModule>();
+        module->path = context.current_script_path;
+        module->tokens = Tokenize(script_content, context.current_script_path);
+        RunModule(module, context);
+    }
+
+    void Interpreter::RunModule(const ModulePtr& module, ScriptContext& context) {
+        const std::vector<Token>& tokens = module->tokens;
+        size_t index = 0;
+        ModuleScope scope(*this, module);
+        try {
+            while (index < tokens.size() && tokens[index].type != Token::Type::END_OF_FILE) {
+                ParseStatement(tokens, index, context, module->path);
+                if (index < tokens.size() && tokens[index].type == Token::Type::END_OF_LINE) {
+                    index++; // Consume EOL
+                }
+            }
+        }
+        catch (const ReturnSignal&) {
+            // 'return' at the top level simply ends the module
+        }
+        catch (const std::exception& e) {
+            // SyntaxError already prints, this catches other runtime_errors from parsing if any
+            // Or if SyntaxError doesn't rethrow but we want to stop.
+            std::cerr << "Execution halted in '" << module->path << "' due to error: " << e.what() << std::endl;
+            throw; // Re-throw to allow caller to handle unloading
+        }
+    }
+
+    ModulePtr Interpreter::LoadModule(const std::filesystem::path& module_path) {
+        std::string key = module_path.lexically_normal().string();
+
+        // Held across read + tokenize so concurrent importers compile each module exactly once
+        std::lock_guard<std::mutex> lock(ModuleCacheMutex);
+        auto cached = ModuleCache.find(key);
+        if (cached != ModuleCache.end()) {
+            return cached->second;
+        }
+
+        std::ifstream module_file(module_path);
+        if (!module_file.is_open()) {
+            throw std::runtime_error("Could not open module: " + key);
+        }
+        std::stringstream module_buffer;
+        module_buffer << module_file.rdbuf();
+
+        auto module = std::make_shared<CompiledModule>();
+        module->path = key;
+        module->tokens = Tokenize(module_buffer.str(), key);
+        ModuleCache[key] = module;
+        std::cout << "[BegeerteScript] Compiled module: " << key << " (" << module->tokens.size() << " tokens)" << std::endl;
+        return module;
+    }
+
+    Value Interpreter::CallScriptFunction(const ScriptFunction& function, ArgList& args, ScriptContext& context) {
+        if (args.size() != function.params.size()) {
+            throw std::runtime_error("Script function expects " + std::to_string(function.params.size()) +
+                " argument(s), got " + std::to_string(args.size()) + ".");
+        }
+        if (context.frames.size() >= MaxCallDepth) {
+            throw std::runtime_error("Maximum call depth exceeded.");
+        }
+        // Preemption point, so recursion without loops is budgeted too
+        context.budget.Checkpoint(function.module->path);
+
+        VariableMap frame(context.memory.LongLived());
+        for (size_t i = 0; i < args.size(); ++i) {
+            frame[function.params[i]] = args[i];
+        }
+        context.frames.push_back(std::move(frame));
+
+        // Pops the frame on normal exit, 'return' and errors alike
+        struct FrameGuard {
+            ScriptContext& context;
+            ~FrameGuard() { context.frames.pop_back(); }
+        } guard{ context };
+        ModuleScope scope(*this, function.module);
+
+        size_t body_index = function.body_index;
+        try {
+            ParseBlock(function.module->tokens, body_index, context, function.module->path);
+        }
+        catch (const ReturnSignal& ret) {
+            return ret.value;
+        }
+        return Value();
+    }
+
+    std::vector<Interpreter::Token> Interpreter::Tokenize(const std::string& script_content, const std::string& script_path) {
+        return Lexer::Tokenize(script_content, script_path);
+    }
+
+    Value Interpreter::ParseFactor(const std::vector<Token>& tokens, size_t& index, ScriptContext& context, const std::string& script_path) {
+        if (index >= tokens.size()) SyntaxError("Unexpected end of input, expected factor", script_path, (tokens.empty() ? 0 : tokens.back().line_number));
+        const auto& token = tokens[index];
+
+        if (token.type == Token::Type::NUMBER) {
+            index++;
+            if (token.text.find('.') != std::string::npos) return Value(std::stod(token.text));
+            return Value(std::stoll(token.text));
+        }
+        if (token.type == Token::Type::STRING) {
+            index++;
+            return Value(token.text);
+        }
+        if (token.type == Token::Type::KEYWORD && token.text == "true") {
+            index++;
+            return Value(true);
+        }
+        if (token.type == Token::Type::KEYWORD && token.text == "false") {
+            index++;
+            return Value(false);
+        }
+        if (token.type == Token::Type::KEYWORD && token.text == "nil") {
+            index++;
+            return Value();
+        }
+        if (token.type == Token::Type::IDENTIFIER) {
+            std::string var_name = token.text;
+            index++;
+            if (index < tokens.size() && tokens[index].type == Token::Type::OPERATOR && tokens[index].text == "(") { // Function call
+                index++; // Consume '('
+                ArgList args = ParseArgumentList(tokens, index, context, script_path);
+                if (index >= tokens.size() || tokens[index].type != Token::Type::OPERATOR || tokens[index].text != ")") {
+                    SyntaxError("Expected ')' after function arguments", script_path, token.line_number);
+                }
+                index++; // Consume ')'
+                if (!context.HasFunction(var_name) && context.HasScriptFunction(var_name)) {
+                    return CallScriptFunction(context.script_functions[var_name], args, context);
+                }
+                return context.CallFunction(var_name, args, &token); // The token doubles as the call-site key
+            }
+            return context.GetVariable(var_name); // Variable access
+        }
+        if (token.type == Token::Type::OPERATOR && token.text == "(") { // Parenthesized expression
+            index++; // Consume '('
+            Value val = ParseExpression(tokens, index, context, script_path);
+            if (index >= tokens.size() || tokens[index].type != Token::Type::OPERATOR || tokens[index].text != ")") {
+                SyntaxError("Expected ')' after expression", script_path, token.line_number);
+            }
+            index++; // Consume ')'
+            return val;
+        }
+        // Basic unary minus/not for demonstration. Could be expanded.
+        if (token.type == Token::Type::OPERATOR && (token.text == "-" || token.text == "!")) {
+            std::string op = token.text;
+            index++;
+            Value operand = ParseFactor(tokens, index, context, script_path); // Higher precedence for unary
+            if (op == "-") {
+                if (operand.GetType() == Value::Type::NUMBER_INT) return Value(-operand.AsInt());
+                if (operand.GetType() == Value::Type::NUMBER_FLOAT) return Value(-operand.AsFloat());
+                SyntaxError("Operand for unary '-' must be a number.", script_path, token.line_number);
+            }
+            if (op == "!") {
+                return Value(!operand.IsTruthy());
+            }
+        }
+
+        SyntaxError("Unexpected token '" + token.text + "', expected a value, variable, or function call.", script_path, token.line_number);
+        return Value(); // Should not reach here
+    }
+
+    // Placeholder for Term (handles * / %) - for simplicity, merge into Expression or Factor for now
+    Value Interpreter::ParseTerm(const std::vector<Token>& tokens, size_t& index, ScriptContext& context, const std::string& script_path) {
+        Value left = ParseFactor(tokens, index, context, script_path);
+        while (index < tokens.size() && tokens[index].type == Token::Type::OPERATOR &&
+            (tokens[index].text == "*" || tokens[index].text == "/" || tokens[index].text == "%")) {
+            Token op_token = tokens[index];
+            index++;
+            Value right = ParseFactor(tokens, index, context, script_path);
+
+            if (left.GetType() != Value::Type::NUMBER_INT && left.GetType() != Value::Type::NUMBER_FLOAT ||
+                right.GetType() != Value::Type::NUMBER_INT && right.GetType() != Value::Type::NUMBER_FLOAT) {
+                SyntaxError("Operands for '" + op_token.text + "' must be numbers.", script_path, op_token.line_number);
+            }
+
+            bool use_float = (left.GetType() == Value::Type::NUMBER_FLOAT || right.GetType() == Value::Type::NUMBER_FLOAT);
+            double lval_f = left.AsFloat();
+            double rval_f = right.AsFloat();
+            long long lval_i = left.AsInt();
+            long long rval_i = right.AsInt();
+
+            if (op_token.text == "*") {
+                left = use_float ? Value(lval_f * rval_f) : Value(lval_i * rval_i);
+            }
+            else if (op_token.text == "/") {
+                if ((use_float && rval_f == 0.0) || (!use_float && rval_i == 0)) SyntaxError("Division by zero.", script_path, op_token.line_number);
+                left = use_float ? Value(lval_f / rval_f) : Value(lval_i / rval_i);
+            }
+            else if (op_token.text == "%") {
+                if (use_float) SyntaxError("Modulo operator '%' not supported for floats.", script_path, op_token.line_number);
+                if (rval_i == 0) SyntaxError("Modulo by zero.", script_path, op_token.line_number);
+                left = Value(lval_i % rval_i);
+            }
+        }
+        return left;
+    }
+
+    // Placeholder for Expression (handles + - and logical operators)
+    Value Interpreter::ParseExpression(const std::vector<Token>& tokens, size_t& index, ScriptContext& context, const std::string& script_path) {
+        Value left = ParseTerm(tokens, index, context, script_path); // Or ParseComparison for logical ops
+        while (index < tokens.size() && tokens[index].type == Token::Type::OPERATOR &&
+            (tokens[index].text == "+" || tokens[index].text == "-" ||
+                tokens[index].text == "==" || tokens[index].text == "!=" ||
+                tokens[index].text == "<" || tokens[index].text == "<=" ||
+                tokens[index].text == ">" || tokens[index].text == ">=" ||
+                tokens[index].text == "&&" || tokens[index].text == "||")) {
+            Token op_token = tokens[index];
+            index++;
+            Value right = ParseTerm(tokens, index, context, script_path); // Or ParseComparison
+
+            // Arithmetic
+            if (op_token.text == "+") {
+                if ((left.GetType() == Value::Type::NUMBER_INT || left.GetType() == Value::Type::NUMBER_FLOAT) &&
+                    (right.GetType() == Value::Type::NUMBER_INT || right.GetType() == Value::Type::NUMBER_FLOAT)) {
+                    bool use_float = (left.GetType() == Value::Type::NUMBER_FLOAT || right.GetType() == Value::Type::NUMBER_FLOAT);
+                    left = use_float ? Value(left.AsFloat() + right.AsFloat()) : Value(left.AsInt() + right.AsInt());
+                }
+                else if (left.GetType() == Value::Type::STRING || right.GetType() == Value::Type::STRING) { // String concatenation
+                    left = Value(left.AsString() + right.AsString());
+                }
+                else {
+                    SyntaxError("Invalid operands for '+'. Must be numbers or at least one string.", script_path, op_token.line_number);
+                }
+            }
+            else if (op_token.text == "-") {
+                if ((left.GetType() == Value::Type::NUMBER_INT || left.GetType() == Value::Type::NUMBER_FLOAT) &&
+                    (right.GetType() == Value::Type::NUMBER_INT || right.GetType() == Value::Type::NUMBER_FLOAT)) {
+                    bool use_float = (left.GetType() == Value::Type::NUMBER_FLOAT || right.GetType() == Value::Type::NUMBER_FLOAT);
+                    left = use_float ? Value(left.AsFloat() - right.AsFloat()) : Value(left.AsInt() - right.AsInt());
+                }
+                else {
+                    SyntaxError("Operands for '-' must be numbers.", script_path, op_token.line_number);
+                }
+            }
+            // Comparisons (simplified, no type coercion beyond basic number types)
+            else if (op_token.text == "==") {
+                // Basic equality, can be expanded
+                if (left.GetType() == right.GetType()) {
+                    if (left.GetType() == Value::Type::NIL) left = Value(true);
+                    else if (left.GetType() == Value::Type::BOOL) left = Value(left.AsBool() == right.AsBool());
+                    else if (left.GetType() == Value::Type::NUMBER_INT) left = Value(left.AsInt() == right.AsInt());
+                    else if (left.GetType() == Value::Type::NUMBER_FLOAT) left = Value(left.AsFloat() == right.AsFloat()); // Careful with float equality
+                    else if (left.GetType() == Value::Type::STRING) left = Value(left.AsString() == right.AsString());
+                    else if (left.GetType() == Value::Type::PLAYER_PTR) left = Value(left.AsPlayer() == right.AsPlayer());
+                    else left = Value(false); // Cannot compare other types for now
+                }
+                else if ((left.GetType() == Value::Type::NUMBER_INT && right.GetType() == Value::Type::NUMBER_FLOAT) ||
+                    (left.GetType() == Value::Type::NUMBER_FLOAT && right.GetType() == Value::Type::NUMBER_INT)) {
+                    left = Value(left.AsFloat() == right.AsFloat());
+                }
+                else left = Value(false);
+            }
+            else if (op_token.text == "!=") { // Implement similar to == but negated
+                if (left.GetType() == right.GetType()) {
+                    if (left.GetType() == Value::Type::NIL) left = Value(false);
+                    else if (left.GetType() == Value::Type::BOOL) left = Value(left.AsBool() != right.AsBool());
+                    else if (left.GetType() == Value::Type::NUMBER_INT) left = Value(left.AsInt() != right.AsInt());
+                    else if (left.GetType() == Value::Type::NUMBER_FLOAT) left = Value(left.AsFloat() != right.AsFloat());
+                    else if (left.GetType() == Value::Type::STRING) left = Value(left.AsString() != right.AsString());
+                    else if (left.GetType() == Value::Type::PLAYER_PTR) left = Value(left.AsPlayer() != right.AsPlayer());
+                    else left = Value(true);
+                }
+                else if ((left.GetType() == Value::Type::NUMBER_INT && right.GetType() == Value::Type::NUMBER_FLOAT) ||
+                    (left.GetType() == Value::Type::NUMBER_FLOAT && right.GetType() == Value::Type::NUMBER_INT)) {
+                    left = Value(left.AsFloat() != right.AsFloat());
+                }
+                else left = Value(true);
+            }
+            // Relational (numbers only for now)
+#define NUMERIC_COMPARE(op_char) \
+                if ((left.GetType() == Value::Type::NUMBER_INT || left.GetType() == Value::Type::NUMBER_FLOAT) && \
+                    (right.GetType() == Value::Type::NUMBER_INT || right.GetType() == Value::Type::NUMBER_FLOAT)) { \
+                    left = Value(left.AsFloat() op_char right.AsFloat()); \
+                } else { SyntaxError("Operands for '" + op_token.text + "' must be numbers.", script_path, op_token.line_number); }
+
+            else if (op_token.text == "<") { NUMERIC_COMPARE(< ) }
+            else if (op_token.text == "<=") { NUMERIC_COMPARE(<= ) }
+            else if (op_token.text == ">") { NUMERIC_COMPARE(> ) }
+            else if (op_token.text == ">=") { NUMERIC_COMPARE(>= ) }
+            // Logical
+            else if (op_token.text == "&&") {
+                if (!left.IsTruthy()) { // Short-circuit
+                    left = Value(false);
+                    // Need to skip evaluation of 'right' by advancing index past it properly
+                    // This simplified parser doesn't handle short-circuiting perfectly in ParseTerm yet
+                }
+                else {
+                    left = Value(right.IsTruthy());
+                }
+            }
+            else if (op_token.text == "||") {
+                if (left.IsTruthy()) { // Short-circuit
+                    left = Value(true);
+                    // Skip 'right'
+                }
+                else {
+                    left = Value(right.IsTruthy());
+                }
+            }
+        }
+        return left;
+    }
+
+    ArgList Interpreter::ParseArgumentList(const std::vector<Token>& tokens, size_t& index, ScriptContext& context, const std::string& script_path) {
+        ArgList args(context.memory.Scratch());
+        if (tokens[index].type == Token::Type::OPERATOR && tokens[index].text == ")") { // Empty arg list
+            return args;
+        }
+        while (index < tokens.size()) {
+            args.push_back(ParseExpression(tokens, index, context, script_path));
+            if (index < tokens.size() && tokens[index].type == Token::Type::OPERATOR && tokens[index].text == ",") {
+                index++; // Consume ','
+            }
+            else {
+                break; // End of arguments or syntax error (handled by caller checking for ')')
+            }
+        }
+        return args;
+    }
+
+    void Interpreter::ParseStatement(const std::vector<Token>& tokens, size_t& index, ScriptContext& context, const std::string& script_path) {
+        if (index >= tokens.size() || tokens[index].type == Token::Type::END_OF_FILE) return;
+
+        const auto& current_token = tokens[index];
+
+        if (current_token.type == Token::Type::KEYWORD && current_token.text == "let") {
+            ParseAssignmentOrFunctionCall(tokens, index, context, script_path);
+        }
+        else if (current_token.type == Token::Type::IDENTIFIER) {
+            // Could be assignment (if next is '=') or just a function call
+            if (index + 1 < tokens.size() && tokens[index + 1].type == Token::Type::OPERATOR && tokens[index + 1].text == "=") {
+                ParseAssignmentOrFunctionCall(tokens, index, context, script_path);
+            }
+            else { // Assume function call statement if not assignment
+                ParseFactor(tokens, index, context, script_path); // This will parse and execute the function call
+            }
+        }
+        else if (current_token.type == Token::Type::KEYWORD && current_token.text == "if") {
+            ParseIfStatement(tokens, index, context, script_path);
+        }
+        else if (current_token.type == Token::Type::KEYWORD && current_token.text == "while") {
+            ParseWhileStatement(tokens, index, context, script_path);
+        }
+        else if (current_token.type == Token::Type::KEYWORD && current_token.text == "for") {
+            ParseForStatement(tokens, index, context, script_path, false);
+        }
+        else if (current_token.type == Token::Type::KEYWORD && current_token.text == "parallel") {
+            index++; // Consume 'parallel'
+            if (index >= tokens.size() || tokens[index].type != Token::Type::KEYWORD || tokens[index].text != "for") {
+                SyntaxError("Expected 'for' after 'parallel'.", script_path, current_token.line_number);
+            }
+            ParseForStatement(tokens, index, context, script_path, true);
+        }
+        else if (current_token.type == Token::Type::KEYWORD && current_token.text == "import") {
+            ParseImportStatement(tokens, index, context, script_path);
+        }
+        else if (current_token.type == Token::Type::KEYWORD && current_token.text == "function") {
+            ParseFunctionDefinition(tokens, index, context, script_path);
+        }
+        else if (current_token.type == Token::Type::KEYWORD && current_token.text == "return") {
+            ParseReturnStatement(tokens, index, context, script_path);
+        }
+        else if (current_token.type == Token::Type::OPERATOR && current_token.text == "{") {
+            ParseBlock(tokens, index, context, script_path); // Standalone block (less common but possible)
+        }
+        else if (current_token.type == Token::Type::END_OF_LINE) {
+            index++; // Consume EOL, do nothing
+            return;
+        }
+        else {
+            SyntaxError("Unexpected token at start of statement: " + current_token.text, script_path, current_token.line_number);
+        }
+
+        // Expect a semicolon or EOL after most statements, but our tokenizer treats EOL as a token
+        if (index < tokens.size() && tokens[index].type == Token::Type::OPERATOR && tokens[index].text == ";") {
+            index++; // Consume semicolon
+        }
+    }
+
+    void Interpreter::ParseAssignmentOrFunctionCall(const std::vector<Token>& tokens, size_t& index, ScriptContext& context, const std::string& script_path) {
+        bool is_declaration = false;
+        if (tokens[index].type == Token::Type::KEYWORD && tokens[index].text == "let") {
+            is_declaration = true;
+            index++; // Consume 'let'
+        }
+
+        if (index >= tokens.size() || tokens[index].type != Token::Type::IDENTIFIER) {
+            SyntaxError("Expected identifier after 'let' or at start of assignment.", script_path, (tokens.empty() ? 0 : tokens[index - 1].line_number));
+        }
+        std::string var_name = tokens[index].text;
+        size_t var_line = tokens[index].line_number;
+        index++;
+
+        if (!is_declaration && index < tokens.size() && tokens[index].type == Token::Type::OPERATOR && tokens[index].text == "(") {
+            // It was just an identifier, likely a function call statement.
+            // Rewind and parse as factor (which handles function calls).
+            index -= 1; // Rewind to identifier
+            ParseFactor(tokens, index, context, script_path); // This will parse and execute the function call
+            return;
+        }
+
+        if (index >= tokens.size() || tokens[index].type != Token::Type::OPERATOR || tokens[index].text != "=") {
+            SyntaxError("Expected '=' after identifier in assignment.", script_path, var_line);
+        }
+        index++; // Consume '='
+
+        Value val = ParseExpression(tokens, index, context, script_path);
+        if (is_declaration) {
+            context.DeclareVariable(var_name, val);
+        }
+        else {
+            context.SetVariable(var_name, val);
+        }
+    }
+
+    void Interpreter::ParseImportStatement(const std::vector<Token>& tokens, size_t& index, ScriptContext& context, const std::string& script_path) {
+        size_t import_line = tokens[index].line_number;
+        index++; // Consume 'import'
+
+        if (index >= tokens.size() || tokens[index].type != Token::Type::STRING) {
+            SyntaxError("Expected module path string after 'import'.", script_path, import_line);
+        }
+        if (!context.frames.empty()) {
+            SyntaxError("'import' is only allowed at the top level.", script_path, import_line);
+        }
+        // Module paths are relative to the Scripts directory, e.g. import "lib/genetics.beg"
+        std::filesystem::path module_path = ScriptDirectory / tokens[index].text;
+        index++; // Consume path
+
+        std::string key = module_path.lexically_normal().string();
+        if (context.imported_modules.count(key)) {
+            return; // Already imported into this context (also breaks import cycles)
+        }
+        context.imported_modules.insert(key);
+
+        ModulePtr module;
+        try {
+            module = LoadModule(module_path);
+        }
+        catch (const std::exception& e) {
+            SyntaxError(e.what(), script_path, import_line);
+        }
+        RunModule(module, context);
+    }
+
+    void Interpreter::ParseFunctionDefinition(const std::vector<Token>& tokens, size_t& index, ScriptContext& context, const std::string& script_path) {
+        size_t function_line = tokens[index].line_number;
+        index++; // Consume 'function'
+
+        if (index >= tokens.size() || tokens[index].type != Token::Type::IDENTIFIER) {
+            SyntaxError("Expected function name after 'function'.", script_path, function_line);
+        }
+        std::string name = tokens[index].text;
+        if (context.HasFunction(name)) {
+            SyntaxError("Function '" + name + "' shadows a native function.", script_path, function_line);
+        }
+        index++; // Consume name
+
+        if (index >= tokens.size() || tokens[index].type != Token::Type::OPERATOR || tokens[index].text != "(") {
+            SyntaxError("Expected '(' after function name.", script_path, function_line);
+        }
+        index++; // Consume '('
+
+        ScriptFunction function;
+        while (index < tokens.size() && !(tokens[index].type == Token::Type::OPERATOR && tokens[index].text == ")")) {
+            if (tokens[index].type != Token::Type::IDENTIFIER) {
+                SyntaxError("Expected parameter name in definition of '" + name + "'.", script_path, function_line);
+            }
+            function.params.push_back(tokens[index].text);
+            index++;
+            if (index < tokens.size() && tokens[index].type == Token::Type::OPERATOR && tokens[index].text == ",") {
+                index++; // Consume ','
+            }
+        }
+        if (index >= tokens.size()) {
+            SyntaxError("Unterminated parameter list in definition of '" + name + "'.", script_path, function_line);
+        }
+        index++; // Consume ')'
+
+        if (index >= tokens.size() || tokens[index].type != Token::Type::OPERATOR || tokens[index].text != "{") {
+            SyntaxError("Expected '{' to start body of '" + name + "'.", script_path, function_line);
+        }
+
+        function.module = current_module; // The body stays in the module currently being run
+        function.body_index = index;
+        context.script_functions[name] = function;
+
+        SkipBlock(tokens, index, script_path); // Body runs only when called
+    }
+
+    void Interpreter::ParseReturnStatement(const std::vector<Token>& tokens, size_t& index, ScriptContext& context, const std::string& script_path) {
+        index++; // Consume 'return'
+        Value val;
+        if (index < tokens.size() && tokens[index].type != Token::Type::END_OF_LINE && tokens[index].type != Token::Type::END_OF_FILE &&
+            !(tokens[index].type == Token::Type::OPERATOR && (tokens[index].text == "}" || tokens[index].text == ";"))) {
+            val = ParseExpression(tokens, index, context, script_path);
+        }
+        throw ReturnSignal{ val };
+    }
+
+    void Interpreter::SkipBlock(const std::vector<Token>& tokens, size_t& index, const std::string& script_path) {
+        if (index >= tokens.size() || tokens[index].type != Token::Type::OPERATOR || tokens[index].text != "{") {
+            // If not a block, assume single statement and try to skip it.
+            // This is tricky without full grammar. For now, just skip until EOL or ';'.
+            while (index < tokens.size() && tokens[index].type != Token::Type::END_OF_LINE &&
+                !(tokens[index].type == Token::Type::OPERATOR && tokens[index].text == ";")) {
+                index++;
+            }
+            if (index < tokens.size() && (tokens[index].type == Token::Type::END_OF_LINE || (tokens[index].type == Token::Type::OPERATOR && tokens[index].text == ";"))) {
+                index++; // consume EOL or ;
+            }
+            return;
+        }
+
+        index++; // Consume '{'
+        int brace_level = 1;
+        while (index < tokens.size() && brace_level > 0) {
+            if (tokens[index].type == Token::Type::OPERATOR && tokens[index].text == "{") {
+                brace_level++;
+            }
+            else if (tokens[index].type == Token::Type::OPERATOR && tokens[index].text == "}") {
+                brace_level--;
+            }
+            index++;
+        }
+        if (brace_level > 0) {
+            SyntaxError("Unterminated block while skipping.", script_path, tokens[index - 1].line_number);
+        }
+    }
+
+    void Interpreter::ParseBlock(const std::vector<Token>& tokens, size_t& index, ScriptContext& context, const std::string& script_path) {
+        if (index >= tokens.size() || tokens[index].type != Token::Type::OPERATOR || tokens[index].text != "{") {
+            SyntaxError("Expected '{' to start a block.", script_path, (tokens.empty() ? 0 : tokens[index].line_number));
+        }
+        index++; // Consume '{'
+
+        while (index < tokens.size() && !(tokens[index].type == Token::Type::OPERATOR && tokens[index].text == "}")) {
+            ParseStatement(tokens, index, context, script_path);
+            if (index < tokens.size() && tokens[index].type == Token::Type::END_OF_LINE) {
+                index++; // Consume EOL within block
+            }
+        }
+
+        if (index >= tokens.size() || !(tokens[index].type == Token::Type::OPERATOR && tokens[index].text == "}")) {
+            SyntaxError("Expected '}' to end a block.", script_path, (tokens.empty() ? 0 : tokens[index - 1].line_number));
+        }
+        index++; // Consume '}'
+    }
+
+    void Interpreter::ParseIfStatement(const std::vector<Token>& tokens, size_t& index, ScriptContext& context, const std::string& script_path) {
+        size_t if_line = tokens[index].line_number;
+        index++; // Consume 'if'
+
+        if (index >= tokens.size() || tokens[index].type != Token::Type::OPERATOR || tokens[index].text != "(") {
+            SyntaxError("Expected '(' after 'if'.", script_path, if_line);
+        }
+        index++; // Consume '('
+
+        Value condition = ParseExpression(tokens, index, context, script_path);
+
+        if (index >= tokens.size() || tokens[index].type != Token::Type::OPERATOR || tokens[index].text != ")") {
+            SyntaxError("Expected ')' after if condition.", script_path, if_line);
+        }
+        index++; // Consume ')'
+
+        bool condition_true = condition.IsTruthy();
+        bool executed_branch = false;
+
+        if (condition_true) {
+            executed_branch = true;
+            if (tokens[index].type == Token::Type::OPERATOR && tokens[index].text == "{") {
+                ParseBlock(tokens, index, context, script_path);
+            }
+            else { // Single statement
+                ParseStatement(tokens, index, context, script_path);
+            }
+        }
+        else {
+            // Skip the 'then' block/statement
+            if (tokens[index].type == Token::Type::OPERATOR && tokens[index].text == "{") {
+                SkipBlock(tokens, index, script_path);
+            }
+            else { // Single statement
+                // A bit naive, just skip one statement (until EOL/;)
+                size_t temp_idx = index;
+                ParseStatement(tokens, temp_idx, context, script_path); // "Dry run" to advance index past one statement
+                index = temp_idx; // This is problematic, SkipBlock is better
+            }
+        }
+
+        // Handle 'else if' and 'else'
+        if (index < tokens.size() && tokens[index].type == Token::Type::KEYWORD && tokens[index].text == "else") {
+            index++; // Consume 'else'
+            if (index < tokens.size() && tokens[index].type == Token::Type::KEYWORD && tokens[index].text == "if") { // else if
+                if (!condition_true) { // Only parse 'else if' if previous conditions were false
+                    ParseIfStatement(tokens, index, context, script_path); // Recursive call for 'else if' (consumes the 'if' part)
+                }
+                else {
+                    // Skip the entire 'else if (...){...}' block
+                    index++; // consume 'if' for skipping
+                    if (index < tokens.size() && tokens[index].text == "(") index++; else SyntaxError("Expected ( for else if skip", script_path, tokens[index - 1].line_number);
+                    int paren_level = 1;
+                    while (index < tokens.size() && paren_level > 0) {
+                        if (tokens[index].text == "(") paren_level++;
+                        if (tokens[index].text == ")") paren_level--;
+                        index++;
+                    }
+                    if (paren_level > 0) SyntaxError("Unterminated condition in 'else if' during skip.", script_path, tokens[index - 1].line_number);
+                    SkipBlock(tokens, index, script_path);
+                }
+            }
+            else { // 'else' block
+                if (!condition_true && !executed_branch) { // Only execute if no prior 'if' or 'else if' was true
+                    if (tokens[index].type == Token::Type::OPERATOR && tokens[index].text == "{") {
+                        ParseBlock(tokens, index, context, script_path);
+                    }
+                    else { // Single statement
+                        ParseStatement(tokens, index, context, script_path);
+                    }
+                }
+                else {
+                    SkipBlock(tokens, index, script_path);
+                }
+            }
+        }
+    }
+
+    void Interpreter::ParseWhileStatement(const std::vector<Token>& tokens, size_t& index, ScriptContext& context, const std::string& script_path) {
+        size_t while_line = tokens[index].line_number;
+        index++; // Consume 'while'
+
+        if (index >= tokens.size() || tokens[index].type != Token::Type::OPERATOR || tokens[index].text != "(") {
+            SyntaxError("Expected '(' after 'while'.", script_path, while_line);
+        }
+        size_t condition_start_index = index; // For re-evaluation
+        index++; // Consume '('
+
+        // Loop execution
+        while (true) {
+            size_t current_eval_index = condition_start_index + 1; // Start after '('
+            Value condition = ParseExpression(tokens, current_eval_index, context, script_path);
+
+            if (current_eval_index >= tokens.size() || tokens[current_eval_index].type != Token::Type::OPERATOR || tokens[current_eval_index].text != ")") {
+                SyntaxError("Expected ')' after while condition.", script_path, while_line);
+            }
+            // current_eval_index is now at ')'
+
+            if (!condition.IsTruthy()) {
+                index = current_eval_index + 1; // Move main index past condition ')'
+                SkipBlock(tokens, index, script_path); // Skip the loop body
+                break; // Exit loop
+            }
+
+            // Condition is true, execute body
+            size_t body_start_index = current_eval_index + 1; // After ')'
+            size_t temp_body_index = body_start_index; // Use a temporary index for the body execution
+
+            if (temp_body_index >= tokens.size()) { // Should not happen if ')' was found
+                SyntaxError("Unexpected end of script after while condition.", script_path, while_line);
+                break;
+            }
+
+            if (tokens[temp_body_index].type == Token::Type::OPERATOR && tokens[temp_body_index].text == "{") {
+                ParseBlock(tokens, temp_body_index, context, script_path);
+            }
+            else {
+                ParseStatement(tokens, temp_body_index, context, script_path);
+            }
+            // Loop back-edge: argument lists of this iteration are dead, rewind the scratch arena
+            context.memory.ResetScratch();
+            // Preemption point: yields once the time slice or instruction budget is used up
+            context.budget.Checkpoint(script_path);
+            // After body execution, loop back to re-evaluate condition (main 'index' is not changed by body parsing)
+        }
+    }
+
+    void Interpreter::ParseForStatement(const std::vector<Token>& tokens, size_t& index, ScriptContext& context, const std::string& script_path, bool parallel) {
+        size_t for_line = tokens[index].line_number;
+        index++; // Consume 'for'
+
+        // Only 'for (name in Players())' for now
+        auto expect = [&](Token::Type type, const char* text, const std::string& message) {
+            if (index >= tokens.size() || tokens[index].type != type || (text && tokens[index].text != text)) {
+                SyntaxError(message, script_path, for_line);
+            }
+            return tokens[index++].text;
+        };
+        expect(Token::Type::OPERATOR, "(", "Expected '(' after 'for'.");
+        std::string var_name = expect(Token::Type::IDENTIFIER, nullptr, "Expected loop variable name in 'for'.");
+        expect(Token::Type::KEYWORD, "in", "Expected 'in' after loop variable.");
+        expect(Token::Type::IDENTIFIER, "Players", "Only 'Players()' can be iterated by 'for'.");
+        expect(Token::Type::OPERATOR, "(", "Expected '()' after 'Players'.");
+        expect(Token::Type::OPERATOR, ")", "Expected '()' after 'Players'.");
+        expect(Token::Type::OPERATOR, ")", "Expected ')' after 'for' source.");
+        if (index >= tokens.size() || tokens[index].type != Token::Type::OPERATOR || tokens[index].text != "{") {
+            SyntaxError("Expected '{' to start the 'for' body.", script_path, for_line);
+        }
+
+        size_t body_index = index;
+        SkipBlock(tokens, index, script_path); // Leaves 'index' after the body
+
+        std::vector<EntityList::Player*> players = EntityList::GetValidPlayers();
+        if (parallel) {
+            RunParallelFor(tokens, body_index, var_name, players, context, script_path);
+            return;
+        }
+        for (EntityList::Player* player : players) {
+            context.DeclareVariable(var_name, Value(player));
+            size_t iteration_index = body_index;
+            ParseBlock(tokens, iteration_index, context, script_path);
+            context.memory.ResetScratch();
+            context.budget.Checkpoint(script_path);
+        }
+    }
+
+    // Starts a worker context (a parallel for chunk or a spawn() job) from a snapshot of the caller's globals
+    // and functions. Natives that keep per-context state are rebound, so workers never touch the caller's.
+    static void InheritContext(const ScriptContext& caller, ScriptContext& worker) {
+        for (const auto& variable : caller.variables) {
+            worker.StoreGlobal(variable.first, variable.second);
+        }
+        worker.functions = caller.functions;
+        Plugins::RegisterSchedulerAPI(worker);
+        Plugins::RegisterChannelAPI(worker);
+        Plugins::RegisterJobAPI(worker);
+        Plugins::RegisterFileAPI(worker);
+        // The inherited watch_fields would change the caller's event subscription from a pool thread while the
+        // caller keeps running
+        worker.RegisterFunction("watch_fields", [](ArgList& args) -> Value {
+            throw std::runtime_error("watch_fields is not allowed in a worker ('parallel for' body or spawned function), call it from the script itself.");
+            });
+        worker.script_functions = caller.script_functions;
+        worker.imported_modules = caller.imported_modules;
+        worker.native_cache.enabled = caller.native_cache.enabled;
+        worker.budget = ScriptBudget(caller.budget.Limits());
+        worker.budget.SetDeadline(caller.budget.Deadline()); // A 'parallel for' inside on_tick is held to its cap
+    }
+
+    // Splits the players into chunks on the shared worker pool. Every chunk runs in its own context that
+    // starts from a snapshot of the caller's variables, so workers never touch each other's state.
+    // Merge rule: 'let' inside the body is per iteration; assignments to variables from outside the loop
+    // are replayed into the caller afterwards in player order, so the last player that writes one wins.
+    // Every iteration sees those variables as they were before the loop.
+    void Interpreter::RunParallelFor(const std::vector<Token>& tokens, size_t body_index, const std::string& var_name,
+        const std::vector<EntityList::Player*>& players, ScriptContext& context, const std::string& script_path) {
+        if (players.empty()) {
+            return;
+        }
+        WorkerPool& pool = WorkerPool::Shared();
+        size_t chunk_count = std::min(players.size(), (pool.Size() + 1) * 2);
+        size_t chunk_size = (players.size() + chunk_count - 1) / chunk_count;
+
+        std::vector<std::vector<ScriptContext::Write>> writes(players.size());
+        std::vector<WorkerPool::Task> tasks;
+        for (size_t begin = 0; begin < players.size(); begin += chunk_size) {
+            size_t end = std::min(players.size(), begin + chunk_size);
+            tasks.push_back([&, begin, end] {
+                ScriptContext worker(context.current_script_path, context.memory.Limit());
+                InheritContext(context, worker);
+                worker.parallel_body = true;
+
+                VariableMap outer_locals(worker.memory.LongLived());
+                if (!context.frames.empty()) {
+                    outer_locals.insert(context.frames.back().begin(), context.frames.back().end());
+                }
+                worker.outer_locals = &outer_locals;
+
+                Interpreter interpreter;
+                interpreter.current_module = current_module;
+                for (size_t i = begin; i < end; ++i) {
+                    worker.frames.clear();
+                    worker.frames.emplace_back(outer_locals, worker.memory.LongLived());
+                    worker.frames.back()[var_name] = Value(players[i]);
+                    worker.write_log = &writes[i];
+
+                    size_t iteration_index = body_index;
+                    try {
+                        interpreter.ParseBlock(tokens, iteration_index, worker, script_path);
+                    }
+                    catch (const ReturnSignal&) {
+                        throw std::runtime_error("'return' is not allowed inside 'parallel for'.");
+                    }
+
+                    // Put globals back to their pre-loop values for the next iteration
+                    worker.write_log = nullptr;
+                    for (const auto& write : writes[i]) {
+                        if (outer_locals.count(write.name)) continue;
+                        auto original = context.variables.find(write.name);
+                        if (original != context.variables.end()) {
+                            worker.StoreGlobal(write.name, original->second);
+                        }
+                        else {
+                            worker.StoreGlobal(write.name, Value());
+                            worker.variables.erase(write.name);
+                        }
+                    }
+                    worker.memory.ResetScratch();
+                }
+                worker.frames.clear();
+                });
+        }
+        // The calling coroutine blocks its scheduler thread until every chunk is done; chunks it runs itself
+        // must not switch it out in the middle of RunAll. Each chunk has the script's watchdog budget, which
+        // bounds how long the other scripts on that thread can be held up.
+        struct PreemptionGuard {
+            bool was_preemptible = ScriptScheduler::Preemptible();
+            PreemptionGuard() { ScriptScheduler::HoldPreemption(true); }
+            ~PreemptionGuard() { if (was_preemptible) ScriptScheduler::HoldPreemption(false); }
+        } guard;
+        pool.RunAll(tasks);
+
+        for (const auto& iteration : writes) {
+            for (const auto& write : iteration) {
+                context.SetVariable(write.name, write.value);
+            }
+        }
+    }
+
+    // --- Plugin Namespace Functions ---
+    namespace Plugins {
+
+        Value Printf(ArgList& args) {
+            if (args.empty()) return Value();
+            printf(args[0].AsString().c_str());
+            return Value();
+        }
+
+        Value Print(ArgList& args) {
+            for (size_t i = 0; i < args.size(); ++i) {
+                std::cout << args[i].AsString();
+                if (i < args.size() - 1) {
+                    std::cout << " ";
+                }
+            }
+            std::cout << std::endl;
+            return Value(); // Print returns nil
+        }
+
+        Value LogToFile(ArgList& args) {
+            if (args.empty() || args[0].GetType() != Value::Type::STRING) {
+                std::cerr << "LogToFile Error: Requires a string argument for the message." << std::endl;
+                return Value();
+            }
+            std::string line;
+            for (const auto& arg : args) {
+                line += arg.AsString() + " ";
+            }
+            line += "\n";
+            std::lock_guard<std::mutex> lock(LogMutex);
+            AppendLog(line);
+            return Value();
+        }
+
+        // --- Script timers ---
+        // Timers fire on the script's own coroutine: inside its wait()/wait_ticks()/yield() calls while the top
+        // level runs, and from ServeScript once it has finished. Callbacks therefore never overlap with the
+        // script's own code, and the coroutine sleeps until the next deadline in between.
+        static bool ServesTimers(ScriptContext& context) {
+            return context.timers.owner != 0 && context.timers.owner == ScriptScheduler::CurrentId() &&
+                !context.timers.firing && !context.timers.wheel.Empty();
+        }
+
+        static void FireTimers(ScriptContext& context) {
+            ScriptTimers& timers = context.timers;
+            Interpreter interpreter;
+            timers.firing = true;
+            struct FiringGuard {
+                ScriptTimers& timers;
+                ~FiringGuard() { timers.firing = false; }
+            } guard{ timers };
+            timers.wheel.Advance(ScriptTimers::NowMs(), [&](TimerWheel::TimerId id, uint64_t periodic) {
+                auto callback = timers.callbacks.find(id);
+                if (callback == timers.callbacks.end()) {
+                    return;
+                }
+                std::string name = callback->second;
+                if (!periodic) {
+                    timers.callbacks.erase(callback);
+                }
+                auto function = context.script_functions.find(name);
+                try {
+                    if (function == context.script_functions.end()) {
+                        throw std::runtime_error("Function '" + name + "' not found.");
+                    }
+                    ArgList args(context.memory.Scratch());
+                    if (function->second.params.size() == 1) {
+                        args.emplace_back(static_cast<long long>(id));
+                    }
+                    interpreter.CallScriptFunction(function->second, args, context);
+                }
+                catch (const ScriptMemoryError&) {
+                    throw;
+                }
+                catch (const ScriptWatchdogError&) {
+                    throw;
+                }
+                catch (const std::exception& e) {
+                    std::string error = "[BegeerteScript] Timer '" + name + "' in " + context.current_script_path + " failed and was cancelled: " + e.what();
+                    std::cerr << error << std::endl;
+                    WriteScriptLog(error);
+                    timers.wheel.Cancel(id);
+                    timers.callbacks.erase(id);
+                }
+                });
+        }
+
+        // Sleeps until 'wake_time', firing the script's timers as they come due
+        static void SleepServingTimers(ScriptContext& context, ScriptScheduler::Clock::time_point wake_time) {
+            while (ServesTimers(context)) {
+                FireTimers(context);
+                if (context.timers.wheel.Empty()) {
+                    break;
+                }
+                auto next_timer = ScriptScheduler::Clock::time_point(std::chrono::milliseconds(context.timers.wheel.NextDeadline()));
+                if (next_timer >= wake_time) {
+                    break;
+                }
+                ScriptScheduler::SleepUntil(next_timer);
+            }
+            ScriptScheduler::SleepUntil(wake_time);
+            if (ServesTimers(context)) {
+                FireTimers(context);
+            }
+        }
+
+        static Value AddTimer(ScriptContext& context, ArgList& args, bool periodic) {
+            const char* name = periodic ? "set_interval" : "set_timeout";
+            if (args.size() != 2 || (args[0].GetType() != Value::Type::NUMBER_INT && args[0].GetType() != Value::Type::NUMBER_FLOAT) ||
+                args[1].GetType() != Value::Type::STRING) {
+                throw std::runtime_error(std::string(name) + " requires 2 arguments (milliseconds, function name).");
+            }
+            if (context.timers.owner == 0 || context.timers.owner != ScriptScheduler::CurrentId()) {
+                throw std::runtime_error(std::string(name) + " can only be used from the script's own code and its timers, not from on_player or on_tick.");
+            }
+            long long ms = args[0].AsInt();
+            if (ms < 0 || (periodic && ms == 0)) {
+                throw std::runtime_error(std::string(name) + " needs a " + (periodic ? "positive" : "non-negative") + " interval.");
+            }
+            uint64_t delay = static_cast<uint64_t>(ms);
+            TimerWheel::TimerId id = context.timers.wheel.Schedule(ScriptTimers::NowMs() + delay, periodic ? delay : 0, periodic ? 1 : 0);
+            context.timers.callbacks[id] = args[1].AsString();
+            return Value(static_cast<long long>(id));
+        }
+
+        // Set while on_tick handlers run inside the server tick, where suspending is not allowed
+        static thread_local bool InServerTick = false;
+
+        // 'parallel for' bodies cannot suspend either: on a pool thread wait() would block a shared worker, on
+        // the caller's own thread it would switch the coroutine out in the middle of the loop
+        static void RejectInParallelFor(const ScriptContext& context, const char* native) {
+            if (context.parallel_body) {
+                throw std::runtime_error(std::string(native) + " cannot be used inside 'parallel for', use a plain 'for' loop to wait.");
+            }
+        }
+
+        void RegisterSchedulerAPI(ScriptContext& context) {
+            context.RegisterFunction("wait", [&context](ArgList& args) -> Value {
+                if (args.size() != 1 || (args[0].GetType() != Value::Type::NUMBER_INT && args[0].GetType() != Value::Type::NUMBER_FLOAT)) {
+                    throw std::runtime_error("wait requires 1 number argument (milliseconds).");
+                }
+                if (InServerTick) {
+                    throw std::runtime_error("wait cannot be used in on_tick, it would stall the game thread.");
+                }
+                RejectInParallelFor(context, "wait");
+                long long ms = args[0].AsInt();
+                SleepServingTimers(context, ScriptScheduler::Now() + std::chrono::milliseconds(ms > 0 ? ms : 0));
+                return Value();
+                });
+
+            context.RegisterFunction("yield", [&context](ArgList& args) -> Value {
+                if (InServerTick) {
+                    throw std::runtime_error("yield cannot be used in on_tick, it would stall the game thread.");
+                }
+                RejectInParallelFor(context, "yield");
+                ScriptScheduler::Yield();
+                if (ServesTimers(context)) {
+                    FireTimers(context);
+                }
+                return Value();
+                });
+
+            context.RegisterFunction("wait_ticks", [&context](ArgList& args) -> Value {
+                if (args.size() != 1 || args[0].GetType() != Value::Type::NUMBER_INT) {
+                    throw std::runtime_error("wait_ticks requires 1 integer argument (ticks).");
+                }
+                if (InServerTick) {
+                    throw std::runtime_error("wait_ticks cannot be used in on_tick, it would stall the game thread.");
+                }
+                RejectInParallelFor(context, "wait_ticks");
+                // Scripts that step once per tick step less often while the server is overloaded
+                long long ticks = std::max(args[0].AsInt(), 1LL) * LoadGovernor::Scale();
+                SleepServingTimers(context, ScriptScheduler::Shared().TickDeadline(static_cast<uint64_t>(ticks)));
+                return Value();
+                });
+
+            context.RegisterFunction("set_timeout", [&context](ArgList& args) -> Value {
+                return AddTimer(context, args, false);
+                });
+
+            context.RegisterFunction("set_interval", [&context](ArgList& args) -> Value {
+                return AddTimer(context, args, true);
+                });
+
+            context.RegisterFunction("cancel", [&context](ArgList& args) -> Value {
+                if (args.size() != 1 || args[0].GetType() != Value::Type::NUMBER_INT) {
+                    throw std::runtime_error("cancel requires 1 integer argument (timer id).");
+                }
+                if (context.timers.owner == 0 || context.timers.owner != ScriptScheduler::CurrentId()) {
+                    throw std::runtime_error("cancel can only be used from the script's own code and its timers.");
+                }
+                TimerWheel::TimerId id = static_cast<TimerWheel::TimerId>(args[0].AsInt());
+                context.timers.callbacks.erase(id);
+                return Value(context.timers.wheel.Cancel(id));
+                });
+
+            context.RegisterFunction("set_priority", [](ArgList& args) -> Value {
+                if (args.empty() || args.size() > 2 || args[0].GetType() != Value::Type::STRING ||
+                    (args.size() == 2 && args[1].GetType() != Value::Type::NUMBER_INT)) {
+                    throw std::runtime_error("set_priority requires a class (critical, normal or batch) and an optional deadline in milliseconds.");
+                }
+                if (InServerTick) {
+                    throw std::runtime_error("set_priority cannot be used in on_tick, the game thread is not scheduled.");
+                }
+                ScriptScheduler::Priority priority;
+                if (!ScriptScheduler::ParsePriority(args[0].AsString(), priority)) {
+                    throw std::runtime_error("set_priority: unknown class '" + args[0].AsString() + "', expected critical, normal or batch.");
+                }
+                long long deadline_ms = args.size() == 2 ? args[1].AsInt() : 0;
+                if (!ScriptScheduler::SetPriority(priority, std::chrono::milliseconds(deadline_ms > 0 ? deadline_ms : 0))) {
+                    throw std::runtime_error("set_priority can only be used from a script's own coroutine.");
+                }
+                return Value();
+                });
+
+            context.RegisterFunction("Server_GetFrameTime", [](ArgList& args) -> Value {
+                return Value(LoadGovernor::FrameMs());
+                });
+
+            context.RegisterFunction("Server_GetThrottle", [](ArgList& args) -> Value {
+                return Value(static_cast<long long>(LoadGovernor::Scale()));
+                });
+
+            context.RegisterFunction("Services_Dump", [](ArgList& args) -> Value {
+                ServiceLoop::Dump();
+                return Value();
+                });
+
+            // Milliseconds of script time since the scheduler started; follows the simulated clock under VirtualTime
+            context.RegisterFunction("time_ms", [](ArgList& args) -> Value {
+                return Value(static_cast<long long>(std::chrono::duration_cast<std::chrono::milliseconds>(ScriptScheduler::Shared().Elapsed()).count()));
+                });
+
+            context.RegisterFunction("Scheduler_Dump", [](ArgList& args) -> Value {
+                ScriptScheduler::Shared().Dump(std::cout);
+                return Value();
+                });
+        }
+
+        // --- spawn/await ---
+        // A spawned function runs on the shared worker pool in its own context, started from a snapshot of the
+        // spawner's globals; its writes to globals stay there, only the return value comes back. await()
+        // suspends the spawning coroutine, not its thread, so other scripts on that thread keep running.
+        static void FinishJob(ScriptJob& job) {
+            job.done.store(true, std::memory_order_release);
+            std::atomic_thread_fence(std::memory_order_seq_cst); // Pairs with the waiter re-checking 'done'
+            if (job.wake_waiter.load(std::memory_order_relaxed) && job.wake_waiter.exchange(false)) {
+                ScriptScheduler::Shared().Wake(job.waiter.load(std::memory_order_relaxed));
+            }
+        }
+
+        static std::shared_ptr<ScriptJob> FindJob(ScriptContext& context, const Value& id, const char* native) {
+            if (id.GetType() != Value::Type::NUMBER_INT) {
+                throw std::runtime_error(std::string(native) + " requires a future returned by spawn or file_*.");
+            }
+            auto job = context.jobs.find(id.AsInt());
+            if (job == context.jobs.end()) {
+                throw std::runtime_error(std::string(native) + ": unknown future " + id.AsString() + ", it was never spawned here or was already awaited.");
+            }
+            return job->second;
+        }
+
+        void RegisterJobAPI(ScriptContext& context) {
+            context.RegisterFunction("spawn", [&context](ArgList& args) -> Value {
+                if (args.empty() || args[0].GetType() != Value::Type::STRING) {
+                    throw std::runtime_error("spawn requires a function name followed by its arguments.");
+                }
+                std::string name = args[0].AsString();
+                auto function = context.script_functions.find(name);
+                if (function == context.script_functions.end()) {
+                    throw std::runtime_error("spawn: function '" + name + "' not found.");
+                }
+                if (function->second.params.size() != args.size() - 1) {
+                    throw std::runtime_error("spawn: '" + name + "' expects " + std::to_string(function->second.params.size()) +
+                        " argument(s), got " + std::to_string(args.size() - 1) + ".");
+                }
+
+                // Everything the job needs is copied here, on the spawner's thread, so the job never reads
+                // the spawner's context while it keeps running
+                auto job = std::make_shared<ScriptJob>();
+                job->function = name;
+                auto worker = std::make_shared<ScriptContext>(context.current_script_path, context.memory.Limit());
+                InheritContext(context, *worker);
+                std::vector<Value> job_args(args.begin() + 1, args.end());
+                WorkerPool::Shared().Submit([job, worker, target = function->second, job_args = std::move(job_args)]() {
+                    Interpreter interpreter;
+                    try {
+                        ArgList call_args(job_args.begin(), job_args.end(), worker->memory.Scratch());
+                        job->result = interpreter.CallScriptFunction(target, call_args, *worker);
+                    }
+                    catch (const std::exception& e) {
+                        job->error = e.what()[0] ? e.what() : "unknown error";
+                    }
+                    FinishJob(*job);
+                    });
+
+                long long id = context.next_job++;
+                context.jobs.emplace(id, job);
+                return Value(id);
+                });
+
+            context.RegisterFunction("await", [&context](ArgList& args) -> Value {
+                if (args.empty() || args.size() > 2 ||
+                    (args.size() == 2 && args[1].GetType() != Value::Type::NUMBER_INT && args[1].GetType() != Value::Type::NUMBER_FLOAT)) {
+                    throw std::runtime_error("await requires a future and optionally a timeout in milliseconds.");
+                }
+                std::shared_ptr<ScriptJob> job = FindJob(context, args[0], "await");
+                long long timeout = args.size() == 2 ? args[1].AsInt() : -1;
+                if (!job->done.load(std::memory_order_acquire)) {
+                    if (timeout == 0) {
+                        return Value();
+                    }
+                    if (InServerTick) {
+                        throw std::runtime_error("await cannot wait in on_tick, it would stall the game thread. Check future_ready first.");
+                    }
+                    RejectInParallelFor(context, "await");
+                    auto deadline = ScriptScheduler::Now() + std::chrono::milliseconds(timeout > 0 ? timeout : 0);
+                    while (!job->done.load(std::memory_order_acquire)) {
+                        auto now = ScriptScheduler::Now();
+                        if (timeout > 0 && now >= deadline) {
+                            return Value(); // Still pending, it can be awaited again
+                        }
+                        if (!ScriptScheduler::InCoroutine()) {
+                            ScriptScheduler::Sleep(std::chrono::milliseconds(1)); // Worker threads have nothing to wake them
+                            continue;
+                        }
+                        job->waiter = ScriptScheduler::CurrentId();
+                        job->wake_waiter.store(true, std::memory_order_seq_cst);
+                        if (job->done.load(std::memory_order_acquire)) {
+                            job->wake_waiter = false;
+                            break;
+                        }
+                        ScriptScheduler::SleepUntilWoken(timeout > 0 ? deadline : now + std::chrono::hours(1));
+                    }
+                }
+                context.jobs.erase(args[0].AsInt());
+                if (!job->error.empty()) {
+                    throw std::runtime_error(job->function.empty() ? job->error : "spawned function '" + job->function + "' failed: " + job->error);
+                }
+                return job->result;
+                });
+
+            context.RegisterFunction("future_ready", [&context](ArgList& args) -> Value {
+                if (args.size() != 1) {
+                    throw std::runtime_error("future_ready requires a future.");
+                }
+                return Value(FindJob(context, args[0], "future_ready")->done.load(std::memory_order_acquire));
+                });
+        }
+
+        // --- file_read/file_write/file_append ---
+        // Paths are relative to Begeerte/Data and may not leave it. The request runs on the I/O threads and the
+        // call returns a future at once, so a script that awaits it only suspends its own coroutine.
+        static std::filesystem::path DataPath(const Value& name, const char* native) {
+            if (name.GetType() != Value::Type::STRING || name.AsString().empty()) {
+                throw std::runtime_error(std::string(native) + " requires a file name relative to Begeerte/Data.");
+            }
+            std::filesystem::path relative = std::filesystem::path(name.AsString()).lexically_normal();
+            if (relative.has_root_path() || relative.empty() || *relative.begin() == "..") {
+                throw std::runtime_error(std::string(native) + ": '" + name.AsString() + "' is outside Begeerte/Data.");
+            }
+            return DataDirectory / relative;
+        }
+
+        static Value SubmitFileJob(ScriptContext& context, ScriptFileIO::Op op, const std::filesystem::path& path, std::string data, const char* native) {
+            auto job = std::make_shared<ScriptJob>();
+            ScriptFileIO::Submit(op, path, std::move(data), [job, op, native](ScriptFileIO::Result& result) {
+                if (!result.error.empty()) {
+                    job->error = std::string(native) + " failed: " + result.error;
+                }
+                else if (op == ScriptFileIO::Op::Read) {
+                    job->result = Value(result.data);
+                }
+                else {
+                    job->result = Value(static_cast<long long>(result.bytes));
+                }
+                FinishJob(*job);
+                }, context.memory.Limit()); // A file the script could not hold is refused before it is loaded
+
+            long long id = context.next_job++;
+            context.jobs.emplace(id, job);
+            return Value(id);
+        }
+
+        void RegisterFileAPI(ScriptContext& context) {
+            // Resolves to the file's contents
+            context.RegisterFunction("file_read", [&context](ArgList& args) -> Value {
+                if (args.size() != 1) {
+                    throw std::runtime_error("file_read requires a file name.");
+                }
+                return SubmitFileJob(context, ScriptFileIO::Op::Read, DataPath(args[0], "file_read"), std::string(), "file_read");
+                });
+
+            // Replaces the file; resolves to the number of bytes written
+            context.RegisterFunction("file_write", [&context](ArgList& args) -> Value {
+                if (args.size() != 2) {
+                    throw std::runtime_error("file_write requires a file name and the text to write.");
+                }
+                return SubmitFileJob(context, ScriptFileIO::Op::Write, DataPath(args[0], "file_write"), args[1].AsString(), "file_write");
+                });
+
+            // Adds to the end of the file; resolves to the number of bytes written
+            context.RegisterFunction("file_append", [&context](ArgList& args) -> Value {
+                if (args.size() != 2) {
+                    throw std::runtime_error("file_append requires a file name and the text to append.");
+                }
+                return SubmitFileJob(context, ScriptFileIO::Op::Append, DataPath(args[0], "file_append"), args[1].AsString(), "file_append");
+                });
+        }
+
+        // Looks the channel up in the registry once, later calls hit the script's own cache
+        static std::shared_ptr<Channel> FindChannel(ScriptContext& context, const std::string& name, const char* native) {
+            auto cached = context.channels.find(name);
+            if (cached != context.channels.end()) {
+                return cached->second;
+            }
+            std::shared_ptr<Channel> channel = Channels::Find(name);
+            if (!channel) {
+                throw std::runtime_error(std::string(native) + ": channel '" + name + "' is not open, call channel_open first.");
+            }
+            context.channels.emplace(name, channel);
+            return channel;
+        }
+
+        void RegisterChannelAPI(ScriptContext& context) {
+            context.RegisterFunction("channel_open", [&context](ArgList& args) -> Value {
+                if (args.size() < 2 || args.size() > 3 || args[0].GetType() != Value::Type::STRING || args[1].GetType() != Value::Type::STRING ||
+                    (args.size() == 3 && args[2].GetType() != Value::Type::NUMBER_INT)) {
+                    throw std::runtime_error("channel_open requires a channel name, a type name and optionally a capacity.");
+                }
+                bool any_type = false;
+                Value::Type type = Value::Type::NIL;
+                if (!Channels::ParseType(args[1].AsString(), any_type, type)) {
+                    throw std::runtime_error("channel_open: unknown type '" + args[1].AsString() + "', use int, float, string, bool, player or any.");
+                }
+                // [Scripts] ChannelCapacity: values a channel holds when channel_open is not given a capacity
+                long long capacity = args.size() == 3 ? args[2].AsInt() : Config::GetInt("Scripts", "ChannelCapacity", 256);
+                if (capacity < 1 || capacity > (1 << 20)) {
+                    throw std::runtime_error("channel_open: capacity must be between 1 and 1048576.");
+                }
+                context.channels[args[0].AsString()] = Channels::Open(args[0].AsString(), any_type, type, static_cast<size_t>(capacity));
+                return Value(true);
+                });
+
+            context.RegisterFunction("channel_send", [&context](ArgList& args) -> Value {
+                if (args.size() != 2 || args[0].GetType() != Value::Type::STRING) {
+                    throw std::runtime_error("channel_send requires a channel name and a value.");
+                }
+                std::shared_ptr<Channel> channel = FindChannel(context, args[0].AsString(), "channel_send");
+                if (!channel->Accepts(args[1])) {
+                    throw std::runtime_error("channel_send: channel '" + channel->name + "' only carries " + channel->TypeName() + " values.");
+                }
+                return Value(channel->Send(args[1])); // False when full: the value is dropped
+                });
+
+            context.RegisterFunction("channel_recv", [&context](ArgList& args) -> Value {
+                if (args.empty() || args.size() > 2 || args[0].GetType() != Value::Type::STRING ||
+                    (args.size() == 2 && args[1].GetType() != Value::Type::NUMBER_INT && args[1].GetType() != Value::Type::NUMBER_FLOAT)) {
+                    throw std::runtime_error("channel_recv requires a channel name and optionally a timeout in milliseconds.");
+                }
+                std::shared_ptr<Channel> channel = FindChannel(context, args[0].AsString(), "channel_recv");
+                if (!channel->ClaimReceiver(&context)) {
+                    throw std::runtime_error("channel_recv: channel '" + channel->name + "' already has a receiver in another script.");
+                }
+                Value value;
+                if (channel->Receive(value)) {
+                    return value;
+                }
+                long long timeout = args.size() == 2 ? args[1].AsInt() : 0;
+                if (timeout <= 0) {
+                    return Value();
+                }
+                if (InServerTick) {
+                    throw std::runtime_error("channel_recv cannot wait in on_tick, it would stall the game thread.");
+                }
+                RejectInParallelFor(context, "channel_recv");
+                auto deadline = ScriptScheduler::Now() + std::chrono::milliseconds(timeout);
+                while (true) {
+                    channel->ArmWakeup(ScriptScheduler::CurrentId());
+                    if (channel->Receive(value) || ScriptScheduler::Now() >= deadline) {
+                        channel->DisarmWakeup();
+                        return value;
+                    }
+                    ScriptScheduler::SleepUntilWoken(deadline);
+                }
+                });
+
+            context.RegisterFunction("channel_size", [&context](ArgList& args) -> Value {
+                if (args.size() != 1 || args[0].GetType() != Value::Type::STRING) {
+                    throw std::runtime_error("channel_size requires a channel name.");
+                }
+                return Value(static_cast<long long>(FindChannel(context, args[0].AsString(), "channel_size")->Size()));
+                });
+
+            context.RegisterFunction("share_set", [&context](ArgList& args) -> Value {
+                if (args.size() != 2 || args[0].GetType() != Value::Type::STRING) {
+                    throw std::runtime_error("share_set requires a name and a value.");
+                }
+                SharedView& view = context.shared_values[args[0].AsString()];
+                if (!view.slot) {
+                    view.slot = Channels::Slot(args[0].AsString());
+                }
+                Channels::Publish(*view.slot, args[1]);
+                return Value();
+                });
+
+            context.RegisterFunction("share_get", [&context](ArgList& args) -> Value {
+                if (args.size() != 1 || args[0].GetType() != Value::Type::STRING) {
+                    throw std::runtime_error("share_get requires a name.");
+                }
+                SharedView& view = context.shared_values[args[0].AsString()];
+                if (!view.slot) {
+                    view.slot = Channels::Slot(args[0].AsString());
+                }
+                Channels::Read(*view.slot, view);
+                return view.value;
+                });
+
+            context.RegisterFunction("Channels_Dump", [](ArgList& args) -> Value {
+                Channels::Dump(std::cout);
+                return Value();
+                });
+        }
+
+        void RegisterEntityListAPI(ScriptContext& context) {
+            // 确保 g_cheatdata 已初始化
+            if (!g_cheatdata) {
+                std::cerr << "Error: g_cheatdata is null. Cannot register EntityList API." << std::endl;
+                return;
+            }
+
+            // 注册 EntityList 相关函数
+            context.RegisterFunction("EntityList_Update", [](ArgList& args) -> Value {
+                EntityList::Update();
+                return Value();
+                });
+
+            context.RegisterFunction("EntityList_GetMaxPlayers", [](ArgList& args) -> Value {
+                return Value((long long)EntityList::GetMaxPlayers());
+                }, NativeTraits::TickStable());
+
+            context.RegisterFunction("EntityList_GetEntity", [](ArgList& args) -> Value {
+                if (args.size() != 1 || args[0].GetType() != Value::Type::NUMBER_INT) {
+                    throw std::runtime_error("EntityList_GetEntity requires 1 integer argument (id).");
+                }
+                DWORD64 entity_addr = EntityList::GetEntity(static_cast<int>(args[0].AsInt()));
+                return Value(static_cast<long long>(entity_addr));
+                }, NativeTraits::TickStable());
+
+            context.RegisterFunction("EntityList_GetPlayer", [](ArgList& args) -> Value {
+                if (args.size() != 1 || args[0].GetType() != Value::Type::NUMBER_INT) {
+                    throw std::runtime_error("EntityList_GetPlayer requires 1 integer argument (id).");
+                }
+                EntityList::Player* player = EntityList::GetPlayer(static_cast<int>(args[0].AsInt()));
+                return Value(player);
+                }, NativeTraits::TickStable());
+
+            context.RegisterFunction("EntityList_GetAllEntities", [](ArgList& args) -> Value {
+                return Value((long long)EntityList::GetAllEntities()->size());
+                }, NativeTraits::TickStable());
+
+            // 注册 Player 相关函数
+            context.RegisterFunction("Player_IsValid", [](ArgList& args) -> Value {
+                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
+                    throw std::runtime_error("Player_IsValid requires 1 Player object argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value(false);
+                return Value(p->IsValid());
+                }, NativeTraits::TickStable("ValidFlag"));
+
+            context.RegisterFunction("Player_GetCharacter", [](ArgList& args) -> Value {
+                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
+                    throw std::runtime_error("Player_GetCharacter requires 1 Player object argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value("Error: Null Player");
+                return Value(Platform::Narrow(p->GetCharacter()));
+                }, NativeTraits::TickStable("Character"));
+
+            context.RegisterFunction("Player_GetGrowthStage", [](ArgList& args) -> Value {
+                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
+                    throw std::runtime_error("Player_GetGrowthStage requires 1 Player object argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value("Error: Null Player");
+                return Value(Platform::Narrow(p->GetGrowthStage()));
+                }, NativeTraits::TickStable("GrowthStage"));
+
+            // 为每个 byte 字段注册 Get 和 Set 方法
+            // validFlag
+            context.RegisterFunction("Player_GetValidFlag", [](ArgList& args) -> Value {
+                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
+                    throw std::runtime_error("Player_GetValidFlag requires 1 Player object argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value((long long)0);
+                return Value((long long)p->validFlag);
+                }, NativeTraits::TickStable("ValidFlag"));
+
+            context.RegisterFunction("Player_SetValidFlag", [](ArgList& args) -> Value {
+                if (args.size() != 2 || args[0].GetType() != Value::Type::PLAYER_PTR || args[1].GetType() != Value::Type::NUMBER_INT) {
+                    throw std::runtime_error("Player_SetValidFlag requires 1 Player object and 1 integer argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value();
+                p->validFlag = static_cast<byte>(args[1].AsInt());
+                return Value();
+                }, NativeTraits::Mutating("ValidFlag"));
+
+            // SkinIndex
+            context.RegisterFunction("Player_GetSkinIndex", [](ArgList& args) -> Value {
+                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
+                    throw std::runtime_error("Player_GetSkinIndex requires 1 Player object argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value((long long)0);
+                return Value((long long)p->SkinIndex);
+                }, NativeTraits::TickStable("SkinIndex"));
+
+            context.RegisterFunction("Player_SetSkinIndex", [](ArgList& args) -> Value {
+                if (args.size() != 2 || args[0].GetType() != Value::Type::PLAYER_PTR || args[1].GetType() != Value::Type::NUMBER_INT) {
+                    throw std::runtime_error("Player_SetSkinIndex requires 1 Player object and 1 integer argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value();
+                p->SkinIndex = static_cast<byte>(args[1].AsInt());
+                return Value();
+                }, NativeTraits::Mutating("SkinIndex"));
+
+            // Gender
+            context.RegisterFunction("Player_GetGenderRaw", [](ArgList& args) -> Value {
+                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
+                    throw std::runtime_error("Player_GetGenderRaw requires 1 Player object argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value((long long)0);
+                return Value((long long)p->Gender);
+                }, NativeTraits::TickStable("Gender"));
+
+            context.RegisterFunction("Player_SetGender", [](ArgList& args) -> Value {
+                if (args.size() != 2 || args[0].GetType() != Value::Type::PLAYER_PTR || args[1].GetType() != Value::Type::NUMBER_INT) {
+                    throw std::runtime_error("Player_SetGender requires 1 Player object and 1 integer argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value();
+                p->Gender = static_cast<byte>(args[1].AsInt());
+                return Value();
+                }, NativeTraits::Mutating("Gender"));
+
+            // GrowthStage
+            context.RegisterFunction("Player_GetGrowthStageRaw", [](ArgList& args) -> Value {
+                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
+                    throw std::runtime_error("Player_GetGrowthStageRaw requires 1 Player object argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value((long long)0);
+                return Value((long long)p->GrowthStage);
+                }, NativeTraits::TickStable("GrowthStage"));
+
+            context.RegisterFunction("Player_SetGrowthStage", [](ArgList& args) -> Value {
+                if (args.size() != 2 || args[0].GetType() != Value::Type::PLAYER_PTR || args[1].GetType() != Value::Type::NUMBER_INT) {
+                    throw std::runtime_error("Player_SetGrowthStage requires 1 Player object and 1 integer argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value();
+                p->GrowthStage = static_cast<byte>(args[1].AsInt());
+                return Value();
+                }, NativeTraits::Mutating("GrowthStage"));
+
+            // SavedGrowth
+            context.RegisterFunction("Player_GetSavedGrowth", [](ArgList& args) -> Value {
+                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
+                    throw std::runtime_error("Player_GetSavedGrowth requires 1 Player object argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value((long long)0);
+                return Value((long long)p->SavedGrowth);
+                }, NativeTraits::TickStable("SavedGrowth"));
+
+            context.RegisterFunction("Player_SetSavedGrowth", [](ArgList& args) -> Value {
+                if (args.size() != 2 || args[0].GetType() != Value::Type::PLAYER_PTR || args[1].GetType() != Value::Type::NUMBER_INT) {
+                    throw std::runtime_error("Player_SetSavedGrowth requires 1 Player object and 1 integer argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value();
+                p->SavedGrowth = static_cast<byte>(args[1].AsInt());
+                return Value();
+                }, NativeTraits::Mutating("SavedGrowth"));
+
+            // VitalityHealth
+            context.RegisterFunction("Player_GetVitalityHealth", [](ArgList& args) -> Value {
+                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
+                    throw std::runtime_error("Player_GetVitalityHealth requires 1 Player object argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value((long long)0);
+                return Value((long long)p->VitalityHealth);
+                }, NativeTraits::TickStable("VitalityHealth"));
+
+            context.RegisterFunction("Player_SetVitalityHealth", [](ArgList& args) -> Value {
+                if (args.size() != 2 || args[0].GetType() != Value::Type::PLAYER_PTR || args[1].GetType() != Value::Type::NUMBER_INT) {
+                    throw std::runtime_error("Player_SetVitalityHealth requires 1 Player object and 1 integer argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value();
+                p->VitalityHealth = static_cast<byte>(args[1].AsInt());
+                return Value();
+                }, NativeTraits::Mutating("VitalityHealth"));
+
+            context.RegisterFunction("Player_GetVitalityHealthGrade", [](ArgList& args) -> Value {
+                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
+                    throw std::runtime_error("Player_GetVitalityHealthGrade requires 1 Player object argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value("Error: Null Player");
+                return Value(Platform::Narrow(p->GetGeneticGrades(p->VitalityHealth)));
+                }, NativeTraits::TickStable("VitalityHealth"));
+
+            // VitalityArmor
+            context.RegisterFunction("Player_GetVitalityArmor", [](ArgList& args) -> Value {
+                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
+                    throw std::runtime_error("Player_GetVitalityArmor requires 1 Player object argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value((long long)0);
+                return Value((long long)p->VitalityArmor);
+                }, NativeTraits::TickStable("VitalityArmor"));
+
+            context.RegisterFunction("Player_SetVitalityArmor", [](ArgList& args) -> Value {
+                if (args.size() != 2 || args[0].GetType() != Value::Type::PLAYER_PTR || args[1].GetType() != Value::Type::NUMBER_INT) {
+                    throw std::runtime_error("Player_SetVitalityArmor requires 1 Player object and 1 integer argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value();
+                p->VitalityArmor = static_cast<byte>(args[1].AsInt());
+                return Value();
+                }, NativeTraits::Mutating("VitalityArmor"));
+
+            context.RegisterFunction("Player_GetVitalityArmorGrade", [](ArgList& args) -> Value {
+                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
+                    throw std::runtime_error("Player_GetVitalityArmorGrade requires 1 Player object argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value("Error: Null Player");
+                return Value(Platform::Narrow(p->GetGeneticGrades(p->VitalityArmor)));
+                }, NativeTraits::TickStable("VitalityArmor"));
+
+            // VitalityBile
+            context.RegisterFunction("Player_GetVitalityBile", [](ArgList& args) -> Value {
+                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
+                    throw std::runtime_error("Player_GetVitalityBile requires 1 Player object argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value((long long)0);
+                return Value((long long)p->VitalityBile);
+                }, NativeTraits::TickStable("VitalityBile"));
+
+            context.RegisterFunction("Player_SetVitalityBile", [](ArgList& args) -> Value {
+                if (args.size() != 2 || args[0].GetType() != Value::Type::PLAYER_PTR || args[1].GetType() != Value::Type::NUMBER_INT) {
+                    throw std::runtime_error("Player_SetVitalityBile requires 1 Player object and 1 integer argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value();
+                p->VitalityBile = static_cast<byte>(args[1].AsInt());
+                return Value();
+                }, NativeTraits::Mutating("VitalityBile"));
+
+            context.RegisterFunction("Player_GetVitalityBileGrade", [](ArgList& args) -> Value {
+                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
+                    throw std::runtime_error("Player_GetVitalityBileGrade requires 1 Player object argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value("Error: Null Player");
+                return Value(Platform::Narrow(p->GetGeneticGrades(p->VitalityBile)));
+                }, NativeTraits::TickStable("VitalityBile"));
+
+            // VitalityStamina
+            context.RegisterFunction("Player_GetVitalityStamina", [](ArgList& args) -> Value {
+                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
+                    throw std::runtime_error("Player_GetVitalityStamina requires 1 Player object argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value((long long)0);
+                return Value((long long)p->VitalityStamina);
+                }, NativeTraits::TickStable("VitalityStamina"));
+
+            context.RegisterFunction("Player_SetVitalityStamina", [](ArgList& args) -> Value {
+                if (args.size() != 2 || args[0].GetType() != Value::Type::PLAYER_PTR || args[1].GetType() != Value::Type::NUMBER_INT) {
+                    throw std::runtime_error("Player_SetVitalityStamina requires 1 Player object and 1 integer argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value();
+                p->VitalityStamina = static_cast<byte>(args[1].AsInt());
+                return Value();
+                }, NativeTraits::Mutating("VitalityStamina"));
+
+            context.RegisterFunction("Player_GetVitalityStaminaGrade", [](ArgList& args) -> Value {
+                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
+                    throw std::runtime_error("Player_GetVitalityStaminaGrade requires 1 Player object argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value("Error: Null Player");
+                return Value(Platform::Narrow(p->GetGeneticGrades(p->VitalityStamina)));
+                }, NativeTraits::TickStable("VitalityStamina"));
+
+            // VitalityHunger
+            context.RegisterFunction("Player_GetVitalityHunger", [](ArgList& args) -> Value {
+                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
+                    throw std::runtime_error("Player_GetVitalityHunger requires 1 Player object argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value((long long)0);
+                return Value((long long)p->VitalityHunger);
+                }, NativeTraits::TickStable("VitalityHunger"));
+
+            context.RegisterFunction("Player_SetVitalityHunger", [](ArgList& args) -> Value {
+                if (args.size() != 2 || args[0].GetType() != Value::Type::PLAYER_PTR || args[1].GetType() != Value::Type::NUMBER_INT) {
+                    throw std::runtime_error("Player_SetVitalityHunger requires 1 Player object and 1 integer argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value();
+                p->VitalityHunger = static_cast<byte>(args[1].AsInt());
+                return Value();
+                }, NativeTraits::Mutating("VitalityHunger"));
+
+            context.RegisterFunction("Player_GetVitalityHungerGrade", [](ArgList& args) -> Value {
+                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
+                    throw std::runtime_error("Player_GetVitalityHungerGrade requires 1 Player object argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value("Error: Null Player");
+                return Value(Platform::Narrow(p->GetGeneticGrades(p->VitalityHunger)));
+                }, NativeTraits::TickStable("VitalityHunger"));
+
+            // VitalityThirst
+            context.RegisterFunction("Player_GetVitalityThirst", [](ArgList& args) -> Value {
+                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
+                    throw std::runtime_error("Player_GetVitalityThirst requires 1 Player object argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value((long long)0);
+                return Value((long long)p->VitalityThirst);
+                }, NativeTraits::TickStable("VitalityThirst"));
+
+            context.RegisterFunction("Player_SetVitalityThirst", [](ArgList& args) -> Value {
+                if (args.size() != 2 || args[0].GetType() != Value::Type::PLAYER_PTR || args[1].GetType() != Value::Type::NUMBER_INT) {
+                    throw std::runtime_error("Player_SetVitalityThirst requires 1 Player object and 1 integer argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value();
+                p->VitalityThirst = static_cast<byte>(args[1].AsInt());
+                return Value();
+                }, NativeTraits::Mutating("VitalityThirst"));
+
+            context.RegisterFunction("Player_GetVitalityThirstGrade", [](ArgList& args) -> Value {
+                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
+                    throw std::runtime_error("Player_GetVitalityThirstGrade requires 1 Player object argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value("Error: Null Player");
+                return Value(Platform::Narrow(p->GetGeneticGrades(p->VitalityThirst)));
+                }, NativeTraits::TickStable("VitalityThirst"));
+
+            // VitalityTorpor
+            context.RegisterFunction("Player_GetVitalityTorpor", [](ArgList& args) -> Value {
+                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
+                    throw std::runtime_error("Player_GetVitalityTorpor requires 1 Player object argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value((long long)0);
+                return Value((long long)p->VitalityTorpor);
+                }, NativeTraits::TickStable("VitalityTorpor"));
+
+            context.RegisterFunction("Player_SetVitalityTorpor", [](ArgList& args) -> Value {
+                if (args.size() != 2 || args[0].GetType() != Value::Type::PLAYER_PTR || args[1].GetType() != Value::Type::NUMBER_INT) {
+                    throw std::runtime_error("Player_SetVitalityTorpor requires 1 Player object and 1 integer argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value();
+                p->VitalityTorpor = static_cast<byte>(args[1].AsInt());
+                return Value();
+                }, NativeTraits::Mutating("VitalityTorpor"));
+
+            context.RegisterFunction("Player_GetVitalityTorporGrade", [](ArgList& args) -> Value {
+                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
+                    throw std::runtime_error("Player_GetVitalityTorporGrade requires 1 Player object argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value("Error: Null Player");
+                return Value(Platform::Narrow(p->GetGeneticGrades(p->VitalityTorpor)));
+                }, NativeTraits::TickStable("VitalityTorpor"));
+
+            // DamageBite
+            context.RegisterFunction("Player_GetDamageBite", [](ArgList& args) -> Value {
+                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
+                    throw std::runtime_error("Player_GetDamageBite requires 1 Player object argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value((long long)0);
+                return Value((long long)p->DamageBite);
+                }, NativeTraits::TickStable("DamageBite"));
+
+            context.RegisterFunction("Player_SetDamageBite", [](ArgList& args) -> Value {
+                if (args.size() != 2 || args[0].GetType() != Value::Type::PLAYER_PTR || args[1].GetType() != Value::Type::NUMBER_INT) {
+                    throw std::runtime_error("Player_SetDamageBite requires 1 Player object and 1 integer argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value();
+                p->DamageBite = static_cast<byte>(args[1].AsInt());
+                return Value();
+                }, NativeTraits::Mutating("DamageBite"));
+
+            context.RegisterFunction("Player_GetDamageBiteGrade", [](ArgList& args) -> Value {
+                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
+                    throw std::runtime_error("Player_GetDamageBiteGrade requires 1 Player object argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value("Error: Null Player");
+                return Value(Platform::Narrow(p->GetGeneticGrades(p->DamageBite)));
+                }, NativeTraits::TickStable("DamageBite"));
+
+            // DamageProjectile
+            context.RegisterFunction("Player_GetDamageProjectile", [](ArgList& args) -> Value {
+                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
+                    throw std::runtime_error("Player_GetDamageProjectile requires 1 Player object argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value((long long)0);
+                return Value((long long)p->DamageProjectile);
+                }, NativeTraits::TickStable("DamageProjectile"));
+
+            context.RegisterFunction("Player_SetDamageProjectile", [](ArgList& args) -> Value {
+                if (args.size() != 2 || args[0].GetType() != Value::Type::PLAYER_PTR || args[1].GetType() != Value::Type::NUMBER_INT) {
+                    throw std::runtime_error("Player_SetDamageProjectile requires 1 Player object and 1 integer argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value();
+                p->DamageProjectile = static_cast<byte>(args[1].AsInt());
+                return Value();
+                }, NativeTraits::Mutating("DamageProjectile"));
+
+            context.RegisterFunction("Player_GetDamageProjectileGrade", [](ArgList& args) -> Value {
+                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
+                    throw std::runtime_error("Player_GetDamageProjectileGrade requires 1 Player object argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value("Error: Null Player");
+                return Value(Platform::Narrow(p->GetGeneticGrades(p->DamageProjectile)));
+                }, NativeTraits::TickStable("DamageProjectile"));
+
+            // DamageSwipe
+            context.RegisterFunction("Player_GetDamageSwipe", [](ArgList& args) -> Value {
+                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
+                    throw std::runtime_error("Player_GetDamageSwipe requires 1 Player object argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value((long long)0);
+                return Value((long long)p->DamageSwipe);
+                }, NativeTraits::TickStable("DamageSwipe"));
+
+            context.RegisterFunction("Player_SetDamageSwipe", [](ArgList& args) -> Value {
+                if (args.size() != 2 || args[0].GetType() != Value::Type::PLAYER_PTR || args[1].GetType() != Value::Type::NUMBER_INT) {
+                    throw std::runtime_error("Player_SetDamageSwipe requires 1 Player object and 1 integer argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value();
+                p->DamageSwipe = static_cast<byte>(args[1].AsInt());
+                return Value();
+                }, NativeTraits::Mutating("DamageSwipe"));
+
+            context.RegisterFunction("Player_GetDamageSwipeGrade", [](ArgList& args) -> Value {
+                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
+                    throw std::runtime_error("Player_GetDamageSwipeGrade requires 1 Player object argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value("Error: Null Player");
+                return Value(Platform::Narrow(p->GetGeneticGrades(p->DamageSwipe)));
+                }, NativeTraits::TickStable("DamageSwipe"));
+
+            // MitigationBlunt
+            context.RegisterFunction("Player_GetMitigationBlunt", [](ArgList& args) -> Value {
+                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
+                    throw std::runtime_error("Player_GetMitigationBlunt requires 1 Player object argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value((long long)0);
+                return Value((long long)p->MitigationBlunt);
+                }, NativeTraits::TickStable("MitigationBlunt"));
+
+            context.RegisterFunction("Player_SetMitigationBlunt", [](ArgList& args) -> Value {
+                if (args.size() != 2 || args[0].GetType() != Value::Type::PLAYER_PTR || args[1].GetType() != Value::Type::NUMBER_INT) {
+                    throw std::runtime_error("Player_SetMitigationBlunt requires 1 Player object and 1 integer argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value();
+                p->MitigationBlunt = static_cast<byte>(args[1].AsInt());
+                return Value();
+                }, NativeTraits::Mutating("MitigationBlunt"));
+
+            context.RegisterFunction("Player_GetMitigationBluntGrade", [](ArgList& args) -> Value {
+                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
+                    throw std::runtime_error("Player_GetMitigationBluntGrade requires 1 Player object argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value("Error: Null Player");
+                return Value(Platform::Narrow(p->GetGeneticGrades(p->MitigationBlunt)));
+                }, NativeTraits::TickStable("MitigationBlunt"));
+
+            // MitigationPierce
+            context.RegisterFunction("Player_GetMitigationPierce", [](ArgList& args) -> Value {
+                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
+                    throw std::runtime_error("Player_GetMitigationPierce requires 1 Player object argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value((long long)0);
+                return Value((long long)p->MitigationPierce);
+                }, NativeTraits::TickStable("MitigationPierce"));
+
+            context.RegisterFunction("Player_SetMitigationPierce", [](ArgList& args) -> Value {
+                if (args.size() != 2 || args[0].GetType() != Value::Type::PLAYER_PTR || args[1].GetType() != Value::Type::NUMBER_INT) {
+                    throw std::runtime_error("Player_SetMitigationPierce requires 1 Player object and 1 integer argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value();
+                p->MitigationPierce = static_cast<byte>(args[1].AsInt());
+                return Value();
+                }, NativeTraits::Mutating("MitigationPierce"));
+
+            context.RegisterFunction("Player_GetMitigationPierceGrade", [](ArgList& args) -> Value {
+                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
+                    throw std::runtime_error("Player_GetMitigationPierceGrade requires 1 Player object argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value("Error: Null Player");
+                return Value(Platform::Narrow(p->GetGeneticGrades(p->MitigationPierce)));
+                }, NativeTraits::TickStable("MitigationPierce"));
+
+            // MitigationFire
+            context.RegisterFunction("Player_GetMitigationFire", [](ArgList& args) -> Value {
+                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
+                    throw std::runtime_error("Player_GetMitigationFire requires 1 Player object argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value((long long)0);
+                return Value((long long)p->MitigationFire);
+                }, NativeTraits::TickStable("MitigationFire"));
+
+            context.RegisterFunction("Player_SetMitigationFire", [](ArgList& args) -> Value {
+                if (args.size() != 2 || args[0].GetType() != Value::Type::PLAYER_PTR || args[1].GetType() != Value::Type::NUMBER_INT) {
+                    throw std::runtime_error("Player_SetMitigationFire requires 1 Player object and 1 integer argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value();
+                p->MitigationFire = static_cast<byte>(args[1].AsInt());
+                return Value();
+                }, NativeTraits::Mutating("MitigationFire"));
+
+            context.RegisterFunction("Player_GetMitigationFireGrade", [](ArgList& args) -> Value {
+                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
+                    throw std::runtime_error("Player_GetMitigationFireGrade requires 1 Player object argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value("Error: Null Player");
+                return Value(Platform::Narrow(p->GetGeneticGrades(p->MitigationFire)));
+                }, NativeTraits::TickStable("MitigationFire"));
+
+            // MitigationFrost
+            context.RegisterFunction("Player_GetMitigationFrost", [](ArgList& args) -> Value {
+                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
+                    throw std::runtime_error("Player_GetMitigationFrost requires 1 Player object argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value((long long)0);
+                return Value((long long)p->MitigationFrost);
+                }, NativeTraits::TickStable("MitigationFrost"));
+
+            context.RegisterFunction("Player_SetMitigationFrost", [](ArgList& args) -> Value {
+                if (args.size() != 2 || args[0].GetType() != Value::Type::PLAYER_PTR || args[1].GetType() != Value::Type::NUMBER_INT) {
+                    throw std::runtime_error("Player_SetMitigationFrost requires 1 Player object and 1 integer argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value();
+                p->MitigationFrost = static_cast<byte>(args[1].AsInt());
+                return Value();
+                }, NativeTraits::Mutating("MitigationFrost"));
+
+            context.RegisterFunction("Player_GetMitigationFrostGrade", [](ArgList& args) -> Value {
+                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
+                    throw std::runtime_error("Player_GetMitigationFrostGrade requires 1 Player object argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value("Error: Null Player");
+                return Value(Platform::Narrow(p->GetGeneticGrades(p->MitigationFrost)));
+                }, NativeTraits::TickStable("MitigationFrost"));
+
+            // MitigationAcid
+            context.RegisterFunction("Player_GetMitigationAcid", [](ArgList& args) -> Value {
+                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
+                    throw std::runtime_error("Player_GetMitigationAcid requires 1 Player object argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value((long long)0);
+                return Value((long long)p->MitigationAcid);
+                }, NativeTraits::TickStable("MitigationAcid"));
+
+            context.RegisterFunction("Player_SetMitigationAcid", [](ArgList& args) -> Value {
+                if (args.size() != 2 || args[0].GetType() != Value::Type::PLAYER_PTR || args[1].GetType() != Value::Type::NUMBER_INT) {
+                    throw std::runtime_error("Player_SetMitigationAcid requires 1 Player object and 1 integer argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value();
+                p->MitigationAcid = static_cast<byte>(args[1].AsInt());
+                return Value();
+                }, NativeTraits::Mutating("MitigationAcid"));
+
+            context.RegisterFunction("Player_GetMitigationAcidGrade", [](ArgList& args) -> Value {
+                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
+                    throw std::runtime_error("Player_GetMitigationAcidGrade requires 1 Player object argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value("Error: Null Player");
+                return Value(Platform::Narrow(p->GetGeneticGrades(p->MitigationAcid)));
+                }, NativeTraits::TickStable("MitigationAcid"));
+
+            // MitigationVenom
+            context.RegisterFunction("Player_GetMitigationVenom", [](ArgList& args) -> Value {
+                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
+                    throw std::runtime_error("Player_GetMitigationVenom requires 1 Player object argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value((long long)0);
+                return Value((long long)p->MitigationVenom);
+                }, NativeTraits::TickStable("MitigationVenom"));
+
+            context.RegisterFunction("Player_SetMitigationVenom", [](ArgList& args) -> Value {
+                if (args.size() != 2 || args[0].GetType() != Value::Type::PLAYER_PTR || args[1].GetType() != Value::Type::NUMBER_INT) {
+                    throw std::runtime_error("Player_SetMitigationVenom requires 1 Player object and 1 integer argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value();
+                p->MitigationVenom = static_cast<byte>(args[1].AsInt());
+                return Value();
+                }, NativeTraits::Mutating("MitigationVenom"));
+
+            context.RegisterFunction("Player_GetMitigationVenomGrade", [](ArgList& args) -> Value {
+                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
+                    throw std::runtime_error("Player_GetMitigationVenomGrade requires 1 Player object argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value("Error: Null Player");
+                return Value(Platform::Narrow(p->GetGeneticGrades(p->MitigationVenom)));
+                }, NativeTraits::TickStable("MitigationVenom"));
+
+            // MitigationPlasma
+            context.RegisterFunction("Player_GetMitigationPlasma", [](ArgList& args) -> Value {
+                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
+                    throw std::runtime_error("Player_GetMitigationPlasma requires 1 Player object argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value((long long)0);
+                return Value((long long)p->MitigationPlasma);
+                }, NativeTraits::TickStable("MitigationPlasma"));
+
+            context.RegisterFunction("Player_SetMitigationPlasma", [](ArgList& args) -> Value {
+                if (args.size() != 2 || args[0].GetType() != Value::Type::PLAYER_PTR || args[1].GetType() != Value::Type::NUMBER_INT) {
+                    throw std::runtime_error("Player_SetMitigationPlasma requires 1 Player object and 1 integer argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value();
+                p->MitigationPlasma = static_cast<byte>(args[1].AsInt());
+                return Value();
+                }, NativeTraits::Mutating("MitigationPlasma"));
+
+            context.RegisterFunction("Player_GetMitigationPlasmaGrade", [](ArgList& args) -> Value {
+                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
+                    throw std::runtime_error("Player_GetMitigationPlasmaGrade requires 1 Player object argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value("Error: Null Player");
+                return Value(Platform::Narrow(p->GetGeneticGrades(p->MitigationPlasma)));
+                }, NativeTraits::TickStable("MitigationPlasma"));
+
+            // MitigationElectricity
+            context.RegisterFunction("Player_GetMitigationElectricity", [](ArgList& args) -> Value {
+                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
+                    throw std::runtime_error("Player_GetMitigationElectricity requires 1 Player object argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value((long long)0);
+                return Value((long long)p->MitigationElectricity);
+                }, NativeTraits::TickStable("MitigationElectricity"));
+
+            context.RegisterFunction("Player_SetMitigationElectricity", [](ArgList& args) -> Value {
+                if (args.size() != 2 || args[0].GetType() != Value::Type::PLAYER_PTR || args[1].GetType() != Value::Type::NUMBER_INT) {
+                    throw std::runtime_error("Player_SetMitigationElectricity requires 1 Player object and 1 integer argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value();
+                p->MitigationElectricity = static_cast<byte>(args[1].AsInt());
+                return Value();
+                }, NativeTraits::Mutating("MitigationElectricity"));
+
+            context.RegisterFunction("Player_GetMitigationElectricityGrade", [](ArgList& args) -> Value {
+                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
+                    throw std::runtime_error("Player_GetMitigationElectricityGrade requires 1 Player object argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value("Error: Null Player");
+                return Value(Platform::Narrow(p->GetGeneticGrades(p->MitigationElectricity)));
+                }, NativeTraits::TickStable("MitigationElectricity"));
+
+            // OverallQuality
+            context.RegisterFunction("Player_GetOverallQuality", [](ArgList& args) -> Value {
+                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
+                    throw std::runtime_error("Player_GetOverallQuality requires 1 Player object argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value((long long)0);
+                return Value((long long)p->OverallQuality);
+                }, NativeTraits::TickStable("OverallQuality"));
+
+            context.RegisterFunction("Player_SetOverallQuality", [](ArgList& args) -> Value {
+                if (args.size() != 2 || args[0].GetType() != Value::Type::PLAYER_PTR || args[1].GetType() != Value::Type::NUMBER_INT) {
+                    throw std::runtime_error("Player_SetOverallQuality requires 1 Player object and 1 integer argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value();
+                p->OverallQuality = static_cast<byte>(args[1].AsInt());
+                return Value();
+                }, NativeTraits::Mutating("OverallQuality"));
+
+            context.RegisterFunction("Player_GetOverallQualityGrade", [](ArgList& args) -> Value {
+                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
+                    throw std::runtime_error("Player_GetOverallQualityGrade requires 1 Player object argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value("Error: Null Player");
+                return Value(Platform::Narrow(p->GetGeneticGrades(p->OverallQuality)));
+                }, NativeTraits::TickStable("OverallQuality"));
+
+            // Character
+            context.RegisterFunction("Player_GetCharacterRaw", [](ArgList& args) -> Value {
+                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
+                    throw std::runtime_error("Player_GetCharacterRaw requires 1 Player object argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value((long long)0);
+                return Value((long long)p->Character);
+                }, NativeTraits::TickStable("Character"));
+
+            context.RegisterFunction("Player_SetCharacter", [](ArgList& args) -> Value {
+                if (args.size() != 2 || args[0].GetType() != Value::Type::PLAYER_PTR || args[1].GetType() != Value::Type::NUMBER_INT) {
+                    throw std::runtime_error("Player_SetCharacter requires 1 Player object and 1 integer argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value();
+                p->Character = static_cast<byte>(args[1].AsInt());
+                return Value();
+                }, NativeTraits::Mutating("Character"));
+
+            // Health
+            context.RegisterFunction("Player_GetHealth", [](ArgList& args) -> Value {
+                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
+                    throw std::runtime_error("Player_GetHealth requires 1 Player object argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value((long long)0);
+                return Value((long long)p->Health);
+                }, NativeTraits::TickStable("Health"));
+
+            context.RegisterFunction("Player_SetHealth", [](ArgList& args) -> Value {
+                if (args.size() != 2 || args[0].GetType() != Value::Type::PLAYER_PTR || args[1].GetType() != Value::Type::NUMBER_INT) {
+                    throw std::runtime_error("Player_SetHealth requires 1 Player object and 1 integer argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value();
+                p->Health = static_cast<byte>(args[1].AsInt());
+                return Value();
+                }, NativeTraits::Mutating("Health"));
+
+            context.RegisterFunction("Player_GetHealthGrade", [](ArgList& args) -> Value {
+                if (args.size() != 1 || args[0].GetType() != Value::Type::PLAYER_PTR) {
+                    throw std::runtime_error("Player_GetHealthGrade requires 1 Player object argument.");
+                }
+                EntityList::Player* p = args[0].AsPlayer();
+                if (!p) return Value("Error: Null Player");
+                return Value(Platform::Narrow(p->GetGeneticGrades(p->Health)));
+                }, NativeTraits::TickStable("Health"));
+
+            // Limits on_field_changed to the given fields; every field is watched until this is called
+            context.RegisterFunction("watch_fields", [&context](ArgList& args) -> Value {
+                if (args.empty()) {
+                    throw std::runtime_error("watch_fields requires at least 1 field name.");
+                }
+                uint64_t mask = 0;
+                for (const Value& arg : args) {
+                    int field = arg.GetType() == Value::Type::STRING ? PlayerEvents::FieldIndex(arg.AsString()) : -1;
+                    if (field < 0) {
+                        throw std::runtime_error("watch_fields: unknown field '" + arg.AsString() + "'.");
+                    }
+                    mask |= 1ULL << field;
+                }
+                context.watched_fields = mask;
+                if (context.events && context.events->fields != 0) {
+                    context.events->fields = mask;
+                }
+                return Value();
+                });
+        }
+
+        // Prints performance findings for a script; syntax errors are left for the interpreter to report
+        static void LintScript(const std::string& script_path, const std::string& script_content) {
+            std::vector<Token> tokens;
+            try {
+                tokens = Lexer::Tokenize(script_content, script_path);
+            }
+            catch (const std::exception&) {
+                return;
+            }
+            for (const auto& finding : Linter::Lint(tokens)) {
+                std::cout << "[BegeerteLint] " << Linter::Format(std::filesystem::path(script_path).filename().string(), finding) << std::endl;
+            }
+        }
+
+        void WriteScriptLog(const std::string& line) {
+            std::lock_guard<std::mutex> lock(LogMutex);
+            AppendLog(line + "\n");
+        }
+
+        // --- Fused per-player dispatch ---
+        // Every script's on_player(player) runs back to back for each player, so the entity list is
+        // refreshed, walked and validated once per tick instead of once per script.
+        struct PlayerHandler {
+            std::shared_ptr<ScriptInstance> script;
+            ScriptFunction function;
+        };
+        static std::vector<PlayerHandler> PlayerHandlers;
+        static std::mutex PlayerHandlersMutex;
+        static std::once_flag PlayerDispatchStarted;
+
+        // Runs as a scheduler coroutine, so it sleeps between rounds without holding a thread.
+        // While the server is struggling, LoadGovernor stretches the interval between rounds.
+        static void PlayerDispatchLoop(std::chrono::milliseconds base_interval) {
+            while (true) {
+                auto interval = base_interval * LoadGovernor::Scale();
+                auto tick_start = ScriptScheduler::Now();
+                std::vector<PlayerHandler> handlers;
+                {
+                    std::lock_guard<std::mutex> lock(PlayerHandlersMutex);
+                    handlers = PlayerHandlers;
+                }
+
+                std::vector<ScriptInstance*> failed;
+                if (!handlers.empty()) {
+                    EntityList::Update();
+                    for (EntityList::Player* player : EntityList::GetValidPlayers()) {
+                        if (handlers.empty()) {
+                            break;
+                        }
+                        for (size_t i = 0; i < handlers.size(); ) {
+                            ScriptInstance& script = *handlers[i].script;
+                            if (!script.TryEnter()) {
+                                i++; // Running on_tick or a timer right now, it gets this player next round
+                                continue;
+                            }
+                            try {
+                                ArgList args(script.context.memory.Scratch());
+                                args.emplace_back(player);
+                                script.interpreter.CallScriptFunction(handlers[i].function, args, script.context);
+                                script.Leave();
+                                i++;
+                            }
+                            catch (const std::exception& e) {
+                                script.Leave();
+                                std::string error = "[BegeerteScript] on_player in " + script.name + " failed and was removed: " + e.what();
+                                std::cerr << error << std::endl;
+                                WriteScriptLog(error);
+                                failed.push_back(&script);
+                                handlers.erase(handlers.begin() + i);
+                            }
+                        }
+                    }
+                    for (auto& handler : handlers) {
+                        handler.script->context.memory.ResetScratch();
+                    }
+                }
+
+                if (!failed.empty()) {
+                    std::lock_guard<std::mutex> lock(PlayerHandlersMutex);
+                    std::erase_if(PlayerHandlers, [&](const PlayerHandler& handler) {
+                        return std::find(failed.begin(), failed.end(), handler.script.get()) != failed.end();
+                        });
+                }
+                auto elapsed = ScriptScheduler::Now() - tick_start;
+                if (elapsed < interval) {
+                    ScriptScheduler::Sleep(std::chrono::duration_cast<std::chrono::milliseconds>(interval - elapsed));
+                }
+                else {
+                    ScriptScheduler::Yield();
+                }
+            }
+        }
+
+        // Called once the script's top level has finished, so only the dispatch loop touches its context from now on
+        static void RegisterPlayerHandler(const std::shared_ptr<ScriptInstance>& script) {
+            auto function = script->context.script_functions.find("on_player");
+            if (function == script->context.script_functions.end()) {
+                return;
+            }
+            if (function->second.params.size() != 1) {
+                std::cerr << "[BegeerteScript] " << script->name << ": on_player must take exactly one parameter (player)." << std::endl;
+                return;
+            }
+            {
+                std::lock_guard<std::mutex> lock(PlayerHandlersMutex);
+                PlayerHandlers.push_back(PlayerHandler{ script, function->second });
+            }
+            std::cout << "[BegeerteScript] Registered on_player handler: " << script->name << std::endl;
+
+            std::call_once(PlayerDispatchStarted, [] {
+                // [Scripts] PlayerTickMs: how often on_player handlers run
+                int tick_ms = Config::GetInt("Scripts", "PlayerTickMs", 100);
+                auto interval = std::chrono::milliseconds(tick_ms > 0 ? tick_ms : 1);
+                ScriptScheduler::Shared().Spawn("on_player", [interval] { PlayerDispatchLoop(interval); });
+                });
+        }
+
+        // --- Game-thread tick ---
+        // Once the engine tick is hooked, on_tick(dt) runs synchronously inside the server tick, so every script
+        // sees the same entity list snapshot and never races the game thread. Until then (GAME_ENGINE_TICK unset
+        // or the hook failed) Hook drives it from the service thread and only the shared snapshot holds.
+        // Handlers share a time budget per tick; whatever does not fit runs first on the next tick, and its dt
+        // covers the time it was deferred.
+        struct TickHandler {
+            std::shared_ptr<ScriptInstance> script;
+            ScriptFunction function;
+            std::chrono::steady_clock::time_point last_run;
+        };
+        static std::vector<TickHandler> TickHandlers;
+        static std::mutex TickHandlersMutex;
+        static size_t NextTickHandler = 0; // Round-robin start, so deferred handlers go first
+        static std::chrono::microseconds TickBudget{ 2000 };
+        // The budget is only checked between handlers and the tick cannot be preempted, so a single handler that
+        // runs this long is stopped at its next preemption point and removed
+        static std::chrono::microseconds TickHandlerCap{ 10000 };
+        static uint64_t ServerTicks = 0;
+
+        static void RunServerTick(double dt_ms) {
+            std::lock_guard<std::mutex> lock(TickHandlersMutex);
+            if (TickHandlers.empty() || IdleMode::Active()) {
+                return;
+            }
+            // Under load only every Scale()-th server tick runs the handlers; their dt covers the skipped ones
+            if (++ServerTicks % static_cast<uint64_t>(LoadGovernor::Scale()) != 0) {
+                return;
+            }
+            auto tick_start = std::chrono::steady_clock::now();
+            auto script_now = ScriptScheduler::Now(); // Virtual under [Scripts] VirtualTime, the budget stays on real time
+            InServerTick = true;
+            EntityList::Update();
+
+            std::vector<size_t> failed;
+            size_t count = TickHandlers.size();
+            size_t attempted = 0;
+            for (; attempted < count; ++attempted) {
+                auto now = std::chrono::steady_clock::now();
+                if (attempted > 0 && now - tick_start >= TickBudget) {
+                    break; // Out of budget, the rest is deferred
+                }
+                size_t i = (NextTickHandler + attempted) % count;
+                TickHandler& handler = TickHandlers[i];
+                ScriptInstance& script = *handler.script;
+                // Never block the game thread: if on_player or a timer is running this script, try again next tick
+                if (!script.TryEnter()) {
+                    continue;
+                }
+                double handler_dt = handler.last_run.time_since_epoch().count() == 0 ? dt_ms :
+                    std::chrono::duration<double, std::milli>(script_now - handler.last_run).count();
+                handler.last_run = script_now;
+                try {
+                    ArgList args(script.context.memory.Scratch());
+                    args.emplace_back(handler_dt);
+                    script.context.budget.SetDeadline(std::chrono::steady_clock::now() + TickHandlerCap);
+                    script.interpreter.CallScriptFunction(handler.function, args, script.context);
+                    script.context.budget.SetDeadline({});
+                    script.context.memory.ResetScratch();
+                    script.Leave();
+                }
+                catch (const std::exception& e) {
+                    script.context.budget.SetDeadline({});
+                    script.Leave();
+                    std::string error = "[BegeerteScript] on_tick in " + script.name + " failed and was removed: " + e.what();
+                    std::cerr << error << std::endl;
+                    WriteScriptLog(error);
+                    failed.push_back(i);
+                }
+            }
+            InServerTick = false;
+
+            NextTickHandler = (NextTickHandler + attempted) % count;
+            std::sort(failed.begin(), failed.end(), std::greater<size_t>());
+            for (size_t i : failed) {
+                TickHandlers.erase(TickHandlers.begin() + i);
+                if (i < NextTickHandler) {
+                    NextTickHandler--;
+                }
+            }
+            if (NextTickHandler >= TickHandlers.size()) {
+                NextTickHandler = 0;
+            }
+        }
+
+        static void RegisterTickHandler(const std::shared_ptr<ScriptInstance>& script) {
+            auto function = script->context.script_functions.find("on_tick");
+            if (function == script->context.script_functions.end()) {
+                return;
+            }
+            if (function->second.params.size() != 1) {
+                std::cerr << "[BegeerteScript] " << script->name << ": on_tick must take exactly one parameter (dt)." << std::endl;
+                return;
+            }
+            std::lock_guard<std::mutex> lock(TickHandlersMutex);
+            TickHandlers.push_back(TickHandler{ script, function->second });
+            std::cout << "[BegeerteScript] Registered on_tick handler: " << script->name << std::endl;
+        }
+
+        // --- Player events ---
+        // PlayerEvents diffs every entity list update and queues join, leave and field change events for the
+        // scripts that handle them. A script's own coroutine drains its queue once the top level has finished,
+        // and sleeps in between until the publisher wakes it.
+        static std::once_flag PlayerEventPollStarted;
+
+        // Only updates the entity list when nothing else did since the last round (on_tick, on_player or a
+        // script calling EntityList_Update), so events keep flowing without a second full scan per tick
+        static void PlayerEventPollLoop(std::chrono::milliseconds interval) {
+            unsigned long long seen_epoch = EntityList::GetUpdateEpoch();
+            while (true) {
+                ScriptScheduler::Sleep(interval * LoadGovernor::Scale());
+                unsigned long long epoch = EntityList::GetUpdateEpoch();
+                if (epoch == seen_epoch) {
+                    EntityList::Update();
+                    epoch = EntityList::GetUpdateEpoch();
+                }
+                seen_epoch = epoch;
+            }
+        }
+
+        static const ScriptFunction* FindHandler(ScriptContext& context, const std::string& name, size_t param_count, const std::string& params) {
+            auto function = context.script_functions.find(name);
+            if (function == context.script_functions.end()) {
+                return nullptr;
+            }
+            if (function->second.params.size() != param_count) {
+                std::cerr << "[BegeerteScript] " << std::filesystem::path(context.current_script_path).filename().string() << ": " << name
+                    << " must take exactly " << param_count << " parameter(s) (" << params << ")." << std::endl;
+                return nullptr;
+            }
+            return &function->second;
+        }
+
+        // Called on the script's coroutine once its top level has finished
+        static void RegisterEventHandlers(const std::shared_ptr<ScriptInstance>& script) {
+            ScriptContext& context = script->context;
+            bool joins = FindHandler(context, "on_player_join", 1, "player") != nullptr;
+            bool leaves = FindHandler(context, "on_player_leave", 1, "player") != nullptr;
+            bool fields = FindHandler(context, "on_field_changed", 4, "player, field, old, new") != nullptr;
+            if (!joins && !leaves && !fields) {
+                return;
+            }
+
+            // [Scripts] EventQueueSize: events a script can fall behind by before new ones are dropped
+            int capacity = std::max(Config::GetInt("Scripts", "EventQueueSize", 1024), 16);
+            auto subscription = std::make_shared<PlayerEvents::Subscription>(static_cast<size_t>(capacity));
+            subscription->coroutine = ScriptScheduler::CurrentId();
+            subscription->joins = joins;
+            subscription->leaves = leaves;
+            subscription->fields = fields ? context.watched_fields : 0;
+            context.events = subscription;
+            PlayerEvents::Subscribe(subscription);
+            std::cout << "[BegeerteScript] Registered player event handlers: " << script->name << std::endl;
+
+            std::call_once(PlayerEventPollStarted, [] {
+                // [Scripts] PlayerEventMs: how often the entity list is checked for changes when nothing else refreshes it
+                int poll_ms = Config::GetInt("Scripts", "PlayerEventMs", 100);
+                auto interval = std::chrono::milliseconds(poll_ms > 0 ? poll_ms : 1);
+                ScriptScheduler::Shared().Spawn("player_events", [interval] { PlayerEventPollLoop(interval); });
+                });
+        }
+
+        static void DispatchPlayerEvents(ScriptInstance& script) {
+            ScriptContext& context = script.context;
+            PlayerEvents::Subscription& subscription = *context.events;
+            Interpreter interpreter;
+            PlayerEvent event;
+            while (subscription.queue.TryPop(event)) {
+                const char* name = event.kind == PlayerEvent::Kind::Join ? "on_player_join" :
+                    event.kind == PlayerEvent::Kind::Leave ? "on_player_leave" : "on_field_changed";
+                auto function = context.script_functions.find(name);
+                if (function == context.script_functions.end()) {
+                    continue;
+                }
+                try {
+                    ArgList args(context.memory.Scratch());
+                    args.emplace_back(event.player);
+                    if (event.kind == PlayerEvent::Kind::FieldChanged) {
+                        args.emplace_back(std::string(PlayerEvents::FieldName(event.field)));
+                        args.emplace_back(static_cast<long long>(event.old_value));
+                        args.emplace_back(static_cast<long long>(event.new_value));
+                    }
+                    interpreter.CallScriptFunction(function->second, args, context);
+                }
+                catch (const ScriptMemoryError&) {
+                    throw;
+                }
+                catch (const ScriptWatchdogError&) {
+                    throw;
+                }
+                catch (const std::exception& e) {
+                    std::string error = std::string("[BegeerteScript] ") + name + " in " + script.name + " failed and was removed: " + e.what();
+                    std::cerr << error << std::endl;
+                    WriteScriptLog(error);
+                    if (event.kind == PlayerEvent::Kind::Join) subscription.joins = false;
+                    else if (event.kind == PlayerEvent::Kind::Leave) subscription.leaves = false;
+                    else subscription.fields = 0;
+                }
+            }
+
+            uint64_t dropped = subscription.queue.Dropped();
+            if (dropped != subscription.reported_drops) {
+                std::string warning = "[BegeerteScript] " + script.name + " fell behind and lost " + std::to_string(dropped - subscription.reported_drops) +
+                    " player event(s). Raise [Scripts] EventQueueSize or watch fewer fields.";
+                std::cerr << warning << std::endl;
+                WriteScriptLog(warning);
+                subscription.reported_drops = dropped;
+            }
+            if (!subscription.joins && !subscription.leaves && subscription.fields == 0) {
+                PlayerEvents::Unsubscribe(&subscription);
+                context.events.reset();
+            }
+        }
+
+        // Keeps the script's coroutine alive for its timers and player events after the top level has finished
+        static void ServeScript(ScriptInstance& script) {
+            ScriptContext& context = script.context;
+            while (ServesTimers(context) || context.events) {
+                bool pending = context.events && !context.events->queue.Empty();
+                if (!pending) {
+                    // Without timers the only way out of the sleep is an event, the deadline just has to be finite
+                    auto wake_time = ServesTimers(context) ?
+                        ScriptScheduler::Clock::time_point(std::chrono::milliseconds(context.timers.wheel.NextDeadline())) :
+                        ScriptScheduler::Now() + std::chrono::hours(1);
+                    if (context.events) {
+                        ScriptScheduler::SleepUntilWoken(wake_time);
+                    }
+                    else {
+                        ScriptScheduler::SleepUntil(wake_time);
+                    }
+                }
+                if (!script.TryEnter()) {
+                    ScriptScheduler::Sleep(std::chrono::milliseconds(1)); // on_player or on_tick is running it
+                    continue;
+                }
+                try {
+                    if (ServesTimers(context)) {
+                        FireTimers(context);
+                    }
+                    if (context.events) {
+                        DispatchPlayerEvents(script);
+                    }
+                    context.memory.ResetScratch(); // Nothing outside the handlers holds scratch memory here
+                }
+                catch (...) {
+                    script.Leave();
+                    throw;
+                }
+                script.Leave();
+            }
+        }
+
+        // Structure to hold script execution data
+        struct ScriptTask {
+            std::string path;
+            std::string content;
+            bool executed = false;
+            std::string error;
+        };
+
+        void Init() {
+            std::cout << "[BegeerteScript] Initializing..." << std::endl;
+
+            // Get the root directory of the current process
+            std::filesystem::path root_dir = Platform::ExecutableDirectory();
+
+            // Set script and log directories
+            ScriptDirectory = root_dir / "Begeerte" / "Scripts";
+            LogDirectory = root_dir / "Begeerte" / "Logs";
+            DataDirectory = root_dir / "Begeerte" / "Data";
+
+            // Create directories if they don't exist
+            std::filesystem::create_directories(ScriptDirectory);
+            std::filesystem::create_directories(LogDirectory);
+            std::filesystem::create_directories(DataDirectory);
+
+            // [Scripts] LogFlushMs: how often buffered log lines are written out, 0 writes every line immediately
+            int flush_ms = Config::GetInt("Scripts", "LogFlushMs", 1000);
+            if (flush_ms > 0) {
+                {
+                    std::lock_guard<std::mutex> lock(LogMutex);
+                    BufferLog = true;
+                }
+                ServiceLoop::Register("script log flush", std::chrono::milliseconds(flush_ms), FlushScriptLog);
+            }
+
+            std::cout << "[BegeerteScript] Scanning for .beg files in: " << ScriptDirectory << std::endl;
+
+            // Collect all script tasks
+            std::vector<ScriptTask> tasks;
+            for (const auto& entry : std::filesystem::directory_iterator(ScriptDirectory)) {
+                if (entry.is_regular_file() && entry.path().extension() == ".beg") {
+                    std::string script_path_str = entry.path().string();
+                    std::cout << "[BegeerteScript] Found script: " << script_path_str << std::endl;
+
+                    std::ifstream script_file(entry.path());
+                    if (!script_file.is_open()) {
+                        std::cerr << "[BegeerteScript] Error: Could not open script file: " << script_path_str << std::endl;
+                        continue;
+                    }
+
+                    std::stringstream script_buffer;
+                    script_buffer << script_file.rdbuf();
+                    script_file.close();
+                    std::string script_content = script_buffer.str();
+
+                    // [Scripts] Lint=0 turns the load-time performance lint off
+                    if (Config::GetInt("Scripts", "Lint", 1) != 0) {
+                        LintScript(script_path_str, script_content);
+                    }
+
+                    tasks.emplace_back(ScriptTask{ script_path_str, script_content });
+                }
+            }
+
+            std::cout << "[BegeerteScript] Total scripts found: " << tasks.size() << std::endl;
+
+            // [Scripts] TickBudgetUs: game-thread time all on_tick handlers may use per server tick
+            TickBudget = std::chrono::microseconds(std::max(Config::GetInt("Scripts", "TickBudgetUs", 2000), 1));
+            TickHandlerCap = TickBudget * 5;
+            ScriptScheduler& scheduler = ScriptScheduler::Shared();
+            if (ScriptScheduler::VirtualTime()) {
+                // The engine tick runs on real time, so under VirtualTime on_tick is driven from the simulated
+                // clock instead: one tick every [Scripts] VirtualTickMs of script time
+                auto step = std::chrono::milliseconds(std::max(Config::GetInt("Scripts", "VirtualTickMs", 33), 1));
+                // Hold the clock until every script is spawned, or the first ones could run hours ahead of the rest
+                scheduler.Park(ScriptScheduler::ParkReason::Startup, true);
+                scheduler.Spawn("virtual tick", [step]() {
+                    while (true) {
+                        ScriptScheduler::Sleep(step);
+                        // Handlers run under TickHandlersMutex, so they must not be preempted here either
+                        ScriptScheduler::HoldPreemption(true);
+                        RunServerTick(std::chrono::duration<double, std::milli>(step).count());
+                        ScriptScheduler::HoldPreemption(false);
+                    }
+                    });
+            }
+            else {
+                Hook::SetTickCallback(RunServerTick);
+            }
+            PlayerEvents::Init();
+            IdleMode::Init();
+
+            // Every script becomes a coroutine on the shared scheduler instead of getting its own thread
+            for (auto& task : tasks) {
+                scheduler.Spawn(std::filesystem::path(task.path).filename().string(), [task]() {  // Capture task by value
+                    std::cout << "[BegeerteScript] Loading script: " << std::filesystem::path(task.path).filename() << std::endl;
+                    std::string script_name = std::filesystem::path(task.path).filename().string();
+                    // [Scripts] MemoryLimitKB applies to every script, [Script:<file>.beg] MemoryLimitKB overrides it
+                    int default_limit_kb = Config::GetInt("Scripts", "MemoryLimitKB", static_cast<int>(ScriptMemory::DefaultLimit / 1024));
+                    int limit_kb = Config::GetInt("Script:" + script_name, "MemoryLimitKB", default_limit_kb);
+                    auto script = std::make_shared<ScriptInstance>(task.path, static_cast<size_t>(limit_kb) * 1024);
+                    ScriptContext& context = script->context;
+                    context.budget = ScriptBudget(WatchdogLimits::FromConfig(script_name));
+                    // [Script:<file>.beg] Priority and DeadlineMs set the script's class up front, like set_priority
+                    ScriptScheduler::Priority priority;
+                    if (ScriptScheduler::ParsePriority(Config::GetString("Script:" + script_name, "Priority", "normal"), priority)) {
+                        ScriptScheduler::SetPriority(priority, std::chrono::milliseconds(std::max(Config::GetInt("Script:" + script_name, "DeadlineMs", 0), 0)));
+                    }
+                    // [Scripts] NativeCache=0 makes every getter read game memory again, even within one entity list update
+                    context.native_cache.enabled = Config::GetInt("Scripts", "NativeCache", 1) != 0;
+                    // Register common functions
+                    context.RegisterFunction("printf", Printf);
+                    context.RegisterFunction("print", Print);
+                    context.RegisterFunction("LogToFile", LogToFile);
+                    // Register EntityList API for this script
+                    RegisterEntityListAPI(context);
+                    RegisterSchedulerAPI(context);
+                    RegisterChannelAPI(context);
+                    RegisterJobAPI(context);
+                    RegisterFileAPI(context);
+
+                    if (!g_cheatdata) {
+                        std::string error = "[BegeerteScript] FATAL: g_cheatdata not initialized. Aborting script: " + task.path;
+                        std::cerr << error << std::endl;
+                        WriteScriptLog(error);
+                        return;
+                    }
+
+                    try {
+                        context.timers.owner = ScriptScheduler::CurrentId();
+                        script->interpreter.Execute(task.content, context);
+                        std::cout << "[BegeerteScript] Finished executing: " << std::filesystem::path(task.path).filename() << std::endl;
+                        RegisterPlayerHandler(script);
+                        RegisterTickHandler(script);
+                        RegisterEventHandlers(script);
+                        ServeScript(*script);
+                    }
+                    catch (const std::exception& e) {
+                        if (context.events) {
+                            PlayerEvents::Unsubscribe(context.events.get());
+                        }
+                        std::string error = "[BegeerteScript] Unhandled exception in " + std::filesystem::path(task.path).filename().string() + ": " + e.what();
+                        std::cerr << error << std::endl;
+                        WriteScriptLog(error);
+                    }
+                    });
+            }
+            if (ScriptScheduler::VirtualTime()) {
+                scheduler.Park(ScriptScheduler::ParkReason::Startup, false);
+            }
+
+            std::cout << "[BegeerteScript] Initialization complete. Scripts are running on " << scheduler.WorkerCount() << " scheduler thread(s)." << std::endl;
+        }
+
+    } // namespace Plugins
 } // namespace BegeerteScript
\ No newline at end of file
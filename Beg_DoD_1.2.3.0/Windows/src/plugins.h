@@ -1,206 +1,476 @@
-#pragma once
-
-#include <string>
-#include <vector>
-#include <map>
-#include <functional>
-#include <variant>
-#include <stdexcept>
-#include <filesystem> // For C++17 filesystem operations
-#include <iostream>   // For basic error logging
-#include <fstream>
-#include <sstream>
-
-// Forward declaration for classes within the namespace
-namespace BegeerteScript {
-    class Value;
-    class ScriptContext;
-    class Interpreter;
-}
-
-// Include your project's headers
-#include "EntityList.h" // This will include Windows.h, Vector.h, SDK.h, CheatData.h
-
-namespace BegeerteScript {
-
-    // Represents a script value (can be number, string, boolean, Player*, or null)
-    class Value {
-    public:
-        enum class Type { NIL, BOOL, NUMBER_INT, NUMBER_FLOAT, STRING, PLAYER_PTR, NATIVE_FUNCTION };
-        Type type;
-        std::variant<std::nullptr_t, bool, long long, double, std::string, EntityList::Player*> value;
-
-        // Store native function pointers if needed, though direct call is simpler for now
-        // std::function<Value(std::vector<Value>)> native_func;
-
-
-        Value() : type(Type::NIL), value(nullptr) {}
-        Value(bool b) : type(Type::BOOL), value(b) {}
-        Value(int i) : type(Type::NUMBER_INT), value((long long)i) {}
-        Value(long long i) : type(Type::NUMBER_INT), value(i) {}
-        Value(double d) : type(Type::NUMBER_FLOAT), value(d) {}
-        Value(const char* s) : type(Type::STRING), value(std::string(s)) {}
-        Value(const std::string& s) : type(Type::STRING), value(s) {}
-        Value(EntityList::Player* p) : type(Type::PLAYER_PTR), value(p) {}
-
-        Type GetType() const { return type; }
-
-        bool IsNil() const { return type == Type::NIL; }
-        bool IsTruthy() const {
-            if (type == Type::NIL) return false;
-            if (type == Type::BOOL) return std::get<bool>(value);
-            if (type == Type::NUMBER_INT) return std::get<long long>(value) != 0;
-            if (type == Type::NUMBER_FLOAT) return std::get<double>(value) != 0.0;
-            if (type == Type::PLAYER_PTR) return std::get<EntityList::Player*>(value) != nullptr;
-            return true; // Strings are truthy if not empty, but for simplicity now, all non-nil are truthy
-        }
-
-        bool AsBool() const {
-            if (type == Type::BOOL) return std::get<bool>(value);
-            throw std::runtime_error("Value is not a boolean");
-        }
-        long long AsInt() const {
-            if (type == Type::NUMBER_INT) return std::get<long long>(value);
-            if (type == Type::NUMBER_FLOAT) return static_cast<long long>(std::get<double>(value));
-            throw std::runtime_error("Value is not an integer");
-        }
-        double AsFloat() const {
-            if (type == Type::NUMBER_FLOAT) return std::get<double>(value);
-            if (type == Type::NUMBER_INT) return static_cast<double>(std::get<long long>(value));
-            throw std::runtime_error("Value is not a float");
-        }
-        std::string AsString() const {
-            if (type == Type::STRING) return std::get<std::string>(value);
-            if (type == Type::NUMBER_INT) return std::to_string(std::get<long long>(value));
-            if (type == Type::NUMBER_FLOAT) return std::to_string(std::get<double>(value));
-            if (type == Type::BOOL) return std::get<bool>(value) ? "true" : "false";
-            if (type == Type::NIL) return "nil";
-            if (type == Type::PLAYER_PTR) {
-                std::stringstream ss;
-                ss << "Player@0x" << std::hex << reinterpret_cast<uintptr_t>(std::get<EntityList::Player*>(value));
-                return ss.str();
-            }
-            throw std::runtime_error("Cannot convert value to string");
-        }
-        EntityList::Player* AsPlayer() const {
-            if (type == Type::PLAYER_PTR) return std::get<EntityList::Player*>(value);
-            throw std::runtime_error("Value is not a Player pointer");
-        }
-
-        // For debugging
-        std::string ToString() const {
-            switch (type) {
-            case Type::NIL: return "nil";
-            case Type::BOOL: return AsString();
-            case Type::NUMBER_INT: return AsString();
-            case Type::NUMBER_FLOAT: return AsString();
-            case Type::STRING: return "\"" + AsString() + "\"";
-            case Type::PLAYER_PTR: return AsString();
-            default: return "Unknown Value Type";
-            }
-        }
-    };
-
-    // Using a type alias for native functions exposed to the script
-    using NativeFunction = std::function<Value(std::vector<Value>& args)>;
-
-    class ScriptContext {
-    public:
-        std::map<std::string, Value> variables;
-        std::map<std::string, NativeFunction> functions;
-        std::string current_script_path; // For error reporting
-
-        ScriptContext(const std::string& script_path = "") : current_script_path(script_path) {}
-
-        void RegisterFunction(const std::string& name, NativeFunction func) {
-            functions[name] = func;
-        }
-
-        void SetVariable(const std::string& name, const Value& val) {
-            variables[name] = val;
-        }
-
-        Value GetVariable(const std::string& name) {
-            if (variables.count(name)) {
-                return variables[name];
-            }
-            // Could also throw an error or return Value() (nil)
-            std::cerr << "Runtime Error in '" << current_script_path << "': Variable '" << name << "' not found." << std::endl;
-            return Value();
-        }
-
-        bool HasFunction(const std::string& name) const {
-            return functions.count(name);
-        }
-
-        Value CallFunction(const std::string& name, std::vector<Value>& args) {
-            if (functions.count(name)) {
-                try {
-                    return functions[name](args);
-                }
-                catch (const std::exception& e) {
-                    std::cerr << "Runtime Error in '" << current_script_path
-                        << "' calling function '" << name << "': " << e.what() << std::endl;
-                    return Value(); // Return nil on error
-                }
-            }
-            std::cerr << "Runtime Error in '" << current_script_path << "': Function '" << name << "' not found." << std::endl;
-            return Value(); // Return nil
-        }
-    };
-
-
-    class Interpreter {
-    public:
-        void Execute(const std::string& script_content, ScriptContext& context);
-
-    private:
-        // Basic tokenizer and parser helper (very simplified)
-        struct Token {
-            enum class Type { IDENTIFIER, NUMBER, STRING, OPERATOR, KEYWORD, END_OF_LINE, UNKNOWN, END_OF_FILE };
-            Type type;
-            std::string text;
-            size_t line_number = 0; // For error reporting
-        };
-
-        std::vector<Token> Tokenize(const std::string& script_content, const std::string& script_path);
-        Value ParseExpression(const std::vector<Token>& tokens, size_t& index, ScriptContext& context, const std::string& script_path);
-        Value ParseTerm(const std::vector<Token>& tokens, size_t& index, ScriptContext& context, const std::string& script_path);
-        Value ParseFactor(const std::vector<Token>& tokens, size_t& index, ScriptContext& context, const std::string& script_path);
-        std::vector<Value> ParseArgumentList(const std::vector<Token>& tokens, size_t& index, ScriptContext& context, const std::string& script_path);
-
-        // Statement parsing
-        void ParseStatement(const std::vector<Token>& tokens, size_t& index, ScriptContext& context, const std::string& script_path);
-        void ParseAssignmentOrFunctionCall(const std::vector<Token>& tokens, size_t& index, ScriptContext& context, const std::string& script_path);
-        void ParseIfStatement(const std::vector<Token>& tokens, size_t& index, ScriptContext& context, const std::string& script_path);
-        void ParseWhileStatement(const std::vector<Token>& tokens, size_t& index, ScriptContext& context, const std::string& script_path);
-        void ParseBlock(const std::vector<Token>& tokens, size_t& index, ScriptContext& context, const std::string& script_path);
-        // Helper to skip tokens until a certain point, useful for skipping blocks in if/while
-        void SkipBlock(const std::vector<Token>& tokens, size_t& index, const std::string& script_path);
-
-
-        // Error reporting
-        void SyntaxError(const std::string& message, const std::string& script_path, size_t line_number = 0) {
-            std::cerr << "Syntax Error in '" << script_path << "'";
-            if (line_number > 0) {
-                std::cerr << " (Line " << line_number << ")";
-            }
-            std::cerr << ": " << message << std::endl;
-            throw std::runtime_error("Syntax error occurred."); // Stop execution
-        }
-    };
-
-
-    namespace Plugins {
-        // Initializes the scripting system, loads and executes all .beg scripts.
-        void Init();
-
-        // Registers all EntityList related functions to a given script context
-        void RegisterEntityListAPI(ScriptContext& context);
-
-        // A simple utility function to be exposed to script
-        Value Print(std::vector<Value>& args);
-        Value LogToFile(std::vector<Value>& args); // Example: LogToFile("message")
-
-    } // namespace Plugins
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <memory>
+#include <functional>
+#include <variant>
+#include <stdexcept>
+#include <filesystem> // For C++17 filesystem operations
+#include <iostream>   // For basic error logging
+#include <fstream>
+#include <sstream>
+#include <memory_resource>
+#include <unordered_map>
+#include <mutex>
+#include <chrono>
+#include <atomic>
+
+// Forward declaration for classes within the namespace
+namespace BegeerteScript {
+    class Value;
+    class ScriptContext;
+    class Interpreter;
+    struct CompiledModule;
+}
+
+// Include your project's headers
+#include "EntityList.h" // This will include Windows.h, Vector.h, SDK.h, CheatData.h
+#include "ScriptMemory.h"
+#include "ScriptLexer.h"
+#include "ScriptNativeCache.h"
+#include "ScriptWatchdog.h"
+#include "TimerWheel.h"
+#include "ScriptScheduler.h"
+#include "PlayerEvents.h"
+
+namespace BegeerteScript {
+
+    // Represents a script value (can be number, string, boolean, Player*, or null)
+    class Value {
+    public:
+        enum class Type { NIL, BOOL, NUMBER_INT, NUMBER_FLOAT, STRING, PLAYER_PTR, NATIVE_FUNCTION };
+        Type type;
+        std::variant<std::nullptr_t, bool, long long, double, std::string, EntityList::Player*> value;
+
+        // Store native function pointers if needed, though direct call is simpler for now
+        // std::function<Value(std::vector<Value>)> native_func;
+
+
+        Value() : type(Type::NIL), value(nullptr) {}
+        Value(bool b) : type(Type::BOOL), value(b) {}
+        Value(int i) : type(Type::NUMBER_INT), value((long long)i) {}
+        Value(long long i) : type(Type::NUMBER_INT), value(i) {}
+        Value(double d) : type(Type::NUMBER_FLOAT), value(d) {}
+        Value(const char* s) : type(Type::STRING), value(std::string(s)) {}
+        Value(const std::string& s) : type(Type::STRING), value(s) {}
+        Value(EntityList::Player* p) : type(Type::PLAYER_PTR), value(p) {}
+
+        Type GetType() const { return type; }
+
+        // Heap bytes held outside the Value itself (long strings), charged against the script's memory cap
+        size_t HeapFootprint() const {
+            if (type != Type::STRING) return 0;
+            size_t capacity = std::get<std::string>(value).capacity();
+            return capacity > 15 ? capacity + 1 : 0; // Short strings live in the small-string buffer
+        }
+
+        bool IsNil() const { return type == Type::NIL; }
+        bool IsTruthy() const {
+            if (type == Type::NIL) return false;
+            if (type == Type::BOOL) return std::get<bool>(value);
+            if (type == Type::NUMBER_INT) return std::get<long long>(value) != 0;
+            if (type == Type::NUMBER_FLOAT) return std::get<double>(value) != 0.0;
+            if (type == Type::PLAYER_PTR) return std::get<EntityList::Player*>(value) != nullptr;
+            return true; // Strings are truthy if not empty, but for simplicity now, all non-nil are truthy
+        }
+
+        bool AsBool() const {
+            if (type == Type::BOOL) return std::get<bool>(value);
+            throw std::runtime_error("Value is not a boolean");
+        }
+        long long AsInt() const {
+            if (type == Type::NUMBER_INT) return std::get<long long>(value);
+            if (type == Type::NUMBER_FLOAT) return static_cast<long long>(std::get<double>(value));
+            throw std::runtime_error("Value is not an integer");
+        }
+        double AsFloat() const {
+            if (type == Type::NUMBER_FLOAT) return std::get<double>(value);
+            if (type == Type::NUMBER_INT) return static_cast<double>(std::get<long long>(value));
+            throw std::runtime_error("Value is not a float");
+        }
+        std::string AsString() const {
+            if (type == Type::STRING) return std::get<std::string>(value);
+            if (type == Type::NUMBER_INT) return std::to_string(std::get<long long>(value));
+            if (type == Type::NUMBER_FLOAT) return std::to_string(std::get<double>(value));
+            if (type == Type::BOOL) return std::get<bool>(value) ? "true" : "false";
+            if (type == Type::NIL) return "nil";
+            if (type == Type::PLAYER_PTR) {
+                std::stringstream ss;
+                ss << "Player@0x" << std::hex << reinterpret_cast<uintptr_t>(std::get<EntityList::Player*>(value));
+                return ss.str();
+            }
+            throw std::runtime_error("Cannot convert value to string");
+        }
+        EntityList::Player* AsPlayer() const {
+            if (type == Type::PLAYER_PTR) return std::get<EntityList::Player*>(value);
+            throw std::runtime_error("Value is not a Player pointer");
+        }
+
+        // For debugging
+        std::string ToString() const {
+            switch (type) {
+            case Type::NIL: return "nil";
+            case Type::BOOL: return AsString();
+            case Type::NUMBER_INT: return AsString();
+            case Type::NUMBER_FLOAT: return AsString();
+            case Type::STRING: return "\"" + AsString() + "\"";
+            case Type::PLAYER_PTR: return AsString();
+            default: return "Unknown Value Type";
+            }
+        }
+    };
+
+    // Argument lists live in the calling script's scratch arena
+    using ArgList = std::pmr::vector<Value>;
+    using VariableMap = std::pmr::map<std::string, Value>;
+
+    // Using a type alias for native functions exposed to the script
+    using NativeFunction = std::function<Value(ArgList& args)>;
+
+    struct RegisteredNative {
+        NativeFunction function;
+        NativeTraits traits;
+    };
+
+    // Results of pure and tick-stable natives, keyed by call site and arguments. One per script.
+    // Tick-stable entries are dropped when the entity list update epoch moves on.
+    class NativeResultCache {
+    public:
+        explicit NativeResultCache(std::pmr::memory_resource* resource) : entries(resource) {}
+
+        // Cached result, or nullptr on a miss
+        const Value* Find(const void* call_site, const ArgList& args, const NativeTraits& traits);
+        // 'group_version' is read before the native runs, so a setter racing with the call is not masked
+        void Store(const void* call_site, const ArgList& args, NativeKind kind, uint32_t group_version, const Value& result);
+
+        bool enabled = true;
+        size_t Hits() const { return hits; }
+        size_t Misses() const { return misses; }
+
+    private:
+        static constexpr size_t MaxEntries = 4096; // Cleared wholesale beyond this
+
+        struct Key {
+            const void* call_site;
+            size_t args_hash;
+            bool operator==(const Key& other) const = default;
+        };
+        struct KeyHash {
+            size_t operator()(const Key& key) const { return std::hash<const void*>()(key.call_site) ^ (key.args_hash * 31); }
+        };
+        struct Entry {
+            ArgList args; // Kept to rule out hash collisions
+            Value result;
+            NativeKind kind;
+            uint32_t group_version;
+        };
+
+        std::pmr::unordered_map<Key, Entry, KeyHash> entries;
+        unsigned long long epoch = 0; // EntityList update epoch the tick-stable entries belong to
+        size_t hits = 0;
+        size_t misses = 0;
+    };
+
+    class Channel;
+    struct SharedSlot;
+
+    // A script's copy of a shared value (see share_get) and the version it was taken at
+    struct SharedView {
+        std::shared_ptr<SharedSlot> slot;
+        uint64_t version = 0;
+        Value value;
+    };
+
+    // Result of a spawn() or file_*() call, filled in by the worker pool or I/O thread that ran it. The
+    // calling coroutine waits for it in await(); Finish wakes it if it asked to be woken.
+    struct ScriptJob {
+        std::string function;         // Spawned function; empty for file requests, whose error says it all
+        Value result;                 // Valid once 'done' is set
+        std::string error;            // Non-empty if the function threw
+        std::atomic<bool> done{ false };
+        std::atomic<uint64_t> waiter{ 0 };
+        std::atomic<bool> wake_waiter{ false };
+    };
+
+    // set_timeout/set_interval timers of one script. Only the script's own coroutine creates, cancels and
+    // fires them (see Plugins::FireTimers), so the wheel needs no lock.
+    struct ScriptTimers {
+        static uint64_t NowMs() {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                ScriptScheduler::Now().time_since_epoch()).count());
+        }
+
+        TimerWheel wheel{ NowMs() };
+        std::unordered_map<TimerWheel::TimerId, std::string> callbacks; // Script function each timer calls
+        uint64_t owner = 0;     // Scheduler coroutine of the script
+        bool firing = false;    // A callback is running; wait() inside it does not fire timers again
+    };
+
+    // Compiled modules are immutable once built and shared between every script that imports them
+    using ModulePtr = std::shared_ptr<const CompiledModule>;
+
+    // A function declared with 'function name(a, b) { ... }'. The body stays in the module's token
+    // stream, so defining the same function in many contexts costs no extra compilation.
+    struct ScriptFunction {
+        ModulePtr module;
+        size_t body_index = 0; // Index of the '{' that opens the body
+        std::vector<std::string> params;
+    };
+
+    class ScriptContext {
+    public:
+        ScriptMemory memory; // Must stay first: the maps below allocate from it
+        VariableMap variables;
+        std::map<std::string, RegisteredNative> functions;
+        std::map<std::string, ScriptFunction> script_functions;
+        std::vector<VariableMap> frames;         // Local scopes of active script function calls
+        std::set<std::string> imported_modules;  // Modules already run in this context
+        NativeResultCache native_cache;
+        ScriptBudget budget;
+        ScriptTimers timers;
+        std::shared_ptr<PlayerEvents::Subscription> events; // Set once the script handles player events
+        uint64_t watched_fields = PlayerEvents::AllFields;  // Fields on_field_changed hears about, see watch_fields()
+        // Channels and shared values this script used, so it only looks names up in the registry once
+        std::unordered_map<std::string, std::shared_ptr<Channel>> channels;
+        std::unordered_map<std::string, SharedView> shared_values;
+        std::unordered_map<long long, std::shared_ptr<ScriptJob>> jobs; // spawn() futures not awaited yet
+        long long next_job = 1;
+        std::string current_script_path; // For error reporting
+
+        // Only set in the worker contexts of a 'parallel for': assignments to variables from outside the
+        // loop (globals and 'outer_locals') are recorded here and merged back into the caller afterwards
+        struct Write {
+            std::string name;
+            Value value;
+        };
+        std::vector<Write>* write_log = nullptr;
+        const VariableMap* outer_locals = nullptr;
+        // Set in 'parallel for' worker contexts. The caller waits for every chunk inside RunAll, so natives
+        // that would suspend (wait, yield, await, ...) throw there instead.
+        bool parallel_body = false;
+
+        ScriptContext(const std::string& script_path = "", size_t memory_limit = ScriptMemory::DefaultLimit)
+            : memory(memory_limit), variables(memory.LongLived()), native_cache(memory.LongLived()), current_script_path(script_path) {}
+
+        void RegisterFunction(const std::string& name, NativeFunction func, NativeTraits traits = NativeTraits::Volatile()) {
+            functions[name] = RegisteredNative{ func, traits };
+        }
+
+        // 'let' inside a function declares a local, everywhere else a global
+        void DeclareVariable(const std::string& name, const Value& val) {
+            if (!frames.empty()) {
+                frames.back()[name] = val;
+                return;
+            }
+            StoreGlobal(name, val);
+        }
+
+        void SetVariable(const std::string& name, const Value& val) {
+            if (!frames.empty()) {
+                auto local = frames.back().find(name);
+                if (local != frames.back().end()) {
+                    local->second = val;
+                    if (write_log && outer_locals && outer_locals->count(name)) {
+                        write_log->push_back({ name, val });
+                    }
+                    return;
+                }
+            }
+            if (write_log) {
+                write_log->push_back({ name, val });
+            }
+            StoreGlobal(name, val);
+        }
+
+        // Globals outlive every loop iteration, so long string payloads are charged to the memory cap
+        void StoreGlobal(const std::string& name, const Value& val) {
+            Value& slot = variables[name];
+            memory.Charge(static_cast<long long>(val.HeapFootprint()) - static_cast<long long>(slot.HeapFootprint()));
+            slot = val;
+        }
+
+        Value GetVariable(const std::string& name) {
+            if (!frames.empty()) {
+                auto local = frames.back().find(name);
+                if (local != frames.back().end()) {
+                    return local->second;
+                }
+            }
+            if (variables.count(name)) {
+                return variables[name];
+            }
+            // Could also throw an error or return Value() (nil)
+            std::cerr << "Runtime Error in '" << current_script_path << "': Variable '" << name << "' not found." << std::endl;
+            return Value();
+        }
+
+        bool HasFunction(const std::string& name) const {
+            return functions.count(name);
+        }
+
+        bool HasScriptFunction(const std::string& name) const {
+            return script_functions.count(name);
+        }
+
+        // 'call_site' identifies the calling token; without it results are never cached
+        Value CallFunction(const std::string& name, ArgList& args, const void* call_site = nullptr) {
+            auto native = functions.find(name);
+            if (native != functions.end()) {
+                const NativeTraits& traits = native->second.traits;
+                bool cacheable = call_site && traits.Cacheable();
+                uint32_t group_version = NativeGroups::Version(traits.group);
+                if (cacheable) {
+                    if (const Value* cached = native_cache.Find(call_site, args, traits)) {
+                        return *cached;
+                    }
+                }
+                try {
+                    Value result = native->second.function(args);
+                    if (traits.kind == NativeKind::Mutating) {
+                        NativeGroups::Invalidate(traits.group);
+                    }
+                    else if (cacheable) {
+                        native_cache.Store(call_site, args, traits.kind, group_version, result);
+                    }
+                    return result;
+                }
+                catch (const ScriptMemoryError&) {
+                    throw; // Out of memory unloads the script instead of returning nil
+                }
+                catch (const ScriptWatchdogError&) {
+                    throw;
+                }
+                catch (const std::exception& e) {
+                    std::cerr << "Runtime Error in '" << current_script_path
+                        << "' calling function '" << name << "': " << e.what() << std::endl;
+                    return Value(); // Return nil on error
+                }
+            }
+            std::cerr << "Runtime Error in '" << current_script_path << "': Function '" << name << "' not found." << std::endl;
+            return Value(); // Return nil
+        }
+    };
+
+
+    class Interpreter {
+    public:
+        // Tokens come from the shared lexer (ScriptLexer.h)
+        using Token = BegeerteScript::Token;
+
+        void Execute(const std::string& script_content, ScriptContext& context);
+
+        // Runs the top level of a compiled module in the given context (own globals per context)
+        void RunModule(const ModulePtr& module, ScriptContext& context);
+
+        // Returns the shared compiled form of a module file, tokenizing it only on first use
+        ModulePtr LoadModule(const std::filesystem::path& module_path);
+
+        Value CallScriptFunction(const ScriptFunction& function, ArgList& args, ScriptContext& context);
+
+    private:
+        // Thrown by 'return' and caught by CallScriptFunction; deliberately not a std::exception
+        struct ReturnSignal {
+            Value value;
+        };
+
+        // Module whose tokens are currently being run; function definitions capture it
+        ModulePtr current_module;
+
+        struct ModuleScope {
+            Interpreter& interpreter;
+            ModulePtr previous;
+            ModuleScope(Interpreter& owner, const ModulePtr& module) : interpreter(owner), previous(owner.current_module) {
+                interpreter.current_module = module;
+            }
+            ~ModuleScope() { interpreter.current_module = previous; }
+        };
+
+        std::vector<Token> Tokenize(const std::string& script_content, const std::string& script_path);
+        Value ParseExpression(const std::vector<Token>& tokens, size_t& index, ScriptContext& context, const std::string& script_path);
+        Value ParseTerm(const std::vector<Token>& tokens, size_t& index, ScriptContext& context, const std::string& script_path);
+        Value ParseFactor(const std::vector<Token>& tokens, size_t& index, ScriptContext& context, const std::string& script_path);
+        ArgList ParseArgumentList(const std::vector<Token>& tokens, size_t& index, ScriptContext& context, const std::string& script_path);
+
+        // Statement parsing
+        void ParseStatement(const std::vector<Token>& tokens, size_t& index, ScriptContext& context, const std::string& script_path);
+        void ParseAssignmentOrFunctionCall(const std::vector<Token>& tokens, size_t& index, ScriptContext& context, const std::string& script_path);
+        void ParseIfStatement(const std::vector<Token>& tokens, size_t& index, ScriptContext& context, const std::string& script_path);
+        void ParseWhileStatement(const std::vector<Token>& tokens, size_t& index, ScriptContext& context, const std::string& script_path);
+        void ParseForStatement(const std::vector<Token>& tokens, size_t& index, ScriptContext& context, const std::string& script_path, bool parallel);
+        void RunParallelFor(const std::vector<Token>& tokens, size_t body_index, const std::string& var_name,
+            const std::vector<EntityList::Player*>& players, ScriptContext& context, const std::string& script_path);
+        void ParseImportStatement(const std::vector<Token>& tokens, size_t& index, ScriptContext& context, const std::string& script_path);
+        void ParseFunctionDefinition(const std::vector<Token>& tokens, size_t& index, ScriptContext& context, const std::string& script_path);
+        void ParseReturnStatement(const std::vector<Token>& tokens, size_t& index, ScriptContext& context, const std::string& script_path);
+        void ParseBlock(const std::vector<Token>& tokens, size_t& index, ScriptContext& context, const std::string& script_path);
+        // Helper to skip tokens until a certain point, useful for skipping blocks in if/while
+        void SkipBlock(const std::vector<Token>& tokens, size_t& index, const std::string& script_path);
+
+
+        // Error reporting
+        void SyntaxError(const std::string& message, const std::string& script_path, size_t line_number = 0) {
+            std::cerr << "Syntax Error in '" << script_path << "'";
+            if (line_number > 0) {
+                std::cerr << " (Line " << line_number << ")";
+            }
+            std::cerr << ": " << message << std::endl;
+            throw std::runtime_error("Syntax error occurred."); // Stop execution
+        }
+    };
+
+    struct CompiledModule {
+        std::string path;
+        std::vector<Interpreter::Token> tokens;
+    };
+
+    // A loaded script. Stays alive after its top level finishes while it still has event handlers.
+    struct ScriptInstance {
+        Interpreter interpreter;
+        ScriptContext context;
+        std::string name; // File name, for logs
+        // Set while on_player, on_tick or a timer runs the script, so they never share the context at once.
+        // Not a mutex: a coroutine may yield while it holds it, and the game thread must never block on it.
+        std::atomic<bool> busy{ false };
+
+        bool TryEnter() {
+            bool expected = false;
+            return busy.compare_exchange_strong(expected, true, std::memory_order_acquire);
+        }
+        void Leave() { busy.store(false, std::memory_order_release); }
+
+        ScriptInstance(const std::string& script_path, size_t memory_limit)
+            : context(script_path, memory_limit), name(std::filesystem::path(script_path).filename().string()) {}
+    };
+
+
+    namespace Plugins {
+        // Initializes the scripting system, loads and executes all .beg scripts.
+        void Init();
+
+        // Registers all EntityList related functions to a given script context
+        void RegisterEntityListAPI(ScriptContext& context);
+
+        // Registers wait(ms), yield(), wait_ticks(n) and Scheduler_Dump()
+        void RegisterSchedulerAPI(ScriptContext& context);
+
+        // Registers the channel_*, share_* and Channels_Dump() functions scripts use to talk to each other
+        void RegisterChannelAPI(ScriptContext& context);
+
+        // Registers spawn(), await() and future_ready()
+        void RegisterJobAPI(ScriptContext& context);
+
+        // Registers file_read(), file_write() and file_append(), which return futures for await()
+        void RegisterFileAPI(ScriptContext& context);
+
+        // Appends a line to Begeerte/Logs/Begeerte_script.log
+        void WriteScriptLog(const std::string& line);
+
+        // A simple utility function to be exposed to script
+        Value Print(ArgList& args);
+        Value LogToFile(ArgList& args); // Example: LogToFile("message")
+
+    } // namespace Plugins
 } // namespace BegeerteScript
\ No newline at end of file
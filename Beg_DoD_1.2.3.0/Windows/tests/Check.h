@@ -0,0 +1,60 @@
+#pragma once
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <chrono>
+#include <thread>
+
+// The tests in this folder are plain executables that ctest runs: no framework, a failed CHECK prints where
+// it failed and makes the executable exit with 1.
+#define CHECK(condition) \
+    do { if (!(condition)) BegeerteTest::Fail(__FILE__, __LINE__, #condition); } while (0)
+
+#define CHECK_EQ(actual, expected) \
+    do { \
+        auto check_actual_ = (actual); \
+        auto check_expected_ = (expected); \
+        if (!(check_actual_ == check_expected_)) { \
+            std::ostringstream check_what_; \
+            check_what_ << #actual << " == " << #expected << " (" << check_actual_ << " vs " << check_expected_ << ")"; \
+            BegeerteTest::Fail(__FILE__, __LINE__, check_what_.str()); \
+        } \
+    } while (0)
+
+namespace BegeerteTest {
+    inline int& Failures() {
+        static int failures = 0;
+        return failures;
+    }
+
+    inline void Fail(const char* file, int line, const std::string& what) {
+        std::cerr << file << "(" << line << "): CHECK failed: " << what << std::endl;
+        Failures()++;
+    }
+
+    inline void Run(const char* name, void (*test)()) {
+        int before = Failures();
+        test();
+        std::cout << (Failures() == before ? "[ ok ] " : "[FAIL] ") << name << std::endl;
+    }
+
+    inline int Finish() {
+        if (Failures() != 0) {
+            std::cerr << Failures() << " check(s) failed" << std::endl;
+        }
+        return Failures() == 0 ? 0 : 1;
+    }
+
+    // Polls 'done' until it holds or 'timeout' passes, for results other threads produce
+    template<typename Predicate>
+    bool WaitFor(Predicate done, std::chrono::milliseconds timeout = std::chrono::seconds(5)) {
+        auto give_up = std::chrono::steady_clock::now() + timeout;
+        while (!done()) {
+            if (std::chrono::steady_clock::now() > give_up) {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+}
\ No newline at end of file
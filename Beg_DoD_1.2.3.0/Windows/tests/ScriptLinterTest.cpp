@@ -0,0 +1,61 @@
+// The script linter as BegLint and the script loader run it: a script is tokenized and linted, and the rules
+// it reports are compared with what it should report.
+#include "Check.h"
+#include "ScriptLexer.h"
+#include "ScriptLinter.h"
+#include <string>
+#include <vector>
+
+namespace {
+    // Rules reported for 'script', joined in line order
+    std::string Rules(const std::string& script) {
+        std::string rules;
+        for (const auto& finding : BegeerteScript::Linter::Lint(BegeerteScript::Lexer::Tokenize(script, "test.beg"))) {
+            rules += (rules.empty() ? "" : ",") + finding.rule;
+        }
+        return rules;
+    }
+
+    void LoopWithoutPauseIsBusy() {
+        CHECK_EQ(Rules("while (true) {\n    let x = 1\n}\n"), std::string("busy-loop"));
+        CHECK_EQ(Rules("while (true) {\n    wait(100)\n}\n"), std::string(""));
+        CHECK_EQ(Rules("while (true) {\n    wait_ticks(1)\n}\n"), std::string(""));
+    }
+
+    // The consumer loop from the channel documentation
+    void ChannelRecvWithTimeoutPauses() {
+        CHECK_EQ(Rules(
+            "channel_open(\"hits\", \"player\")\n"
+            "while (true) {\n"
+            "    let player = channel_recv(\"hits\", 1000)\n"
+            "    if (player) {\n"
+            "        print(\"hit\", Player_GetCharacter(player))\n"
+            "    }\n"
+            "}\n"), std::string(""));
+        CHECK_EQ(Rules("while (true) {\n    let v = channel_recv(\"hits\", Timeout(2))\n}\n"), std::string(""));
+    }
+
+    // Without a timeout, or with 0, channel_recv returns at once
+    void ChannelRecvWithoutTimeoutDoesNotPause() {
+        CHECK_EQ(Rules("while (true) {\n    let v = channel_recv(\"hits\")\n}\n"), std::string("busy-loop"));
+        CHECK_EQ(Rules("while (true) {\n    let v = channel_recv(\"hits\", 0)\n}\n"), std::string("busy-loop"));
+    }
+
+    // A future that is not ready yet suspends the script until it is, or until the timeout
+    void AwaitPauses() {
+        CHECK_EQ(Rules(
+            "while (true) {\n"
+            "    let saved = await(file_append(\"log.txt\", \"tick\\n\"))\n"
+            "}\n"), std::string(""));
+        CHECK_EQ(Rules("while (true) {\n    let total = await(spawn(\"report\", 8), 500)\n}\n"), std::string(""));
+        CHECK_EQ(Rules("while (true) {\n    let total = await(job, 0)\n}\n"), std::string("busy-loop"));
+    }
+}
+
+int main() {
+    BegeerteTest::Run("A loop without a pause is busy", LoopWithoutPauseIsBusy);
+    BegeerteTest::Run("channel_recv with a timeout pauses", ChannelRecvWithTimeoutPauses);
+    BegeerteTest::Run("channel_recv without a timeout does not pause", ChannelRecvWithoutTimeoutDoesNotPause);
+    BegeerteTest::Run("await pauses", AwaitPauses);
+    return BegeerteTest::Finish();
+}
\ No newline at end of file
@@ -0,0 +1,313 @@
+// ScriptScheduler on the ucontext path: spawning, sleeping, Wake, Park and the order ready coroutines run in.
+// Every test uses its own scheduler, so Shared() and its Begeerte.ini are never involved.
+#include "Check.h"
+#include "ScriptScheduler.h"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using BegeerteScript::ScriptScheduler;
+using namespace std::chrono_literals;
+
+namespace {
+    // Order in which coroutines reached a point, filled from the scheduler's threads
+    struct Trace {
+        std::mutex mutex;
+        std::vector<std::string> order;
+
+        void Add(const std::string& name) {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(name);
+        }
+        size_t Size() {
+            std::lock_guard<std::mutex> lock(mutex);
+            return order.size();
+        }
+        std::string Joined() {
+            std::lock_guard<std::mutex> lock(mutex);
+            std::string joined;
+            for (const auto& name : order) {
+                joined += (joined.empty() ? "" : ",") + name;
+            }
+            return joined;
+        }
+    };
+
+    ScriptScheduler::State StateOf(ScriptScheduler& scheduler, uint64_t id) {
+        for (const auto& info : scheduler.Snapshot().coroutines) {
+            if (info.id == id) {
+                return info.state;
+            }
+        }
+        return ScriptScheduler::State::Finished;
+    }
+
+    void SpawnRunsEveryCoroutine() {
+        ScriptScheduler scheduler(4, 50ms, 64 * 1024);
+        std::atomic<int> finished{ 0 };
+        std::atomic<int> inside{ 0 };
+        for (int i = 0; i < 100; ++i) {
+            scheduler.Spawn("spawn" + std::to_string(i), [&] {
+                if (ScriptScheduler::InCoroutine() && ScriptScheduler::CurrentId() != 0) {
+                    inside++;
+                }
+                for (int step = 0; step < 3; ++step) {
+                    ScriptScheduler::Yield();
+                }
+                finished++;
+                });
+        }
+        CHECK(BegeerteTest::WaitFor([&] { return finished == 100; }));
+        CHECK_EQ(inside.load(), 100);
+        CHECK(BegeerteTest::WaitFor([&] { return scheduler.Snapshot().coroutines.empty(); }));
+        CHECK(!ScriptScheduler::InCoroutine());
+        CHECK_EQ(ScriptScheduler::CurrentId(), 0u);
+    }
+
+    void SpawnSpreadsOverWorkers() {
+        ScriptScheduler scheduler(2, 50ms, 64 * 1024);
+        for (int i = 0; i < 6; ++i) {
+            scheduler.Spawn("sleeper", [] { ScriptScheduler::Sleep(10s); });
+        }
+        CHECK(BegeerteTest::WaitFor([&] { return scheduler.Snapshot().sleeping_per_worker == std::vector<size_t>{ 3, 3 }; }));
+    }
+
+    void SleepWakesInWakeTimeOrder() {
+        ScriptScheduler scheduler(1, 50ms, 64 * 1024);
+        Trace trace;
+        auto start = ScriptScheduler::Clock::now();
+        std::atomic<long long> slept_ms{ 0 };
+        scheduler.Spawn("long", [&] {
+            ScriptScheduler::Sleep(60ms);
+            slept_ms = std::chrono::duration_cast<std::chrono::milliseconds>(ScriptScheduler::Clock::now() - start).count();
+            trace.Add("long");
+            });
+        scheduler.Spawn("short", [&] {
+            ScriptScheduler::Sleep(20ms);
+            trace.Add("short");
+            });
+        scheduler.Spawn("until", [&] {
+            ScriptScheduler::SleepUntil(start + 40ms);
+            trace.Add("until");
+            });
+        CHECK(BegeerteTest::WaitFor([&] { return trace.Size() == 3; }));
+        CHECK_EQ(trace.Joined(), std::string("short,until,long"));
+        CHECK(slept_ms >= 60);
+    }
+
+    void SleepTicksWakesOnTheTickBoundary() {
+        ScriptScheduler scheduler(1, 20ms, 64 * 1024);
+        std::atomic<uint64_t> woke_tick{ 0 };
+        uint64_t target = 0;
+        std::atomic<bool> asleep{ false };
+        scheduler.Spawn("ticks", [&] {
+            target = scheduler.CurrentTick() + 2;
+            asleep = true;
+            ScriptScheduler::SleepTicks(2);
+            woke_tick = scheduler.CurrentTick();
+            });
+        CHECK(BegeerteTest::WaitFor([&] { return woke_tick != 0; }));
+        CHECK(asleep);
+        CHECK_EQ(woke_tick.load(), target);
+    }
+
+    void WakeEndsSleepUntilWoken() {
+        ScriptScheduler scheduler(1, 50ms, 64 * 1024);
+        std::atomic<bool> done{ false };
+        auto start = ScriptScheduler::Clock::now();
+        uint64_t id = scheduler.Spawn("woken", [&] {
+            ScriptScheduler::SleepUntilWoken(ScriptScheduler::Now() + 10s);
+            done = true;
+            });
+        CHECK(BegeerteTest::WaitFor([&] { return StateOf(scheduler, id) == ScriptScheduler::State::Sleeping; }));
+        CHECK(!done);
+        CHECK(scheduler.Wake(id));
+        CHECK(BegeerteTest::WaitFor([&] { return done.load(); }));
+        CHECK(ScriptScheduler::Clock::now() - start < 5s);
+        CHECK(BegeerteTest::WaitFor([&] { return StateOf(scheduler, id) == ScriptScheduler::State::Finished; }));
+        CHECK(!scheduler.Wake(id)); // Gone
+    }
+
+    void WakeBeforeSleepIsNotLost() {
+        ScriptScheduler scheduler(1, 50ms, 64 * 1024);
+        std::atomic<bool> done{ false };
+        scheduler.Spawn("early", [&] {
+            scheduler.Wake(ScriptScheduler::CurrentId()); // Arrives while still running
+            ScriptScheduler::SleepUntilWoken(ScriptScheduler::Now() + 10s);
+            done = true;
+            });
+        CHECK(BegeerteTest::WaitFor([&] { return done.load(); }, 2s));
+    }
+
+    void PlainSleepIgnoresWake() {
+        ScriptScheduler scheduler(1, 50ms, 64 * 1024);
+        std::atomic<bool> done{ false };
+        uint64_t id = scheduler.Spawn("plain", [&] {
+            ScriptScheduler::Sleep(150ms);
+            done = true;
+            });
+        CHECK(BegeerteTest::WaitFor([&] { return StateOf(scheduler, id) == ScriptScheduler::State::Sleeping; }));
+        CHECK(scheduler.Wake(id));
+        std::this_thread::sleep_for(50ms);
+        CHECK(!done);
+        CHECK(BegeerteTest::WaitFor([&] { return done.load(); }));
+    }
+
+    void ParkHoldsEveryCoroutine() {
+        ScriptScheduler scheduler(2, 50ms, 64 * 1024);
+        std::atomic<int> ran{ 0 };
+        std::atomic<int> woke{ 0 };
+        scheduler.Spawn("due while parked", [&] {
+            ScriptScheduler::Sleep(20ms);
+            woke++;
+            });
+        CHECK(BegeerteTest::WaitFor([&] { return scheduler.Snapshot().sleeping_per_worker[0] + scheduler.Snapshot().sleeping_per_worker[1] == 1; }));
+
+        scheduler.Park(ScriptScheduler::ParkReason::Idle, true);
+        CHECK(scheduler.Parked());
+        for (int i = 0; i < 4; ++i) {
+            scheduler.Spawn("parked", [&] { ran++; });
+        }
+        std::this_thread::sleep_for(80ms);
+        CHECK_EQ(ran.load(), 0);
+        CHECK_EQ(woke.load(), 0);
+
+        scheduler.Park(ScriptScheduler::ParkReason::Idle, false);
+        CHECK(BegeerteTest::WaitFor([&] { return ran == 4 && woke == 1; }));
+    }
+
+    // Idle mode, the startup barrier and the virtual time limit park independently: clearing one reason
+    // leaves the scheduler parked while another is still set
+    void ParkReasonsAreIndependent() {
+        ScriptScheduler scheduler(1, 50ms, 64 * 1024);
+        std::atomic<int> ran{ 0 };
+        scheduler.Park(ScriptScheduler::ParkReason::VirtualTimeLimit, true);
+        scheduler.Park(ScriptScheduler::ParkReason::Idle, true);
+        scheduler.Spawn("parked", [&] { ran++; });
+        scheduler.Park(ScriptScheduler::ParkReason::Idle, false);
+        CHECK(scheduler.Parked());
+        std::this_thread::sleep_for(50ms);
+        CHECK_EQ(ran.load(), 0);
+
+        scheduler.Park(ScriptScheduler::ParkReason::VirtualTimeLimit, false);
+        CHECK(!scheduler.Parked());
+        CHECK(BegeerteTest::WaitFor([&] { return ran == 1; }));
+    }
+
+    // One worker and no class budgets, so the order is decided by class and deadline alone
+    void ReadyCoroutinesRunEarliestDeadlineFirst() {
+        ScriptScheduler scheduler(1, 50ms, 64 * 1024);
+        std::fill(std::begin(scheduler.budget_percent), std::end(scheduler.budget_percent), 0);
+        Trace trace;
+        std::atomic<int> asleep{ 0 };
+        // All wake at the same moment, so each one's deadline is that moment plus its own deadline
+        auto wake_time = ScriptScheduler::Clock::now() + 100ms;
+        struct Case { const char* name; long long deadline_ms; };
+        for (Case entry : { Case{ "d40", 40 }, Case{ "d10", 10 }, Case{ "d30", 30 }, Case{ "d20", 20 }, Case{ "d15", 15 } }) {
+            scheduler.Spawn(entry.name, [&, entry] {
+                ScriptScheduler::SetPriority(ScriptScheduler::Priority::Normal, std::chrono::milliseconds(entry.deadline_ms));
+                asleep++;
+                ScriptScheduler::SleepUntil(wake_time);
+                trace.Add(entry.name);
+                });
+        }
+        CHECK(BegeerteTest::WaitFor([&] { return trace.Size() == 5; }));
+        CHECK_EQ(asleep.load(), 5);
+        CHECK_EQ(trace.Joined(), std::string("d10,d15,d20,d30,d40"));
+    }
+
+    void HigherClassesRunFirst() {
+        ScriptScheduler scheduler(1, 50ms, 64 * 1024);
+        std::fill(std::begin(scheduler.budget_percent), std::end(scheduler.budget_percent), 0);
+        Trace trace;
+        auto wake_time = ScriptScheduler::Clock::now() + 100ms;
+        struct Case { const char* name; ScriptScheduler::Priority priority; long long deadline_ms; };
+        for (Case entry : { Case{ "batch", ScriptScheduler::Priority::Batch, 1 },
+            Case{ "normal", ScriptScheduler::Priority::Normal, 1 },
+            Case{ "critical", ScriptScheduler::Priority::Critical, 1000 } }) {
+            scheduler.Spawn(entry.name, [&, entry] {
+                ScriptScheduler::SetPriority(entry.priority, std::chrono::milliseconds(entry.deadline_ms));
+                ScriptScheduler::SleepUntil(wake_time);
+                trace.Add(entry.name);
+                });
+        }
+        CHECK(BegeerteTest::WaitFor([&] { return trace.Size() == 3; }));
+        CHECK_EQ(trace.Joined(), std::string("critical,normal,batch"));
+    }
+
+    // With 1 ms ticks the shares are fractions of a millisecond; they must not round down to nothing, which
+    // would leave the capped classes over budget and put the uncapped batch class ahead of them
+    void ShortTicksKeepClassOrder() {
+        ScriptScheduler scheduler(1, 1ms, 64 * 1024);
+        Trace trace;
+        auto wake_time = ScriptScheduler::Clock::now() + 100ms;
+        struct Case { const char* name; ScriptScheduler::Priority priority; };
+        for (Case entry : { Case{ "batch", ScriptScheduler::Priority::Batch },
+            Case{ "normal", ScriptScheduler::Priority::Normal },
+            Case{ "critical", ScriptScheduler::Priority::Critical } }) {
+            scheduler.Spawn(entry.name, [&, entry] {
+                ScriptScheduler::SetPriority(entry.priority, 1000ms);
+                ScriptScheduler::SleepUntil(wake_time);
+                trace.Add(entry.name);
+                });
+        }
+        CHECK(BegeerteTest::WaitFor([&] { return trace.Size() == 3; }));
+        CHECK_EQ(trace.Joined(), std::string("critical,normal,batch"));
+    }
+
+    // A class past its share of the tick yields to lower classes that are still within theirs
+    void OverBudgetClassYieldsToOthers() {
+        ScriptScheduler scheduler(1, 1000ms, 64 * 1024);
+        scheduler.budget_percent[0] = 1; // 10 ms of critical time per tick
+        scheduler.budget_percent[1] = 0;
+        Trace trace;
+        auto wake_time = ScriptScheduler::Clock::now() + 100ms;
+        scheduler.Spawn("critical", [&] {
+            ScriptScheduler::SetPriority(ScriptScheduler::Priority::Critical, 0ms);
+            ScriptScheduler::SleepUntil(wake_time);
+            auto busy_until = ScriptScheduler::Clock::now() + 20ms; // Uses up the share in one go
+            while (ScriptScheduler::Clock::now() < busy_until) {
+            }
+            ScriptScheduler::Yield();
+            trace.Add("critical");
+            });
+        scheduler.Spawn("normal", [&] {
+            ScriptScheduler::SleepUntil(wake_time);
+            trace.Add("normal");
+            });
+        CHECK(BegeerteTest::WaitFor([&] { return trace.Size() == 2; }));
+        CHECK_EQ(trace.Joined(), std::string("normal,critical"));
+    }
+
+    void FinishedCoroutinesAreReleased() {
+        ScriptScheduler scheduler(1, 50ms, 64 * 1024);
+        std::atomic<int> done{ 0 };
+        scheduler.Spawn("throws", [&] {
+            done++;
+            throw std::runtime_error("expected by the test");
+            });
+        scheduler.Spawn("returns", [&] { done++; });
+        CHECK(BegeerteTest::WaitFor([&] { return done == 2 && scheduler.Snapshot().coroutines.empty(); }));
+    }
+}
+
+int main() {
+    BegeerteTest::Run("Spawn runs every coroutine", SpawnRunsEveryCoroutine);
+    BegeerteTest::Run("Spawn spreads coroutines over workers", SpawnSpreadsOverWorkers);
+    BegeerteTest::Run("Sleep wakes in wake time order", SleepWakesInWakeTimeOrder);
+    BegeerteTest::Run("SleepTicks wakes on the tick boundary", SleepTicksWakesOnTheTickBoundary);
+    BegeerteTest::Run("Wake ends SleepUntilWoken", WakeEndsSleepUntilWoken);
+    BegeerteTest::Run("Wake before the sleep is not lost", WakeBeforeSleepIsNotLost);
+    BegeerteTest::Run("Plain Sleep ignores Wake", PlainSleepIgnoresWake);
+    BegeerteTest::Run("Park holds every coroutine", ParkHoldsEveryCoroutine);
+    BegeerteTest::Run("Park reasons are independent", ParkReasonsAreIndependent);
+    BegeerteTest::Run("Ready coroutines run earliest deadline first", ReadyCoroutinesRunEarliestDeadlineFirst);
+    BegeerteTest::Run("Higher classes run first", HigherClassesRunFirst);
+    BegeerteTest::Run("Short ticks keep the class order", ShortTicksKeepClassOrder);
+    BegeerteTest::Run("Over-budget class yields to others", OverBudgetClassYieldsToOthers);
+    BegeerteTest::Run("Finished coroutines are released", FinishedCoroutinesAreReleased);
+    return BegeerteTest::Finish();
+}
\ No newline at end of file
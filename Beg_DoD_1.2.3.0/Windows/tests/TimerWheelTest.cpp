@@ -0,0 +1,392 @@
+// TimerWheel against a brute-force reference: a plain list of timers that is scanned for the earliest
+// deadline. Both are driven with the same explicit times. Every timer the wheel fires is checked against
+// the reference while it fires, so schedules and cancels made from 'fire' reach both in the same order.
+#include "Check.h"
+#include "TimerWheel.h"
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using BegeerteScript::TimerWheel;
+
+namespace {
+    class Reference {
+    public:
+        struct Timer {
+            TimerWheel::TimerId id;
+            uint64_t deadline;
+            uint64_t period;
+            uint64_t payload;
+        };
+
+        explicit Reference(uint64_t now) : now(now) {}
+
+        // Same clamping as TimerWheel::Schedule
+        void Schedule(TimerWheel::TimerId id, uint64_t deadline, uint64_t period, uint64_t payload) {
+            deadline = std::max(deadline, now);
+            if (firing && deadline == now) {
+                deadline = now + 1;
+            }
+            timers.push_back({ id, deadline, period, payload });
+        }
+
+        bool Cancel(TimerWheel::TimerId id) {
+            auto timer = Find(id);
+            if (timer != timers.end()) {
+                timers.erase(timer);
+                return true;
+            }
+            if (id == firing_id && !firing_cancelled) {
+                firing_cancelled = true;
+                return true;
+            }
+            return false;
+        }
+
+        uint64_t Next() const {
+            uint64_t next = TimerWheel::Never;
+            for (const auto& timer : timers) {
+                next = std::min(next, timer.deadline);
+            }
+            return next;
+        }
+
+        // The wheel fires 'id' at 'time' while advancing to 'target'. False if the reference disagrees.
+        bool BeginFire(TimerWheel::TimerId id, uint64_t time, uint64_t payload) {
+            auto timer = Find(id);
+            if (timer == timers.end() || timer->deadline != time || Next() != time || timer->payload != payload) {
+                return false;
+            }
+            now = time;
+            current = *timer;
+            timers.erase(timer);
+            firing = true;
+            firing_id = id;
+            firing_cancelled = false;
+            return true;
+        }
+
+        void EndFire(uint64_t target) {
+            firing = false;
+            firing_id = 0;
+            if (firing_cancelled || current.period == 0) {
+                return;
+            }
+            current.deadline += current.period;
+            if (current.deadline <= target) {
+                current.deadline += ((target - current.deadline) / current.period + 1) * current.period;
+            }
+            timers.push_back(current);
+        }
+
+        void Finish(uint64_t target) {
+            now = std::max(now, target);
+        }
+
+        uint64_t Now() const { return now; }
+        size_t Size() const { return timers.size(); }
+        const std::vector<Timer>& Timers() const { return timers; }
+
+    private:
+        std::vector<Timer>::iterator Find(TimerWheel::TimerId id) {
+            return std::find_if(timers.begin(), timers.end(), [id](const Timer& timer) { return timer.id == id; });
+        }
+
+        uint64_t now;
+        std::vector<Timer> timers;
+        bool firing = false;
+        TimerWheel::TimerId firing_id = 0;
+        bool firing_cancelled = false;
+        Timer current{};
+    };
+
+    // A wheel and its reference, checked against each other after every step
+    struct Pair {
+        TimerWheel wheel;
+        Reference reference;
+        std::vector<std::pair<uint64_t, TimerWheel::TimerId>> fired; // (time, id) of every fire, in order
+
+        explicit Pair(uint64_t now = 0) : wheel(now), reference(now) {}
+
+        TimerWheel::TimerId Schedule(uint64_t deadline, uint64_t period = 0, uint64_t payload = 0) {
+            TimerWheel::TimerId id = wheel.Schedule(deadline, period, payload);
+            CHECK(id != 0);
+            reference.Schedule(id, deadline, period, payload);
+            return id;
+        }
+
+        bool Cancel(TimerWheel::TimerId id) {
+            bool cancelled = wheel.Cancel(id);
+            CHECK_EQ(cancelled, reference.Cancel(id));
+            return cancelled;
+        }
+
+        // 'during' runs inside every fire, after the reference has accepted it
+        template<typename During>
+        size_t Advance(uint64_t now, During during) {
+            size_t expected = 0;
+            size_t count = wheel.Advance(now, [&](TimerWheel::TimerId id, uint64_t payload) {
+                if (!reference.BeginFire(id, wheel.Now(), payload)) {
+                    BegeerteTest::Fail(__FILE__, __LINE__, "fired a timer the reference does not have due at " + std::to_string(wheel.Now()));
+                    return;
+                }
+                expected++;
+                fired.emplace_back(wheel.Now(), id);
+                during(id, payload);
+                reference.EndFire(now);
+                });
+            reference.Finish(now);
+            CHECK_EQ(count, expected);
+            CHECK(reference.Next() > now); // Nothing due is left behind
+            Verify();
+            return count;
+        }
+
+        size_t Advance(uint64_t now) {
+            return Advance(now, [](TimerWheel::TimerId, uint64_t) {});
+        }
+
+        void Verify() {
+            CHECK_EQ(wheel.Now(), reference.Now());
+            CHECK_EQ(wheel.Size(), reference.Size());
+            CHECK_EQ(wheel.Empty(), reference.Size() == 0);
+            uint64_t next = wheel.NextDeadline();
+            uint64_t expected = reference.Next();
+            CHECK_EQ(next == TimerWheel::Never, expected == TimerWheel::Never);
+            // The wheel may stop early to move timers down a level, never late
+            CHECK(next <= expected);
+            CHECK(next >= wheel.Now());
+        }
+
+        // Walks to 'target' through NextDeadline, the way a caller sleeping between wakeups would
+        size_t AdvanceByDeadlines(uint64_t target) {
+            size_t count = 0;
+            while (wheel.Now() < target) {
+                uint64_t next = std::min(wheel.NextDeadline(), target);
+                count += Advance(std::max(next, wheel.Now() + 1));
+            }
+            return count;
+        }
+    };
+
+    uint64_t FiredAt(const Pair& pair, TimerWheel::TimerId id) {
+        for (const auto& [time, fired] : pair.fired) {
+            if (fired == id) {
+                return time;
+            }
+        }
+        return TimerWheel::Never;
+    }
+
+    // Each deadline sits just before, on or just after a boundary between levels (64, 4096, 2^18 and 2^24,
+    // past which timers go to the overflow list), scheduled from times on either side of those boundaries.
+    void CascadesAtLevelBoundaries() {
+        const uint64_t boundaries[] = { 64, 4096, 1ULL << 18, 1ULL << 24, 1ULL << 30 };
+        const uint64_t starts[] = { 0, 1, 63, 4095, (1ULL << 24) - 1, (1ULL << 24) + 5 };
+        for (uint64_t start : starts) {
+            for (uint64_t boundary : boundaries) {
+                for (uint64_t base : { boundary, start + boundary }) {
+                    Pair pair(start);
+                    std::vector<std::pair<TimerWheel::TimerId, uint64_t>> timers;
+                    for (int delta = -2; delta <= 2; ++delta) {
+                        uint64_t deadline = base + delta;
+                        timers.emplace_back(pair.Schedule(deadline, 0, deadline), std::max(deadline, start));
+                    }
+                    pair.Verify();
+                    // Single steps across each deadline, then one jump to the end
+                    for (const auto& [id, deadline] : timers) {
+                        if (deadline > pair.wheel.Now()) {
+                            pair.Advance(deadline - 1);
+                            CHECK_EQ(FiredAt(pair, id), TimerWheel::Never);
+                        }
+                        pair.Advance(std::max(deadline, pair.wheel.Now()));
+                        CHECK_EQ(FiredAt(pair, id), deadline);
+                    }
+                    CHECK(pair.wheel.Empty());
+                }
+            }
+        }
+    }
+
+    void OneJumpFiresInDeadlineOrder() {
+        const uint64_t deadlines[] = { (1ULL << 24) + 3, 64, 4096, 4095, 63, (1ULL << 24) - 1, 65, 1ULL << 24, 4097, 1ULL << 31 };
+        Pair pair(0);
+        for (uint64_t deadline : deadlines) {
+            pair.Schedule(deadline, 0, deadline);
+        }
+        CHECK_EQ(pair.Advance(1ULL << 32), sizeof(deadlines) / sizeof(deadlines[0]));
+        CHECK(std::is_sorted(pair.fired.begin(), pair.fired.end()));
+    }
+
+    void NextDeadlineDrivesTheWheel() {
+        Pair pair(100);
+        TimerWheel::TimerId far = pair.Schedule((1ULL << 24) + 12345);
+        TimerWheel::TimerId near = pair.Schedule(4200);
+        TimerWheel::TimerId overflow = pair.Schedule((1ULL << 32) + 7);
+        pair.AdvanceByDeadlines((1ULL << 33));
+        CHECK_EQ(FiredAt(pair, near), 4200u);
+        CHECK_EQ(FiredAt(pair, far), (1ULL << 24) + 12345);
+        CHECK_EQ(FiredAt(pair, overflow), (1ULL << 32) + 7);
+        CHECK_EQ(pair.wheel.NextDeadline(), TimerWheel::Never);
+    }
+
+    void CancelFromInsideFire() {
+        Pair pair(0);
+        TimerWheel::TimerId self = pair.Schedule(10, 5, 1);
+        TimerWheel::TimerId canceller = pair.Schedule(20, 0, 2);
+        TimerWheel::TimerId victims[] = { pair.Schedule(20, 0, 3), pair.Schedule(20, 0, 4), pair.Schedule(30, 0, 5) };
+        bool self_fired = false;
+        pair.Advance(100, [&](TimerWheel::TimerId id, uint64_t payload) {
+            if (payload == 1) {
+                CHECK(!self_fired); // Cancelled on its first run, so it never comes back
+                self_fired = true;
+                CHECK(pair.Cancel(self));
+                CHECK(!pair.Cancel(self));
+            }
+            else if (payload == 2) {
+                CHECK(pair.Cancel(canceller)); // Still firing, so even a one-shot timer can cancel itself
+                for (TimerWheel::TimerId victim : victims) {
+                    pair.Cancel(victim); // Whether a same-time victim already fired depends on order; the reference follows the wheel
+                }
+            }
+            });
+        CHECK(self_fired);
+        CHECK_EQ(FiredAt(pair, victims[2]), TimerWheel::Never);
+        CHECK(pair.wheel.Empty());
+    }
+
+    void ScheduleFromInsideFireWaitsForTheNextMillisecond() {
+        Pair pair(0);
+        pair.Schedule(50, 0, 1);
+        std::vector<TimerWheel::TimerId> added;
+        pair.Advance(50, [&](TimerWheel::TimerId, uint64_t payload) {
+            if (payload == 1) {
+                added.push_back(pair.Schedule(50, 0, 2)); // Due now: moved to 51
+                added.push_back(pair.Schedule(10, 0, 3)); // In the past: also 51
+                added.push_back(pair.Schedule(4096 + 50, 0, 4));
+            }
+            });
+        CHECK_EQ(pair.fired.size(), 1u);
+        pair.Advance(51);
+        CHECK_EQ(FiredAt(pair, added[0]), 51u);
+        CHECK_EQ(FiredAt(pair, added[1]), 51u);
+        pair.Advance(10000);
+        CHECK_EQ(FiredAt(pair, added[2]), 4146u);
+    }
+
+    void PeriodicTimerCatchesUp() {
+        Pair pair(0);
+        TimerWheel::TimerId id = pair.Schedule(10, 10);
+        CHECK_EQ(pair.Advance(55), 1u); // Missed 20, 30, 40 and 50: fires once and skips them
+        CHECK(pair.wheel.NextDeadline() <= 60);
+        CHECK_EQ(pair.Advance(59), 0u);
+        CHECK_EQ(pair.Advance(60), 1u);
+        CHECK_EQ(pair.fired.back().first, 60u);
+        CHECK(pair.fired.back().second == id);
+        // Across a level boundary: a long stall, then exactly one fire per period again
+        CHECK_EQ(pair.Advance((1ULL << 24) + 3), 1u);
+        CHECK_EQ(pair.AdvanceByDeadlines((1ULL << 24) + 53), 5u);
+        CHECK(pair.Cancel(id));
+    }
+
+    void IdsAreNotReusedAcrossGenerations() {
+        TimerWheel wheel(0);
+        TimerWheel::TimerId first = wheel.Schedule(10);
+        CHECK(wheel.Cancel(first));
+        TimerWheel::TimerId second = wheel.Schedule(20); // Takes the freed node
+        CHECK(second != first);
+        CHECK_EQ(second & 0xFFFFFFFF, first & 0xFFFFFFFF);
+        CHECK(!wheel.Cancel(first)); // The stale id must not cancel its successor
+        CHECK_EQ(wheel.Size(), 1u);
+
+        size_t fired = wheel.Advance(20, [](TimerWheel::TimerId, uint64_t) {});
+        CHECK_EQ(fired, 1u);
+        CHECK(!wheel.Cancel(second)); // Already fired
+
+        TimerWheel::TimerId third = wheel.Schedule(30);
+        CHECK(third != first && third != second);
+        CHECK(!wheel.Cancel(second));
+        CHECK(wheel.Cancel(third));
+        CHECK(!wheel.Cancel(0));
+        CHECK(!wheel.Cancel(12345));
+    }
+
+    // Random schedules, cancels and steps, with fires that schedule and cancel as well
+    void MatchesReferenceUnderRandomLoad() {
+        for (uint32_t seed = 1; seed <= 40; ++seed) {
+            std::mt19937_64 random(seed);
+            auto below = [&](uint64_t bound) { return bound == 0 ? 0 : random() % bound; };
+            // Offsets that land on and around the level boundaries most of the time
+            auto offset = [&]() -> uint64_t {
+                static const uint64_t scales[] = { 64, 4096, 1ULL << 18, 1ULL << 24, 1ULL << 26 };
+                uint64_t scale = scales[below(5)];
+                switch (below(3)) {
+                case 0: return below(scale * 2);
+                case 1: return scale - 2 + below(5);
+                default: return below(70);
+                }
+            };
+
+            Pair pair(below(2) ? 0 : (1ULL << 24) - below(100));
+            std::vector<TimerWheel::TimerId> ids;
+            for (int step = 0; step < 300; ++step) {
+                switch (below(4)) {
+                case 0:
+                case 1:
+                    ids.push_back(pair.Schedule(pair.wheel.Now() + offset(), below(4) == 0 ? 1 + below(300) : 0, step));
+                    break;
+                case 2:
+                    if (!ids.empty()) {
+                        pair.Cancel(ids[below(ids.size())]);
+                    }
+                    break;
+                default: {
+                    uint64_t target = pair.wheel.Now() + (below(4) == 0 ? offset() : below(200));
+                    pair.Advance(target, [&](TimerWheel::TimerId id, uint64_t payload) {
+                        switch ((payload + id) % 5) {
+                        case 0:
+                            ids.push_back(pair.Schedule(pair.wheel.Now() + below(3) * offset(), 0, payload + 1));
+                            break;
+                        case 1:
+                            pair.Cancel(id);
+                            break;
+                        case 2:
+                            if (!ids.empty()) {
+                                pair.Cancel(ids[below(ids.size())]);
+                            }
+                            break;
+                        default:
+                            break;
+                        }
+                        });
+                    break;
+                }
+                }
+            }
+            // Drain, but periodic timers never run out
+            for (const auto& timer : std::vector<Reference::Timer>(pair.reference.Timers())) {
+                if (timer.period != 0) {
+                    pair.Cancel(timer.id);
+                }
+            }
+            pair.AdvanceByDeadlines(pair.wheel.Now() + (1ULL << 30));
+            CHECK(pair.wheel.Empty());
+            for (size_t i = 1; i < pair.fired.size(); ++i) {
+                CHECK(pair.fired[i - 1].first <= pair.fired[i].first);
+            }
+        }
+    }
+}
+
+int main() {
+    BegeerteTest::Run("Cascades at level boundaries", CascadesAtLevelBoundaries);
+    BegeerteTest::Run("One jump fires in deadline order", OneJumpFiresInDeadlineOrder);
+    BegeerteTest::Run("NextDeadline drives the wheel", NextDeadlineDrivesTheWheel);
+    BegeerteTest::Run("Cancel from inside fire", CancelFromInsideFire);
+    BegeerteTest::Run("Schedule from inside fire waits for the next millisecond", ScheduleFromInsideFireWaitsForTheNextMillisecond);
+    BegeerteTest::Run("Periodic timer catches up", PeriodicTimerCatchesUp);
+    BegeerteTest::Run("Ids are not reused across generations", IdsAreNotReusedAcrossGenerations);
+    BegeerteTest::Run("Matches the reference under random load", MatchesReferenceUnderRandomLoad);
+    return BegeerteTest::Finish();
+}
\ No newline at end of file
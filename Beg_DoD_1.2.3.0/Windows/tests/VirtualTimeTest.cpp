@@ -0,0 +1,175 @@
+// Replays a day of script time under [Scripts] VirtualTime=1: the scripts go through Plugins::Init as they
+// would in BegHost, and what they record about wait, set_interval, wait_ticks and on_tick must land exactly on
+// script time while the whole run takes seconds. Runs from its own build folder, whose Begeerte.ini it writes.
+#include "Check.h"
+#include "plugins.h"
+#include "Hook.h"
+#include "Platform.h"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <atomic>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+// Under VirtualTime on_tick is driven by the scheduler, so the engine tick is never installed
+namespace Hook {
+    void SetTickCallback(TickCallback) {}
+}
+
+namespace {
+    const std::filesystem::path Root = Platform::ExecutableDirectory() / "Begeerte";
+
+    void WriteFile(const std::filesystem::path& path, const std::string& text) {
+        std::filesystem::create_directories(path.parent_path());
+        std::ofstream(path, std::ios::binary | std::ios::trunc) << text;
+    }
+
+    std::string ReadFile(const std::filesystem::path& path) {
+        std::ifstream file(path, std::ios::binary);
+        std::stringstream text;
+        text << file.rdbuf();
+        return text.str();
+    }
+
+    void Prepare() {
+        std::filesystem::remove_all(Root);
+        WriteFile(Root / "Begeerte.ini",
+            "[Scripts]\n"
+            "VirtualTime=1\n"
+            "VirtualTickMs=1000\n"
+            "VirtualTimeLimitSec=90000\n"
+            "TickMs=50\n"
+            "LogFlushMs=0\n"
+            "[Idle]\n"
+            "EmptySec=0\n");
+
+        // An hour-by-hour day with a once-a-minute interval, then a few scheduler ticks
+        WriteFile(Root / "Scripts" / "day.beg",
+            "let beats = 0\n"
+            "function beat() {\n"
+            "    beats = beats + 1\n"
+            "}\n"
+            "set_interval(60000, \"beat\")\n"
+            "let hour = 0\n"
+            "while (hour < 24) {\n"
+            "    wait(3600000)\n"
+            "    hour = hour + 1\n"
+            "}\n"
+            "let day = time_ms()\n"
+            "let day_beats = beats\n"
+            "wait_ticks(20)\n"
+            "await(file_write(\"day.txt\", day + \" \" + day_beats + \" \" + time_ms() + \"\\n\"))\n");
+
+        // on_tick under virtual time: one call per VirtualTickMs of script time, dt in script time
+        WriteFile(Root / "Scripts" / "ticker.beg",
+            "let ticks = 0\n"
+            "let total = 0\n"
+            "function on_tick(dt) {\n"
+            "    ticks = ticks + 1\n"
+            "    total = total + dt\n"
+            "    if (ticks == 3600) {\n"
+            "        file_write(\"ticks.txt\", ticks + \" \" + total + \" \" + time_ms() + \"\\n\")\n"
+            "    }\n"
+            "    if (ticks == 3700) {\n"
+            "        file_write(\"later.txt\", ticks + \"\\n\")\n"
+            "    }\n"
+            "}\n");
+
+        // An on_tick that never returns once ticker.beg has recorded its hour. The tick cannot be preempted,
+        // so only the per-handler cap stops it.
+        WriteFile(Root / "Scripts" / "runaway.beg",
+            "function on_tick(dt) {\n"
+            "    if (time_ms() > 3600000) {\n"
+            "        let spins = 0\n"
+            "        while (true) {\n"
+            "            spins = spins + 1\n"
+            "        }\n"
+            "    }\n"
+            "}\n");
+    }
+
+    // Space-separated numbers a script wrote to Begeerte/Data/'name', empty until its closing newline is written
+    std::vector<double> Results(const std::string& name, size_t count) {
+        std::string written = ReadFile(Root / "Data" / name);
+        if (written.empty() || written.back() != '\n') {
+            return {};
+        }
+        std::istringstream text(written);
+        std::vector<double> values;
+        for (double value; text >> value;) {
+            values.push_back(value);
+        }
+        return values.size() == count ? values : std::vector<double>();
+    }
+
+    std::vector<double> Day;
+    std::vector<double> Ticks;
+
+    void DayOfScriptTimeReplaysInSeconds() {
+        auto started = std::chrono::steady_clock::now();
+        BegeerteScript::Plugins::Init();
+        CHECK(BegeerteTest::WaitFor([] {
+            Day = Results("day.txt", 3);
+            Ticks = Results("ticks.txt", 3);
+            return !Day.empty() && !Ticks.empty();
+            }, 60s));
+        auto took = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+        std::cout << "A day of script time took " << took << " s" << std::endl;
+    }
+
+    void WaitsAndTimersLandOnScriptTime() {
+        if (Day.empty()) {
+            return BegeerteTest::Fail(__FILE__, __LINE__, "day.beg did not finish");
+        }
+        CHECK_EQ(Day[0], 86400000.0); // 24 waits of an hour
+        CHECK_EQ(Day[1], 1440.0);     // The interval fired every minute, including at the end of the last wait
+        CHECK_EQ(Day[2], 86401000.0); // 20 ticks of 50 ms from a tick boundary
+    }
+
+    void OnTickFollowsScriptTime() {
+        if (Ticks.empty()) {
+            return BegeerteTest::Fail(__FILE__, __LINE__, "ticker.beg did not record 3600 ticks");
+        }
+        CHECK_EQ(Ticks[0], 3600.0);
+        CHECK_EQ(Ticks[1], 3600000.0); // Every dt is exactly VirtualTickMs
+        CHECK_EQ(Ticks[2], 3600000.0);
+    }
+
+    // The runaway handler is removed and the other handlers keep being called
+    void RunawayOnTickIsRemoved() {
+        CHECK(BegeerteTest::WaitFor([] { return !Results("later.txt", 1).empty(); }, 30s));
+        std::string log = ReadFile(Root / "Logs" / "Begeerte_script.log");
+        CHECK(log.find("on_tick in runaway.beg failed and was removed") != std::string::npos);
+    }
+
+    // Outside a coroutine the sleeps block the thread for the script time that is left. Script time is a
+    // day ahead of the real clock by now, so waiting until its time point on the real clock would hang.
+    void SleepsOutsideCoroutinesWaitRealTime() {
+        std::atomic<int> done{ 0 };
+        std::thread([&done] {
+            using BegeerteScript::ScriptScheduler;
+            ScriptScheduler::SleepUntil(ScriptScheduler::Now() + 20ms);
+            ScriptScheduler::SleepUntilWoken(ScriptScheduler::Now() + 20ms);
+            ScriptScheduler::SleepTicks(1);
+            done++;
+            }).detach(); // Left behind if it hangs; main exits without joining it
+        CHECK(BegeerteTest::WaitFor([&done] { return done == 1; }));
+    }
+}
+
+int main() {
+    Prepare();
+    BegeerteTest::Run("A day of script time replays in seconds", DayOfScriptTimeReplaysInSeconds);
+    BegeerteTest::Run("Waits and timers land on script time", WaitsAndTimersLandOnScriptTime);
+    BegeerteTest::Run("on_tick follows script time", OnTickFollowsScriptTime);
+    BegeerteTest::Run("A runaway on_tick is removed", RunawayOnTickIsRemoved);
+    BegeerteTest::Run("Sleeps outside coroutines wait real time", SleepsOutsideCoroutinesWaitRealTime);
+    // The shared scheduler is never torn down, so leave without running static destructors under it
+    std::cout.flush();
+    std::_Exit(BegeerteTest::Finish());
+}
\ No newline at end of file
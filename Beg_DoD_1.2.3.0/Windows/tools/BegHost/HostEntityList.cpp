@@ -0,0 +1,190 @@
+#include "HostEntityList.h"
+#include "EntityList.h"
+#include <unordered_map>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <cstring>
+#include <iostream>
+
+using BegeerteScript::SnapshotChannel;
+
+static_assert(sizeof(EntityList::Player) <= SnapshotChannel::EntityBytes, "EntityList::Player does not fit in a snapshot entity");
+
+namespace {
+    struct Slot {
+        EntityList::Player local;  // What scripts read and write
+        EntityList::Player shadow; // As published, to find what scripts changed
+        uint64_t remote = 0;       // Address in the server, 0 while the slot is free
+        uint32_t index = 0;        // Position in the last snapshot
+    };
+
+    SnapshotChannel* Channel = nullptr;
+    std::unique_ptr<Slot[]> Slots;
+    std::unordered_map<uint64_t, uint32_t> SlotOf; // Server address -> slot
+    std::vector<uint32_t> FreeSlots;
+    std::vector<SnapshotChannel::Entity> Staging;
+    uint64_t SeenSequence = 0;
+    uint64_t DroppedWrites = 0;
+    std::mutex UpdateMutex; // Update runs from on_tick, on_player and the event poller alike
+
+    // Addresses of the local copies, in snapshot order. Replaced as a whole under UpdateMutex and PublishMutex,
+    // so readers only take the short PublishMutex to copy the pointer.
+    EntityList::Entities EntityPointers = std::make_shared<const std::vector<DWORD64>>();
+    std::mutex PublishMutex;
+    std::atomic<unsigned long long> UpdateEpoch = 0;
+    std::atomic<size_t> PlayerCount = 0;
+    std::atomic<EntityList::UpdateCallback> Callback = nullptr;
+
+    // Needs UpdateMutex
+    void FlushLocked() {
+        if (!Channel) {
+            return;
+        }
+        for (DWORD64 address : *EntityPointers) {
+            Slot& slot = *reinterpret_cast<Slot*>(address); // local is the first member
+            auto* local = reinterpret_cast<uint8_t*>(&slot.local);
+            auto* shadow = reinterpret_cast<uint8_t*>(&slot.shadow);
+            if (std::memcmp(local, shadow, sizeof(EntityList::Player)) == 0) {
+                continue;
+            }
+            for (uint16_t offset = 0; offset < sizeof(EntityList::Player); ++offset) {
+                if (local[offset] == shadow[offset]) {
+                    continue;
+                }
+                if (!Channel->PushWrite({ slot.remote, slot.index, offset, local[offset] })) {
+                    if (DroppedWrites++ == 0) {
+                        std::cerr << "[BegHost] Write ring full, the server is not draining it; writes are being dropped." << std::endl;
+                    }
+                    continue;
+                }
+                shadow[offset] = local[offset];
+            }
+        }
+    }
+}
+
+namespace HostEntityList {
+    void Attach(SnapshotChannel& channel) {
+        std::lock_guard<std::mutex> lock(UpdateMutex);
+        Channel = &channel;
+        Slots.reset(new Slot[SnapshotChannel::MaxEntities]());
+        FreeSlots.clear();
+        for (uint32_t i = SnapshotChannel::MaxEntities; i > 0; --i) {
+            FreeSlots.push_back(i - 1);
+        }
+    }
+
+    void FlushWrites() {
+        std::lock_guard<std::mutex> lock(UpdateMutex);
+        FlushLocked();
+    }
+}
+
+namespace EntityList {
+    void Update() {
+        {
+            std::lock_guard<std::mutex> lock(UpdateMutex);
+            FlushLocked();
+            if (!Channel || !Channel->Read(Staging, SeenSequence)) {
+                return; // Nothing published since the last update, so nothing changed on the server either
+            }
+
+            std::unordered_map<uint64_t, uint32_t> current;
+            std::vector<DWORD64> pointers;
+            size_t validPlayers = 0;
+            for (uint32_t i = 0; i < Staging.size(); ++i) {
+                const SnapshotChannel::Entity& entity = Staging[i];
+                auto known = SlotOf.find(entity.address);
+                uint32_t index;
+                if (known != SlotOf.end()) {
+                    index = known->second;
+                }
+                else if (!FreeSlots.empty()) {
+                    index = FreeSlots.back();
+                    FreeSlots.pop_back();
+                }
+                else {
+                    continue;
+                }
+                Slot& slot = Slots[index];
+                std::memcpy(&slot.local, entity.bytes, sizeof(Player));
+                std::memcpy(&slot.shadow, entity.bytes, sizeof(Player));
+                slot.remote = entity.address;
+                slot.index = i;
+                current[entity.address] = index;
+                pointers.push_back(reinterpret_cast<DWORD64>(&slot));
+                if (slot.local.IsValid()) {
+                    validPlayers++;
+                }
+            }
+            // Entities that left: handles scripts still hold now read as invalid, like freed game memory would
+            for (const auto& [address, index] : SlotOf) {
+                if (current.find(address) == current.end()) {
+                    Slots[index].local.validFlag = 0;
+                    Slots[index].shadow.validFlag = 0;
+                    Slots[index].remote = 0;
+                    FreeSlots.push_back(index);
+                }
+            }
+            SlotOf.swap(current);
+            Entities published = std::make_shared<const std::vector<DWORD64>>(std::move(pointers));
+            {
+                std::lock_guard<std::mutex> publishLock(PublishMutex);
+                EntityPointers.swap(published);
+            }
+            PlayerCount.store(validPlayers, std::memory_order_relaxed);
+            UpdateEpoch.fetch_add(1, std::memory_order_release);
+        }
+
+        if (UpdateCallback callback = Callback.load(std::memory_order_acquire)) {
+            callback();
+        }
+    }
+
+    Entities GetAllEntities() {
+        std::lock_guard<std::mutex> lock(PublishMutex);
+        return EntityPointers;
+    }
+
+    size_t GetMaxPlayers() {
+        return GetAllEntities()->size();
+    }
+
+    DWORD64 GetEntity(int id) {
+        Entities entities = GetAllEntities();
+        if (id <= 0 || static_cast<size_t>(id) > entities->size()) {
+            return 0;
+        }
+        return (*entities)[static_cast<size_t>(id) - 1];
+    }
+
+    Player* GetPlayer(int id) {
+        return reinterpret_cast<Player*>(GetEntity(id));
+    }
+
+    std::vector<Player*> GetValidPlayers() {
+        Entities entities = GetAllEntities();
+        std::vector<Player*> players;
+        players.reserve(entities->size());
+        for (DWORD64 address : *entities) {
+            Player* player = reinterpret_cast<Player*>(address);
+            if (player->IsValid()) {
+                players.push_back(player);
+            }
+        }
+        return players;
+    }
+
+    unsigned long long GetUpdateEpoch() {
+        return UpdateEpoch.load(std::memory_order_acquire);
+    }
+
+    size_t GetPlayerCount() {
+        return PlayerCount.load(std::memory_order_relaxed);
+    }
+
+    void SetUpdateCallback(UpdateCallback callback) {
+        Callback.store(callback, std::memory_order_release);
+    }
+}
\ No newline at end of file
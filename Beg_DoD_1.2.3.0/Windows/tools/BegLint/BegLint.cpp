@@ -0,0 +1,44 @@
+// BegLint: runs the script performance linter over .beg files without starting the server.
+// Usage: BegLint.exe <script.beg> [more.beg ...]
+// Exit code: 0 = clean, 1 = findings reported, 2 = usage or syntax error
+#include "ScriptLexer.h"
+#include "ScriptLinter.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <exception>
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: BegLint <script.beg> [more.beg ...]" << std::endl;
+        return 2;
+    }
+
+    size_t total = 0;
+    bool failed = false;
+    for (int i = 1; i < argc; ++i) {
+        std::ifstream script_file(argv[i]);
+        if (!script_file.is_open()) {
+            std::cerr << "BegLint: could not open " << argv[i] << std::endl;
+            failed = true;
+            continue;
+        }
+        std::stringstream script_buffer;
+        script_buffer << script_file.rdbuf();
+
+        try {
+            auto tokens = BegeerteScript::Lexer::Tokenize(script_buffer.str(), argv[i]);
+            for (const auto& finding : BegeerteScript::Linter::Lint(tokens)) {
+                std::cout << BegeerteScript::Linter::Format(argv[i], finding) << std::endl;
+                total++;
+            }
+        }
+        catch (const std::exception&) {
+            failed = true; // The lexer already printed the location
+        }
+    }
+
+    std::cout << total << " finding(s)." << std::endl;
+    if (failed) return 2;
+    return total > 0 ? 1 : 0;
+}
\ No newline at end of file